@@ -0,0 +1,399 @@
+// bench - microbenchmarks for the libprime hot kernels
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Times countPairs, countRangedPairs(Iter), countRangedPairsBitmap, twoSGB
+// and calcBnormSymmetric over a workload shaped like the real pipeline:
+// n drawn log-uniformly over the prime store with the alpha set the top
+// Makefile shards over, swept in ascending order so the cursors advance the
+// way gbpairsummary advances them.  Reports ns/op and cycles/op with warmup
+// and variance, and optionally appends CSV rows for tracking across commits.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+#include <inttypes.h>
+#include "libprime.h"
+
+static const long double ALPHAS[] = {0.05L, 0.1L, 0.2L, 0.3L, 0.4L, 0.5L};
+static const size_t ALPHAS_N = sizeof(ALPHAS)/sizeof(ALPHAS[0]);
+
+// Accumulated so the optimizer cannot discard kernel results.
+static volatile uint64_t checksum;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static inline uint64_t cycles_now(void) {
+#if defined(__x86_64__)
+    unsigned lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#else
+    return 0; // cycles/op reported as 0 off x86-64
+#endif
+}
+
+static uint64_t xorshift64(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+// The Euler-capped window half-width gbpairsummary uses.
+static uint64_t compute_delta(uint64_t n, long double alpha) {
+    uint64_t delta = (uint64_t)floorl(alpha * (long double)n);
+    long double cap_alpha = 1.0L + (0.5L - sqrtl(2.0L*(long double)n + 0.25L)) / (long double)n;
+    long double val = ceill(cap_alpha * (long double)n) - 1.0L;
+    uint64_t cap = (val < 1.0L) ? 1ULL : (uint64_t)val;
+    if (delta > cap) {
+        delta = cap;
+    }
+    return delta;
+}
+
+typedef struct {
+    const uint64_t *primes;
+    size_t count;
+    const uint64_t *n;        // sorted sample values
+    size_t samples;
+    const uint8_t *bitmap;
+    uint64_t bitmap_bits;
+    const double *cum;        // cumulative products for calcBnormSymmetric
+    size_t plen;
+} Workload;
+
+typedef uint64_t (*BenchFn)(const Workload *w);
+
+static uint64_t bench_countPairs(const Workload *w) {
+    uint64_t *lowest = (uint64_t *)w->primes;
+    uint64_t *highest = lowest + w->count;
+    uint64_t *current = lowest;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < w->samples; i++) {
+        sum += (uint64_t)countPairs(w->n[i], &current, lowest, highest);
+    }
+    return sum;
+}
+
+static uint64_t bench_countRangedPairs(const Workload *w) {
+    const uint64_t *lowest = w->primes;
+    const uint64_t *highest = lowest + w->count;
+    const uint64_t *current = lowest;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < w->samples; i++) {
+        const uint64_t n = w->n[i];
+        const uint64_t delta = compute_delta(n, ALPHAS[i % ALPHAS_N]);
+        sum += countRangedPairs(n, n - delta - 1, &current, lowest, highest);
+    }
+    return sum;
+}
+
+static uint64_t bench_countRangedPairsIter(const Workload *w) {
+    const uint64_t *lowest = w->primes;
+    const uint64_t *highest = lowest + w->count;
+    const uint64_t *current = lowest;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < w->samples; i++) {
+        const uint64_t n = w->n[i];
+        // widen the same n outward through the alpha set, like the
+        // multi-window loop in gbpairsummary
+        const uint64_t *lo = NULL;
+        const uint64_t *hi = NULL;
+        for (size_t a = 0; a < ALPHAS_N; a++) {
+            const uint64_t delta = compute_delta(n, ALPHAS[a]);
+            sum += countRangedPairsIter(n, n - delta - 1, &current, lowest, highest, &lo, &hi);
+        }
+    }
+    return sum;
+}
+
+static uint64_t bench_countRangedPairsBitmap(const Workload *w) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < w->samples; i++) {
+        const uint64_t n = w->n[i];
+        const uint64_t delta = compute_delta(n, ALPHAS[i % ALPHAS_N]);
+        sum += countRangedPairsBitmap(n, n - delta - 1, w->bitmap, w->bitmap_bits);
+    }
+    return sum;
+}
+
+static uint64_t bench_twoSGB(const Workload *w) {
+    double sum = 0.0;
+    for (size_t i = 0; i < w->samples; i++) {
+        sum += twoSGB(w->n[i], w->primes, w->count);
+    }
+    return (uint64_t)sum;
+}
+
+static uint64_t bench_calcBnormSymmetric(const Workload *w) {
+    double sum = 0.0;
+    for (size_t i = 0; i < w->samples; i++) {
+        const uint64_t n = w->n[i];
+        const uint64_t M = compute_delta(n, 0.25L);
+        BnormOut out = calcBnormSymmetric(n, M, w->primes + 1, w->plen, w->cum);
+        sum += out.bnorm + out.bwin;
+    }
+    return (uint64_t)sum;
+}
+
+// Batch form over a dense run of consecutive n (the audit access pattern),
+// one shared window size taken from the middle of the sample range.
+static uint64_t bench_calcBnormSymmetricBatch(const Workload *w) {
+    const uint64_t base = w->n[w->samples / 2];
+    const uint64_t M = compute_delta(base, 0.25L);
+    uint64_t *ns = malloc(w->samples * sizeof(uint64_t));
+    BnormOut *out = malloc(w->samples * sizeof(BnormOut));
+    if (!ns || !out) {
+        free(ns);
+        free(out);
+        return 0;
+    }
+    for (size_t i = 0; i < w->samples; i++) {
+        ns[i] = base + i;
+    }
+    calcBnormSymmetricBatch(ns, w->samples, M, w->primes + 1, w->plen, w->cum, out);
+    double sum = 0.0;
+    for (size_t i = 0; i < w->samples; i++) {
+        sum += out[i].bnorm + out[i].bwin;
+    }
+    free(ns);
+    free(out);
+    return (uint64_t)sum;
+}
+
+static void run_bench(const char *name, BenchFn fn, const Workload *w,
+                      uint64_t ops, int warmup, int reps, FILE *csv) {
+    double ns[64] = {0};
+    uint64_t cyc[64] = {0};
+    if (reps > 64) {
+        reps = 64;
+    }
+    for (int i = 0; i < warmup; i++) {
+        checksum += fn(w);
+    }
+    for (int r = 0; r < reps; r++) {
+        const double t0 = now_ns();
+        const uint64_t c0 = cycles_now();
+        checksum += fn(w);
+        const uint64_t c1 = cycles_now();
+        const double t1 = now_ns();
+        ns[r] = (t1 - t0) / (double)ops;
+        cyc[r] = (c1 - c0) / ops;
+    }
+    double mean = 0.0, min = ns[0];
+    uint64_t min_cyc = cyc[0];
+    for (int r = 0; r < reps; r++) {
+        mean += ns[r];
+        if (ns[r] < min) {
+            min = ns[r];
+            min_cyc = cyc[r];
+        }
+    }
+    mean /= reps;
+    double var = 0.0;
+    for (int r = 0; r < reps; r++) {
+        var += (ns[r] - mean) * (ns[r] - mean);
+    }
+    const double stddev = (reps > 1) ? sqrt(var / (reps - 1)) : 0.0;
+
+    printf("%-24s %10" PRIu64 " ops  %10.1f ns/op  (min %.1f, sd %.1f)  %8" PRIu64 " cyc/op\n",
+           name, ops, mean, min, stddev, min_cyc);
+    if (csv) {
+        fprintf(csv, "%s,%" PRIu64 ",%.2f,%.2f,%.2f,%" PRIu64 "\n",
+                name, ops, mean, min, stddev, min_cyc);
+    }
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char* argv[]) {
+    const char *prime_raw_file = NULL;
+    const char *bitmap_file = NULL;
+    const char *csv_file = NULL;
+    size_t samples = 2000;
+    int warmup = 1;
+    int reps = 5;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--bitmap") && i+1 < argc) {
+            bitmap_file = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--csv") && i+1 < argc) {
+            csv_file = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--samples") && i+1 < argc) {
+            samples = strtoull(argv[++i],NULL,10);
+        }
+        else if (!strcmp(argv[i], "--warmup") && i+1 < argc) {
+            warmup = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--reps") && i+1 < argc) {
+            reps = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--seed") && i+1 < argc) {
+            seed = strtoull(argv[++i],NULL,10);
+        }
+        else if (!prime_raw_file) {
+            prime_raw_file = argv[i];
+        }
+        else {
+            prime_raw_file = NULL;
+            break;
+        }
+    }
+    if (!prime_raw_file || !samples || reps < 1) {
+        fprintf(stderr,"Usage: %s <prime_raw_file> [--bitmap FILE] [--csv FILE]\n"
+                       "          [--samples N] [--warmup N] [--reps N] [--seed S]\n",argv[0]);
+        exit(1);
+    }
+
+    // Open and mmap prime file
+    int fd = open(prime_raw_file, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        exit(1);
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror("fstat");
+        close(fd);
+        exit(1);
+    }
+    const uint64_t *primes = (const uint64_t*)(
+        mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
+    );
+    if (primes == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        exit(1);
+    }
+    const size_t count = (size_t)st.st_size / sizeof(uint64_t);
+    if (count < 100) {
+        fprintf(stderr,"Error: %s is too small to benchmark against\n",prime_raw_file);
+        exit(1);
+    }
+
+    Workload w;
+    memset(&w, 0, sizeof(w));
+    w.primes = primes;
+    w.count = count;
+
+    // Optional bitmap for the popcount kernel
+    int bfd = -1;
+    struct stat bst;
+    if (bitmap_file) {
+        bfd = open(bitmap_file, O_RDONLY);
+        if (bfd < 0 || fstat(bfd, &bst) < 0) {
+            perror("open bitmap");
+            exit(1);
+        }
+        w.bitmap = (const uint8_t*)mmap(NULL, bst.st_size, PROT_READ, MAP_PRIVATE, bfd, 0);
+        if (w.bitmap == MAP_FAILED) {
+            perror("mmap bitmap");
+            exit(1);
+        }
+        w.bitmap_bits = ((uint64_t)bst.st_size) << 3;
+    }
+
+    // Log-uniform n over [1024, last_prime/2), sorted ascending so cursor
+    // kernels sweep forward as they do in production.
+    uint64_t *n_samples = malloc(samples * sizeof(uint64_t));
+    if (!n_samples) {
+        fprintf(stderr,"Failed to allocate samples\n");
+        exit(1);
+    }
+    const double lo_log = log(1024.0);
+    const double hi_log = log((double)primes[count-1] / 2.0);
+    for (size_t i = 0; i < samples; i++) {
+        const double u = (double)(xorshift64(&seed) >> 11) / (double)(1ULL << 53);
+        n_samples[i] = (uint64_t)exp(lo_log + u * (hi_log - lo_log));
+    }
+    qsort(n_samples, samples, sizeof(uint64_t), cmp_u64);
+    w.n = n_samples;
+    w.samples = samples;
+
+    // Cumulative products over the leading odd primes for calcBnormSymmetric
+    w.plen = count - 1;
+    if (w.plen > 65536) {
+        w.plen = 65536;
+    }
+    double *cum = build_cumprod_u64(primes + 1, w.plen);
+    if (!cum) {
+        fprintf(stderr,"Failed to build cumulative products\n");
+        exit(1);
+    }
+    w.cum = cum;
+
+    FILE *csv = NULL;
+    if (csv_file) {
+        csv = fopen(csv_file, "a");
+        if (!csv) {
+            perror("fopen csv");
+            exit(1);
+        }
+        if (ftell(csv) == 0) {
+            fprintf(csv, "kernel,ops,ns_op_mean,ns_op_min,ns_op_stddev,cyc_op_min\n");
+        }
+    }
+
+    printf("libprime bench: %zu primes up to %" PRIu64 ", %zu samples, %d reps (+%d warmup)\n",
+           count, primes[count-1], samples, reps, warmup);
+
+    run_bench("countPairs", bench_countPairs, &w, samples, warmup, reps, csv);
+    run_bench("countRangedPairs", bench_countRangedPairs, &w, samples, warmup, reps, csv);
+    run_bench("countRangedPairsIter", bench_countRangedPairsIter, &w,
+              samples * ALPHAS_N, warmup, reps, csv);
+    if (w.bitmap) {
+        run_bench("countRangedPairsBitmap", bench_countRangedPairsBitmap, &w,
+                  samples, warmup, reps, csv);
+    }
+    run_bench("twoSGB", bench_twoSGB, &w, samples, warmup, reps, csv);
+    run_bench("calcBnormSymmetric", bench_calcBnormSymmetric, &w, samples, warmup, reps, csv);
+    run_bench("calcBnormSymmetricBatch", bench_calcBnormSymmetricBatch, &w,
+              samples, warmup, reps, csv);
+
+    if (csv) {
+        fclose(csv);
+    }
+    free(cum);
+    free(n_samples);
+    if (w.bitmap) {
+        munmap((void*)w.bitmap, bst.st_size);
+        close(bfd);
+    }
+    munmap((void*)primes, st.st_size);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,320 @@
+// sievebench - benchmark and validation harness for the segmented sieve
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Runs the byte-flag segmented sieve from primesieve_bitmap/main.c over a
+// matrix of segment sizes and limits so a sieve change can be judged in
+// seconds instead of a certifyprimes pass over full output.  Every
+// configuration's prime count is validated two ways: against built-in
+// reference pi(x) values when the limit is a standard checkpoint (1e6 ..
+// 1e10), and against the other segment sizes at the same limit otherwise -
+// any disagreement is a FAIL and a nonzero exit.  Reports MB/s of bitmap
+// output and cycles per odd candidate per configuration, and recommends
+// the fastest segment size for this machine (primesieve_bitmap hardcodes
+// SEGMENT_SIZE at 32768).
+//
+// The sieve kernel below is a copy of sieve_segment() with the segment
+// size as a runtime parameter; keep it in sync with primesieve_bitmap.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <inttypes.h>
+
+// pi(x) at the standard checkpoints (OEIS A006880).
+static const struct {
+    uint64_t limit;
+    uint64_t pi;
+} REFERENCE_PI[] = {
+    {1000000ULL,        78498ULL},
+    {10000000ULL,       664579ULL},
+    {100000000ULL,      5761455ULL},
+    {1000000000ULL,     50847534ULL},
+    {10000000000ULL,    455052511ULL},
+};
+static const size_t REFERENCE_PI_N = sizeof(REFERENCE_PI)/sizeof(REFERENCE_PI[0]);
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static inline uint64_t cycles_now(void) {
+#if defined(__x86_64__)
+    unsigned lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#else
+    return 0; // cyc/cand reported as 0 off x86-64
+#endif
+}
+
+// Sieve one segment of seg_size odd candidates starting at odd value low.
+// flags is (seg_size+7)/8 bytes; on return 1 = prime (already inverted).
+// Mirror of sieve_segment() in primesieve_bitmap/main.c, seg_size runtime.
+static void sieve_segment_rt(uint64_t low, const uint8_t *base_primes,
+                             uint8_t *flags, uint64_t seg_size) {
+    uint64_t high = low + 2 * seg_size - 1;
+    uint64_t segment_len = (high - low) / 2 + 1;
+
+    memset(flags, 0, (segment_len + 7)/8);
+
+    for (uint64_t i = 0; (2*i+3)*(2*i+3) <= high; ++i) {
+        if (!(base_primes[i >> 3] & (1 << (i & 7)))) {
+            uint64_t p = (i<<1) + 3;
+            if(p&0xffffffff00000000ULL) {
+                break;
+            }
+            uint64_t j = p * p;
+
+            if (j < low) {
+                j = ((low + p - 1) / p) * p;
+                if ((j & 1) == 0) j += p;
+            }
+
+            for (uint64_t jstep=(p<<1); j <= high; j += jstep) {
+                uint64_t idx = (j - low) >> 1;
+                flags[idx >> 3] |= (1 << (idx & 7));
+            }
+        }
+    }
+
+    // Invert: 1 = prime
+    for (size_t i = 0; i < (segment_len + 7)/8; ++i) {
+        flags[i] = ~flags[i];
+    }
+}
+
+// Prime bits in flags[0..valid) (candidates v = low + 2*idx <= limit).
+static uint64_t count_segment(const uint8_t *flags, uint64_t valid) {
+    uint64_t count = 0;
+    uint64_t byte = 0;
+    const uint64_t full_bytes = valid >> 3;
+    for (; byte + 8 <= full_bytes; byte += 8) {
+        uint64_t word;
+        memcpy(&word, flags + byte, 8);
+        count += (uint64_t)__builtin_popcountll(word);
+    }
+    for (; byte < full_bytes; ++byte) {
+        count += (uint64_t)__builtin_popcount(flags[byte]);
+    }
+    if (valid & 7) {
+        const uint8_t mask = (uint8_t)((1u << (valid & 7)) - 1);
+        count += (uint64_t)__builtin_popcount(flags[byte] & mask);
+    }
+    return count;
+}
+
+// Full run at one (limit, seg_size): sieves every segment, counts primes.
+// Returns pi(limit); *elapsed_ns and *elapsed_cyc cover the whole run.
+static uint64_t sieve_count(uint64_t limit, uint64_t seg_size,
+                            const uint8_t *base_primes,
+                            double *elapsed_ns, uint64_t *elapsed_cyc) {
+    uint8_t *flags = malloc((seg_size + 7) / 8);
+    if (!flags) {
+        fprintf(stderr, "Failed to allocate flags\n");
+        exit(1);
+    }
+    uint64_t count = 0;
+    const double t0 = now_ns();
+    const uint64_t c0 = cycles_now();
+    for (uint64_t low = 3; low <= limit; low += 2 * seg_size) {
+        sieve_segment_rt(low, base_primes, flags, seg_size);
+        uint64_t valid = (limit - low) / 2 + 1;
+        if (valid > seg_size) {
+            valid = seg_size;
+        }
+        count += count_segment(flags, valid);
+    }
+    *elapsed_cyc = cycles_now() - c0;
+    *elapsed_ns = now_ns() - t0;
+    free(flags);
+    return count + 1; // the sieve starts at 3; add the prime 2
+}
+
+static size_t parse_list(const char *arg, uint64_t *out, size_t max) {
+    size_t n = 0;
+    while (*arg && n < max) {
+        char *end;
+        out[n] = strtoull(arg, &end, 10);
+        if (end == arg || !out[n]) {
+            return 0;
+        }
+        n++;
+        arg = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') {
+            return 0;
+        }
+    }
+    return n;
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t limits[16] = {100000000ULL};
+    size_t limits_n = 1;
+    // Odd candidates per segment; 32768 is the hardcoded SEGMENT_SIZE.
+    uint64_t segments[16] = {8192, 16384, 32768, 65536, 131072, 262144, 524288};
+    size_t segments_n = 7;
+    int reps = 3;
+    const char *csv_file = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--limits") && i+1 < argc) {
+            limits_n = parse_list(argv[++i], limits, 16);
+        }
+        else if (!strcmp(argv[i], "--segments") && i+1 < argc) {
+            segments_n = parse_list(argv[++i], segments, 16);
+        }
+        else if (!strcmp(argv[i], "--reps") && i+1 < argc) {
+            reps = atoi(argv[i+1]);
+            i++;
+        }
+        else if (!strcmp(argv[i], "--csv") && i+1 < argc) {
+            csv_file = argv[++i];
+        }
+        else {
+            limits_n = 0;
+            break;
+        }
+    }
+    if (!limits_n || !segments_n || reps < 1) {
+        fprintf(stderr,"Usage: %s [--limits N,N,...] [--segments N,N,...] [--reps N] [--csv FILE]\n"
+                       "  --limits: sieve limits (default 100000000)\n"
+                       "  --segments: odd candidates per segment (default 8192..524288)\n"
+                       "  counts are checked against reference pi(x) at 1e6..1e10 and\n"
+                       "  against the other segment sizes at the same limit\n",argv[0]);
+        exit(1);
+    }
+
+    uint64_t max_limit = 0;
+    for (size_t l = 0; l < limits_n; l++) {
+        if (limits[l] < 3) {
+            fprintf(stderr, "Error: limits must be >= 3\n");
+            exit(1);
+        }
+        if (limits[l] > max_limit) {
+            max_limit = limits[l];
+        }
+    }
+
+    // Base primes up to sqrt(max limit), same small sieve as the tool.
+    const uint64_t sqrt_limit = (uint64_t)sqrt((double)max_limit) + 1;
+    uint8_t *base_primes = calloc((sqrt_limit + 1) >> 1, sizeof(uint8_t));
+    if (!base_primes) {
+        fprintf(stderr, "Failed to allocate base_primes\n");
+        exit(1);
+    }
+    for (uint64_t i = 0; (2*i+3)*(2*i+3) <= sqrt_limit; ++i) {
+        if (!(base_primes[i >> 3] & (1 << (i & 7)))) {
+            uint64_t p = (i << 1) + 3;
+            uint64_t jmax = (sqrt_limit - 1) >> 1;
+            for (uint64_t j = (p * p - 3) >> 1; j < jmax; j += p) {
+                base_primes[j >> 3] |= (1 << (j & 7));
+            }
+        }
+    }
+
+    FILE *csv = NULL;
+    if (csv_file) {
+        csv = fopen(csv_file, "a");
+        if (!csv) {
+            perror("fopen csv");
+            exit(1);
+        }
+        if (ftell(csv) == 0) {
+            fprintf(csv, "limit,segment,seconds,mb_s,cyc_cand,pi,status\n");
+        }
+    }
+
+    printf("%-12s %-9s %-8s %-9s %-9s %-12s %s\n",
+           "limit", "segment", "seconds", "MB/s", "cyc/cand", "pi(limit)", "check");
+
+    int failed = 0;
+    uint64_t best_segment = 0;
+    double best_mbs = 0.0;
+    for (size_t l = 0; l < limits_n; l++) {
+        const uint64_t limit = limits[l];
+        const uint64_t candidates = (limit - 1) / 2; // odd values in [3, limit]
+        const double out_mb = (double)((candidates + 7) / 8) / (1024.0 * 1024.0);
+        const uint64_t *ref = NULL;
+        for (size_t r = 0; r < REFERENCE_PI_N; r++) {
+            if (REFERENCE_PI[r].limit == limit) {
+                ref = &REFERENCE_PI[r].pi;
+                break;
+            }
+        }
+        uint64_t first_pi = 0;
+        for (size_t s = 0; s < segments_n; s++) {
+            double ns_min = 0.0;
+            uint64_t cyc_min = 0;
+            uint64_t pi = 0;
+            for (int r = 0; r < reps; r++) {
+                double ns;
+                uint64_t cyc;
+                pi = sieve_count(limit, segments[s], base_primes, &ns, &cyc);
+                if (r == 0 || ns < ns_min) {
+                    ns_min = ns;
+                    cyc_min = cyc;
+                }
+            }
+            if (s == 0) {
+                first_pi = pi;
+            }
+            const char *status = "agree";
+            if (ref) {
+                status = (pi == *ref) ? "OK" : "FAIL";
+            }
+            if ((ref && pi != *ref) || pi != first_pi) {
+                status = "FAIL";
+                failed = 1;
+            }
+            const double mbs = out_mb / (ns_min * 1e-9);
+            printf("%-12" PRIu64 " %-9" PRIu64 " %-8.3f %-9.1f %-9.2f %-12" PRIu64 " %s\n",
+                   limit, segments[s], ns_min * 1e-9, mbs,
+                   (double)cyc_min / (double)candidates, pi, status);
+            if (csv) {
+                fprintf(csv, "%" PRIu64 ",%" PRIu64 ",%.4f,%.1f,%.2f,%" PRIu64 ",%s\n",
+                        limit, segments[s], ns_min * 1e-9, mbs,
+                        (double)cyc_min / (double)candidates, pi, status);
+            }
+            // Tune on the largest limit; small runs fit in cache at any size.
+            if (limit == max_limit && mbs > best_mbs) {
+                best_mbs = mbs;
+                best_segment = segments[s];
+            }
+        }
+    }
+
+    if (failed) {
+        fprintf(stderr, "FAIL: prime counts disagree with the reference\n");
+    }
+    else if (best_segment) {
+        printf("Best segment size: %" PRIu64 " odd candidates (%.1f KiB flags, %.1f MB/s)%s\n",
+               best_segment, (double)(best_segment / 8) / 1024.0, best_mbs,
+               best_segment == 32768 ? "" : " - primesieve_bitmap hardcodes 32768");
+    }
+
+    if (csv) {
+        fclose(csv);
+    }
+    free(base_primes);
+    return failed;
+}
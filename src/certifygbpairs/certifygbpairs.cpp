@@ -22,17 +22,14 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include "gbCsv.hpp"
+
 using u64 = uint64_t;
 
 [[noreturn]] static void die(const std::string& s){
     std::cerr << "ERROR: " << s << "\n"; std::exit(1);
 }
 
-/*** small helpers ***/
-static inline void rstrip_cr(std::string& s){
-    if (!s.empty() && s.back() == '\r') s.pop_back();
-}
-
 /*** FNV-1a 64 for a lightweight row digest ***/
 static inline u64 fnv1a64_update(u64 h, u64 v){
     static constexpr u64 P = 1099511628211ull;
@@ -44,6 +41,7 @@ static inline u64 fnv1a64_update(u64 h, u64 v){
 struct Args {
     std::string bitmap_path;
     std::string csv_path;
+    int threads = 1;   // worker threads over line-aligned CSV chunks
 };
 static Args parse_args(int argc, char** argv){
     Args a;
@@ -51,7 +49,13 @@ static Args parse_args(int argc, char** argv){
         std::string s = argv[i];
         if (s=="--bitmap" && i+1<argc) a.bitmap_path = argv[++i];
         else if (s=="--file" && i+1<argc) a.csv_path = argv[++i];
-        else die("Unknown/invalid arg: "+s+"  (use --bitmap <path> --file <csv>)");
+        else if (s=="--threads" && i+1<argc){
+            char* endp = nullptr;
+            long thr = std::strtol(argv[++i], &endp, 10);
+            if (!endp || *endp != '\0' || thr < 1) die("Threads must be an integer >= 1");
+            a.threads = (int)thr;
+        }
+        else die("Unknown/invalid arg: "+s+"  (use --bitmap <path> --file <csv> [--threads <n>])");
     }
     if (a.bitmap_path.empty()) die("Provide --bitmap <odd-only prime bitmap>");
     if (a.csv_path.empty()) die("Provide --file <goldbach CSV>");
@@ -107,117 +111,225 @@ public:
     }
 };
 
-/*** CSV split: 4 unsigned integer columns, no quotes ***/
-static bool split4(const std::string& s, u64& c2N, u64& cNm, u64& cNp, u64& c2M){
-    int field=0; size_t i=0, n=s.size();
-    std::string tok; tok.reserve(32);
-    u64 vals[4]; int got=0;
-    while (i<=n){
-        char ch = (i==n)? ',' : s[i];
-        if (ch==','){
-            size_t a=0,b=tok.size();
-            while (a<b && isspace((unsigned char)tok[a])) ++a;
-            while (b>a && isspace((unsigned char)tok[b-1])) --b;
-            if (b<=a) return false;
-            char* end=nullptr;
-            unsigned long long v = strtoull(tok.c_str()+a, &end, 10);
-            if (end != tok.c_str()+b) return false;
-            if (got<4) vals[got++] = (u64)v;
-            tok.clear(); ++field;
-            if (field>4) return false;
-        } else {
-            tok.push_back(ch);
-        }
-        ++i;
-    }
-    if (got!=4) return false;
-    c2N=vals[0]; cNm=vals[1]; cNp=vals[2]; c2M=vals[3];
-    return true;
+/*** CSV split: 4 unsigned integer columns, no quotes; zero-copy via gbCsv ***/
+static bool split4(const char* begin, const char* end, u64& c2N, u64& cNm, u64& cNp, u64& c2M){
+    GBCsvField f[4];
+    if (gbCsvSplit(begin, end, f, 4) != 4) return false;
+    return gbCsvU64(f[0], c2N) && gbCsvU64(f[1], cNm) &&
+           gbCsvU64(f[2], cNp) && gbCsvU64(f[3], c2M);
 }
 
-/*** Main verification ***/
-int main(int argc, char** argv){
-    std::ios::sync_with_stdio(false);
-    Args a = parse_args(argc, argv);
+/*** parallel verification ***
+ * Rows are independent once parsed, so the expensive part - the two
+ * bitmap primality probes per row - fans out over line-aligned chunks,
+ * one worker per chunk.  The FNV-1a chain is order-dependent and not
+ * seed-composable, so a dedicated scanner walks the whole file in row
+ * order doing only split + digest + the 2N continuity check; it runs
+ * concurrently with the workers and yields the exact certificate a
+ * sequential run produces, for any --threads value.
+ *
+ * Each side records its first failure as (row, check) with the checks
+ * numbered in the per-row order of the old sequential loop; combining
+ * takes the smallest pair, so the reported error is the one the
+ * sequential run would have hit first.
+ ***/
+enum {
+    CHK_ROW = 0,      // malformed CSV row
+    CHK_EVEN,         // 2N odd
+    CHK_GAP,          // 2N not consecutive
+    CHK_SUM,          // (N-M)+(N+M) != 2N
+    CHK_ORDER,        // N+M < N-M
+    CHK_DIFF,         // (N+M)-(N-M) != 2M
+    CHK_PRIME_NM,     // N-M not prime (or not covered)
+    CHK_PRIME_NP      // N+M not prime (or not covered)
+};
 
-    BitmapPrimeOracle P(a.bitmap_path);
+struct ChunkStats {
+    u64 rows = 0;          // rows verified before stopping
+    u64 err_row = 0;       // chunk-local row index of the failure
+    int err_check = -1;    // CHK_*; -1 = chunk passed
+    std::string error;
+};
 
-    std::ifstream in(a.csv_path);
-    if (!in) die("Failed to open CSV: " + a.csv_path);
+static void verify_chunk(const char* begin, const char* end,
+                         const BitmapPrimeOracle& P, ChunkStats& st)
+{
+    auto fail = [&](int check, std::string msg){
+        st.err_row = st.rows;
+        st.err_check = check;
+        st.error = std::move(msg);
+    };
+    const char* p = begin;
+    while (p < end){
+        const char* ls = p;
+        const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        const char* eol = nl ? nl : end;
+        p = nl ? nl + 1 : end;
+        if (eol > ls && eol[-1] == '\r') --eol;
+        if (eol == ls) continue;
 
-    std::string line;
+        u64 c2N, cNm, cNp, c2M;
+        if (!split4(ls, eol, c2N, cNm, cNp, c2M))
+            return fail(CHK_ROW, "Bad CSV row: " + std::string(ls, eol));
 
-    // Read first non-empty line (strip possible UTF-8 BOM + CR) and validate header
-    while (std::getline(in, line)) {
-        rstrip_cr(line);
-        if (line.empty()) continue;
-        // strip BOM if present
-        if (line.size() >= 3 &&
-            (unsigned char)line[0]==0xEF && (unsigned char)line[1]==0xBB && (unsigned char)line[2]==0xBF) {
-            line.erase(0,3);
-        }
-        break;
-    }
-    if (line.empty()) die("CSV appears empty");
-    if (line != "2N,N-M,N+M,2M") {
-        die("Unexpected header line: \"" + line + "\" (expected \"2N,N-M,N+M,2M\")");
+        // Sum/diff identities
+        if (cNm + cNp != c2N)
+            return fail(CHK_SUM, "Sum check failed: (N-M)+(N+M) != 2N at 2N=" + std::to_string(c2N));
+        if (cNp < cNm)
+            return fail(CHK_ORDER, "Order check failed: N+M < N-M at 2N=" + std::to_string(c2N));
+        if (cNp - cNm != c2M)
+            return fail(CHK_DIFF, "Diff check failed: (N+M)-(N-M) != 2M at 2N=" + std::to_string(c2N));
+
+        // Primality via mmap'd bitmap oracle; coverage is recorded here
+        // instead of dying so the first-error ordering stays exact.  The
+        // oracle rejects even n before its own coverage check, so only
+        // odd values past max_n() are coverage errors.
+        if ((cNm & 1ull) && cNm > P.max_n())
+            return fail(CHK_PRIME_NM, "Bitmap does not cover n=" + std::to_string(cNm));
+        if (!P.isPrime(cNm))
+            return fail(CHK_PRIME_NM, "N-M is not prime at 2N=" + std::to_string(c2N) +
+                " (N-M=" + std::to_string(cNm) + ")");
+        if ((cNp & 1ull) && cNp > P.max_n())
+            return fail(CHK_PRIME_NP, "Bitmap does not cover n=" + std::to_string(cNp));
+        if (!P.isPrime(cNp))
+            return fail(CHK_PRIME_NP, "N+M is not prime at 2N=" + std::to_string(c2N) +
+                " (N+M=" + std::to_string(cNp) + ")");
+
+        ++st.rows;
     }
+}
 
-    u64 expected2N = 0;
-    bool any = false;
+struct DigestScan {
     u64 count = 0, last2N = 0;
+    bool any = false;
     u64 fnv = 1469598103934665603ull;
+    u64 err_row = 0;
+    int err_check = -1;
+    std::string error;
+};
 
-    while (std::getline(in, line)){
-        rstrip_cr(line);
-        if (line.empty()) continue;
+static void digest_scan(const char* begin, const char* end, DigestScan& st)
+{
+    auto fail = [&](int check, std::string msg){
+        st.err_row = st.count;
+        st.err_check = check;
+        st.error = std::move(msg);
+    };
+    u64 expected2N = 0;
+    const char* p = begin;
+    while (p < end){
+        const char* ls = p;
+        const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        const char* eol = nl ? nl : end;
+        p = nl ? nl + 1 : end;
+        if (eol > ls && eol[-1] == '\r') --eol;
+        if (eol == ls) continue;
 
         u64 c2N, cNm, cNp, c2M;
-        if (!split4(line, c2N, cNm, cNp, c2M))
-            die("Bad CSV row: " + line);
+        if (!split4(ls, eol, c2N, cNm, cNp, c2M))
+            return fail(CHK_ROW, "Bad CSV row: " + std::string(ls, eol));
 
         // 2N: even and strictly consecutive (no gaps)
         if ((c2N & 1ull) != 0ull)
-            die("2N is not even at row with 2N=" + std::to_string(c2N));
-        if (!any) { expected2N = c2N; any = true; }
+            return fail(CHK_EVEN, "2N is not even at row with 2N=" + std::to_string(c2N));
+        if (!st.any) { expected2N = c2N; st.any = true; }
         if (c2N != expected2N)
-            die("Gap/out-of-order 2N: expected " + std::to_string(expected2N) +
+            return fail(CHK_GAP, "Gap/out-of-order 2N: expected " + std::to_string(expected2N) +
                 " got " + std::to_string(c2N));
 
-        // Sum/diff identities
-        if (cNm + cNp != c2N)
-            die("Sum check failed: (N-M)+(N+M) != 2N at 2N=" + std::to_string(c2N));
-        if (cNp < cNm)
-            die("Order check failed: N+M < N-M at 2N=" + std::to_string(c2N));
-        if (cNp - cNm != c2M)
-            die("Diff check failed: (N+M)-(N-M) != 2M at 2N=" + std::to_string(c2N));
+        ++st.count; st.last2N = c2N;
+        st.fnv = fnv1a64_update(st.fnv, c2N);
+        st.fnv = fnv1a64_update(st.fnv, cNm);
+        st.fnv = fnv1a64_update(st.fnv, cNp);
+        st.fnv = fnv1a64_update(st.fnv, c2M);
 
-        // Primality via mmap’d bitmap oracle
-        if (!P.isPrime(cNm))
-            die("N-M is not prime at 2N=" + std::to_string(c2N) +
-                " (N-M=" + std::to_string(cNm) + ")");
-        if (!P.isPrime(cNp))
-            die("N+M is not prime at 2N=" + std::to_string(c2N) +
-                " (N+M=" + std::to_string(cNp) + ")");
+        expected2N += 2;
+    }
+}
+
+/*** Main verification ***/
+int main(int argc, char** argv){
+    std::ios::sync_with_stdio(false);
+    Args a = parse_args(argc, argv);
+
+    BitmapPrimeOracle P(a.bitmap_path);
 
-        // Cert stats
-        ++count; last2N = c2N;
-        fnv = fnv1a64_update(fnv, c2N);
-        fnv = fnv1a64_update(fnv, cNm);
-        fnv = fnv1a64_update(fnv, cNp);
-        fnv = fnv1a64_update(fnv, c2M);
+    GBCsvFile in;
+    if (in.open(a.csv_path.c_str()) != 0) die("Failed to open CSV: " + a.csv_path);
+    GBCsvLines& lines = in.lines;
 
-        expected2N += 2;
+    // Read first non-empty line (the scanner strips BOM + CR) and validate header
+    bool have_header = false;
+    while (lines.next()) {
+        if (lines.emptyLine()) continue;
+        have_header = true;
+        break;
+    }
+    if (!have_header) die("CSV appears empty");
+    if (std::string(lines.begin, lines.end) != "2N,N-M,N+M,2M") {
+        die("Unexpected header line: \"" + std::string(lines.begin, lines.end) +
+            "\" (expected \"2N,N-M,N+M,2M\")");
+    }
+
+    // Data region: everything past the header line.
+    const char* data_begin = lines.end;
+    const char* file_end = in.data() + in.size();
+    if (data_begin < file_end && *data_begin == '\r') ++data_begin;
+    if (data_begin < file_end && *data_begin == '\n') ++data_begin;
+    size_t data_len = (size_t)(file_end - data_begin);
+
+    int nthreads = a.threads;
+    if (nthreads > 1 && data_len / (size_t)nthreads < 64) nthreads = 1;
+
+    // Line-aligned chunk boundaries for the workers.
+    std::vector<const char*> bounds;
+    bounds.push_back(data_begin);
+    for (int i = 1; i < nthreads; ++i){
+        const char* guess = data_begin + (data_len * (size_t)i) / (size_t)nthreads;
+        if (guess <= bounds.back()) guess = bounds.back();
+        const char* nl = (const char*)memchr(guess, '\n', (size_t)(file_end - guess));
+        bounds.push_back(nl ? nl + 1 : file_end);
+    }
+    bounds.push_back(file_end);
+
+    std::vector<ChunkStats> stats((size_t)nthreads);
+    DigestScan dg;
+
+    std::vector<std::thread> pool;
+    pool.emplace_back(digest_scan, data_begin, file_end, std::ref(dg));
+    for (int i = 0; i < nthreads; ++i)
+        pool.emplace_back(verify_chunk, bounds[(size_t)i], bounds[(size_t)i + 1],
+                          std::cref(P), std::ref(stats[(size_t)i]));
+    for (auto& t : pool) t.join();
+
+    // First failure in (global row, per-row check order).  Chunks are in
+    // file order, so the first failing chunk bounds every later one.
+    u64 err_row = 0; int err_check = -1; const std::string* err_msg = nullptr;
+    u64 rows_before = 0;
+    for (const ChunkStats& st : stats){
+        if (st.err_check >= 0){
+            err_row = rows_before + st.err_row;
+            err_check = st.err_check;
+            err_msg = &st.error;
+            break;
+        }
+        rows_before += st.rows;
+    }
+    if (dg.err_check >= 0 &&
+        (err_check < 0 || dg.err_row < err_row ||
+         (dg.err_row == err_row && dg.err_check < err_check))){
+        err_msg = &dg.error;
     }
+    if (err_msg) die(*err_msg);
 
-    if (!any) die("No data rows found.");
+    if (!dg.any) die("No data rows found.");
 
     std::cout << "OK: verified Goldbach pairs from 2N="
-              << (last2N - (count-1)*2) << " .. " << last2N << "\n"
-              << "rows=" << count
-              << "  last2N=" << last2N
+              << (dg.last2N - (dg.count-1)*2) << " .. " << dg.last2N << "\n"
+              << "rows=" << dg.count
+              << "  last2N=" << dg.last2N
               << "  fnv1a64=0x" << std::hex << std::setw(16) << std::setfill('0')
-              << fnv << std::dec << "\n";
+              << dg.fnv << std::dec << "\n";
     return 0;
 }
 
@@ -17,6 +17,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <bits/stdc++.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "libprime.h"
 using u64 = uint64_t;
 using u128 = __uint128_t;
 
@@ -28,6 +33,8 @@ struct Args {
     bool bitmap = false;
     bool bitmap_include2 = false; // set true if your bitmap has a bit for 2
     u64 segment = 4'000'000ULL; // numbers per segment
+    bool tree = false;          // hash/verify segments concurrently
+    unsigned threads = 0;       // 0 = hardware concurrency
 };
 
 static void die(const std::string& msg) {
@@ -62,6 +69,10 @@ static Args parse_args(int argc, char** argv) {
         else if (s == "--segment" && i+1 < argc) {
             a.segment = std::stoull(argv[++i]);
             if (a.segment < 1'000'000ULL) a.segment = 1'000'000ULL;
+        }
+        else if (s == "--tree-hash") { a.tree = true; }
+        else if (s == "--threads" && i+1 < argc) {
+            a.threads = (unsigned)std::stoul(argv[++i]);
         } else {
             die("Unknown/invalid arg: " + s);
         }
@@ -71,6 +82,9 @@ static Args parse_args(int argc, char** argv) {
     if (modes != 1) {
         die("Select exactly one: --binary, --text, or --bitmap");
     }
+    if (a.tree && (!a.binary || a.big_endian)) {
+        die("--tree-hash requires a little-endian --binary prime file");
+    }
     return a;
 }
 
@@ -132,10 +146,94 @@ static void sieve_small(u64 limit, std::vector<u64>& primes) {
     for (u64 n = 2; n <= limit; ++n) if (is_prime[n]) primes.push_back(n);
 }
 
+// Verify a wheel-30 bitmap (GBWHEEL0 header, bit j of payload byte b is
+// 30b + gbWheel30Residues[j]) against a segmented sieve.  2, 3 and 5 have
+// no wheel bit by construction, so only the coprime residues are checked.
+static void verify_wheel30_file(std::ifstream& in, u64 file_bytes, u64 fnv) {
+    const u64 bytes = file_bytes - GB_WHEEL30_HDR_BYTES;
+    const u64 max_n = (bytes == 0) ? 0 : 30ull*bytes - 1ull;
+    if (bytes == 0) {
+        std::cout << "OK: verified wheel-30 bitmap (empty)\n"
+                  << "bytes=" << file_bytes << "  max_n=" << max_n << "  primes_bits=0\n";
+        return;
+    }
+
+    const u64 SEG_BYTES = 1ull << 17; // wheel bytes per slice (~3.9M numbers)
+    u64 primes_bits = 0;
+    u64 last_prime = 5;
+    std::vector<char> buf;
+
+    for (u64 b0 = 0; b0 < bytes; ) {
+        u64 nb = std::min(SEG_BYTES, bytes - b0);
+        buf.resize((size_t)nb);
+        if (!in.read(buf.data(), (std::streamsize)nb)) die("Bitmap read error (unexpected EOF).");
+
+        for (size_t i = 0; i < (size_t)nb; ++i) {
+            unsigned char c = (unsigned char)buf[i];
+            static constexpr u64 FNV_PRIME = 1099511628211ull;
+            fnv ^= (u64)c;
+            fnv *= FNV_PRIME;
+            primes_bits += popcount8(c);
+        }
+
+        // Sieve the odd numbers this slice covers: [30*b0+1, 30*(b0+nb)-1]
+        const u64 lo = 30ull*b0 + 1ull;
+        const u64 hi = 30ull*(b0 + nb) - 1ull;
+        const u64 odds = ((hi - lo) >> 1) + 1;
+        std::vector<char> mark(odds, 1);
+        if (lo == 1) mark[0] = 0; // 1 is not prime
+        long double dhi = (long double)hi;
+        u64 need = (u64)std::floor(std::sqrt(dhi));
+        if (need < 2) need = 2;
+        std::vector<u64> base;
+        sieve_small(need, base);
+        for (u64 p : base) {
+            if (p == 2) continue;
+            u128 pp = (u128)p * (u128)p;
+            u64 start = (u64)pp;
+            if (start < lo) {
+                start = ((lo + p - 1) / p) * p;
+            }
+            if ((start & 1ull) == 0ull) start += p;
+            for (u64 m = start; m <= hi; m += (p << 1)) {
+                if (m > p) mark[(m - lo) >> 1] = 0;
+            }
+        }
+
+        for (u64 b = b0; b < b0 + nb; ++b) {
+            const unsigned char byte = (unsigned char)buf[(size_t)(b - b0)];
+            for (unsigned j = 0; j < 8; ++j) {
+                const u64 n = 30ull*b + gbWheel30Residues[j];
+                bool bit = ((byte >> j) & 1u) != 0u;
+                bool should_be_prime = (n >= 7) && (mark[(n - lo) >> 1] != 0);
+                if (bit != should_be_prime) {
+                    std::ostringstream oss;
+                    oss << "Wheel-30 bitmap mismatch at n=" << n
+                        << " (bit=" << bit << ", sieve=" << should_be_prime << ")";
+                    die(oss.str());
+                }
+                if (should_be_prime) last_prime = n;
+            }
+        }
+        b0 += nb;
+    }
+
+    if (in.peek() != std::char_traits<char>::eof()) die("Bitmap has trailing data beyond expected range.");
+
+    std::cout << "OK: verified wheel-30 prime bitmap from 7.." << max_n
+              << " (2, 3, 5 implicit)\n"
+              << "bytes=" << file_bytes
+              << "  primes_bits=" << primes_bits
+              << "  last=" << last_prime
+              << "  fnv1a64=0x" << std::hex << std::setw(16) << std::setfill('0') << fnv << std::dec
+              << "\n";
+}
+
 // Verify an odd-only bitmap file against a segmented sieve.
 // Assumes 1=prime, 0=composite in the file (your encoder inverts marks).
 // If include2==true, the very first bit corresponds to 2; otherwise the first
 // bit corresponds to 3 and we ignore 2 here (but still check via sieve).
+// A wheel-30 file (GBWHEEL0 magic) is detected and dispatched automatically.
 static void verify_bitmap_file(const std::string& path, bool include2) {
     // 1) Get file size and range
     std::ifstream in(path, std::ios::binary);
@@ -146,6 +244,24 @@ static void verify_bitmap_file(const std::string& path, bool include2) {
     u64 bytes = static_cast<u64>(sz);
     in.seekg(0, std::ios::beg);
 
+    if (bytes >= GB_WHEEL30_HDR_BYTES) {
+        char hdr[GB_WHEEL30_HDR_BYTES];
+        if (!in.read(hdr, GB_WHEEL30_HDR_BYTES)) die("Bitmap read error at header");
+        if (isWheel30Bitmap(reinterpret_cast<const uint8_t*>(hdr), GB_WHEEL30_HDR_BYTES)) {
+            if (include2) die("--bitmap-include2 does not apply to wheel-30 bitmaps");
+            // Fold the header into the fingerprint, then verify the payload.
+            u64 fnv = 1469598103934665603ull;
+            for (unsigned i = 0; i < GB_WHEEL30_HDR_BYTES; ++i) {
+                static constexpr u64 FNV_PRIME = 1099511628211ull;
+                fnv ^= (u64)(unsigned char)hdr[i];
+                fnv *= FNV_PRIME;
+            }
+            verify_wheel30_file(in, bytes, fnv);
+            return;
+        }
+        in.seekg(0, std::ios::beg);
+    }
+
     // If include2, the mapping is: bit0 -> 2, bit1 -> 3, bit2 -> 5, etc.
     // If odd-only, mapping is: bit0 -> 3, bit1 -> 5, ...
     // We'll verify odd domain bit-for-bit; for include2 we additionally verify the very first bit equals (2 is prime).
@@ -356,11 +472,137 @@ struct SegPrimeGen {
     }
 };
 
+// Tree-hash verification: the file is cut at the --segment value boundaries,
+// segments are verified and hashed concurrently against a shared base-prime
+// table, and the per-segment FNV digests are folded in order into a stable
+// root digest.  A corrupted segment is reported by index and value range, so
+// a re-check does not need to re-hash the whole file.
+static void verify_tree_hash(const Args& a) {
+    int fd = ::open(a.path.c_str(), O_RDONLY);
+    if (fd < 0) die("Failed to open file: " + a.path);
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) { ::close(fd); die("Failed to stat file: " + a.path); }
+    u64 bytes = (u64)st.st_size;
+    if (bytes == 0) { ::close(fd); die("File is empty; expected at least the prime 2."); }
+    if (bytes % 8) { ::close(fd); die("File size is not a multiple of 8 bytes."); }
+    const u64* v = (const u64*)::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (v == MAP_FAILED) { ::close(fd); die("mmap failed: " + a.path); }
+    u64 count = bytes / 8;
+    u64 last = v[count - 1];
+
+    if (v[0] != 2) die("File must start with the prime 2.");
+
+    // Shared read-only base primes up to sqrt(last); workers only read it.
+    u64 need = (u64)std::floor(std::sqrt((long double)last));
+    if (need < 2) need = 2;
+    std::vector<u64> base;
+    sieve_small(need, base);
+
+    const u64 total_segments = (last - 2) / a.segment + 1;
+    std::vector<u64> digests(total_segments, 0);
+    std::vector<u64> seg_counts(total_segments, 0);
+    std::vector<std::string> errors(total_segments);
+
+    unsigned nthreads = a.threads ? a.threads : std::thread::hardware_concurrency();
+    if (nthreads < 1) nthreads = 1;
+    if ((u64)nthreads > total_segments) nthreads = (unsigned)total_segments;
+
+    std::atomic<u64> next_seg{0};
+    auto worker = [&]{
+        std::vector<char> mark;
+        for (;;) {
+            u64 seg = next_seg.fetch_add(1);
+            if (seg >= total_segments) return;
+            u64 lo = 2 + seg * a.segment;
+            u64 hi = lo + a.segment - 1;
+            if (hi > last) hi = last;
+
+            // File slice holding the values of [lo, hi]
+            const u64* s_begin = std::lower_bound(v, v + count, lo);
+            const u64* s_end = std::lower_bound(v, v + count, hi + 1);
+
+            // Sieve [lo, hi]
+            mark.assign(hi - lo + 1, 1);
+            for (u64 p : base) {
+                u128 pp = (u128)p * (u128)p;
+                if (pp > (u128)hi) break;
+                u64 start = (lo + p - 1) / p * p;
+                if (start < (u64)pp) start = (u64)pp;
+                for (u64 m = start; m <= hi; m += p) {
+                    mark[m - lo] = 0;
+                }
+            }
+
+            // Every prime in [lo, hi] must appear, in order, and nothing else.
+            u64 fnv = 1469598103934665603ull;
+            const u64* cur = s_begin;
+            bool bad = false;
+            for (u64 n = lo; n <= hi && !bad; ++n) {
+                if (!mark[n - lo]) continue;
+                if (cur >= s_end || *cur != n) {
+                    std::ostringstream oss;
+                    oss << "Mismatch in segment " << seg << " (values " << lo << ".." << hi
+                        << "): expected prime " << n << " but file has "
+                        << (cur < s_end ? std::to_string(*cur) : std::string("EOF")) << ".";
+                    errors[seg] = oss.str();
+                    bad = true;
+                    break;
+                }
+                fnv = fnv1a64_update(fnv, *cur);
+                ++cur;
+            }
+            if (!bad && cur != s_end) {
+                std::ostringstream oss;
+                oss << "Mismatch in segment " << seg << " (values " << lo << ".." << hi
+                    << "): file has non-prime or out-of-order value " << *cur << ".";
+                errors[seg] = oss.str();
+                bad = true;
+            }
+            if (!bad) {
+                digests[seg] = fnv;
+                seg_counts[seg] = (u64)(s_end - s_begin);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < nthreads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+
+    for (u64 seg = 0; seg < total_segments; ++seg) {
+        if (!errors[seg].empty()) die(errors[seg]);
+    }
+
+    // Slices are half-open and contiguous over sorted data; any value outside
+    // every segment (e.g. below 2 or out of order) shows up as a count gap.
+    u64 matched = 0;
+    u64 root = 1469598103934665603ull;
+    for (u64 seg = 0; seg < total_segments; ++seg) {
+        matched += seg_counts[seg];
+        root = fnv1a64_update(root, digests[seg]);
+    }
+    if (matched != count) die("File contains values outside the certified range.");
+
+    std::cout << "OK: verified complete prime sequence from 2.." << last << "\n"
+              << "count=" << count
+              << "  last=" << last
+              << "  tree_fnv1a64=0x" << std::hex << std::setw(16) << std::setfill('0') << root << std::dec
+              << "  segments=" << total_segments
+              << "\n";
+
+    ::munmap((void*)v, bytes);
+    ::close(fd);
+}
+
 int main(int argc, char** argv) {
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
 
     Args a = parse_args(argc, argv);
+    if (a.tree) {
+        verify_tree_hash(a);
+        return 0;
+    }
     if (a.bitmap) {
         // Certify bitmap file independently (no raw prime file needed)
         verify_bitmap_file(a.path, a.bitmap_include2);
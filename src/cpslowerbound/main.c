@@ -1,11 +1,11 @@
 // cpslowerbound - calculates lower bounds for a list of n values
 // Copyright (C) 2025 Bill C. Riemers
-// 
+//
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
 // the Free Software Foundation, either version 3 of the License, or
 // (at your option) any later version.
-// 
+//
 // This program is distributed in the hope that it will be useful,
 // but WITHOUT ANY WARRANTY; without even the implied warranty of
 // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
@@ -16,6 +16,14 @@
 
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+// The input list is slurped and sorted before processing, so the Euler
+// product cursors (primePtr1/primePtr2) and the pair-count cursor only
+// ever move forward and the cost no longer depends on input ordering.
+// With --threads=N the sorted list is split into contiguous chunks
+// processed by workers with private cursors; results are buffered and
+// emitted in the original input order either way, so the output is
+// byte-identical to the old streaming loop.
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -27,17 +35,120 @@
 #include <unistd.h>
 #include <math.h>
 #include <inttypes.h>
+#include <pthread.h>
 #include "libprime.h"
 
+typedef struct {
+    uint64_t n;
+    uint64_t idx;   // position in the input list
+} InputN;
+
+typedef struct {
+    int ok;         // 0 when the prime store ended before this n
+    int decade;
+    uint64_t n;
+    long double Cmin;
+    long double Cminus;
+    long double CminusAsym;
+} Result;
+
+typedef struct {
+    const InputN *items;    // sorted by n
+    size_t begin, end;      // this worker's contiguous chunk
+    uint64_t *prime_array;
+    const uint64_t *prime_array_end;
+    Result *results;        // indexed by original input position
+} Chunk;
+
+static int cmp_input(const void *a, const void *b) {
+    const InputN *x = (const InputN *)a;
+    const InputN *y = (const InputN *)b;
+    if (x->n != y->n) return (x->n < y->n) ? -1 : 1;
+    return (x->idx < y->idx) ? -1 : (x->idx > y->idx);
+}
+
+// Process one sorted chunk with private cursors.  The per-n products are
+// the same ascending factor sequences the streaming loop accumulated, so
+// the values match it bit for bit.
+static void *process_chunk(void *arg) {
+    Chunk *c = (Chunk *)arg;
+    uint64_t *prime_array = c->prime_array;
+    const uint64_t *prime_array_end = c->prime_array_end;
+    const uint64_t *prime_array_last = prime_array_end-1;
+    const uint64_t *current = prime_array;
+
+    long double l32 = log((long double)(3.0L/2.0L));
+    // primePtr1[0] is reserved for sanity-checking sorted input
+    // primePtr1[1] is the actual current prime
+    uint64_t *primePtr1 = prime_array;
+    long double prodSeries1 = 1.0L;
+    // primePtr2[0] is reserved for sanity-checking sorted input
+    // primePtr2[1] is the actual current prime
+    uint64_t *primePtr2 = prime_array;
+    long double prodSeries2 = 1.0L;
+    long double invlog10 = 1.0L/log(10.0L);
+    for (size_t k = c->begin; k < c->end; ++k) {
+        const uint64_t n = c->items[k].n;
+        Result *r = &c->results[c->items[k].idx];
+        uint64_t y2 = (uint64_t)floor(sqrt(1.5L*(long double)n));
+        if(primePtr2[0] > y2) {
+           primePtr2 = prime_array;
+           prodSeries2 = 1.0L;
+        }
+        for(;primePtr2[1] < 3;primePtr2++);
+        for(;primePtr2 < prime_array_last && primePtr2[1] <= y2;primePtr2++) {
+            prodSeries2 *= 1.0L - 1.0L/((long double)(primePtr2[1]-1));
+        }
+        if(primePtr2 == prime_array_last) {
+            // Later n in this sorted chunk only need more; leave them unset.
+            break;
+        }
+        uint64_t y1 = (uint64_t)floor(sqrt((long double)n));
+        if(primePtr1[0] > y1) {
+           primePtr1 = prime_array;
+           prodSeries1 = 1.0L;
+        }
+        for(;primePtr1[1] < 3;primePtr1++);
+        for(;primePtr1[1] <= y1;primePtr1++) {
+            prodSeries1 *= 1.0L - 1.0L/((long double)(primePtr1[1]-1));
+        }
+        long double logN  = log((long double)n);
+        long double ln3  = l32 + logN;
+	long double logNlogN = logN*logN;
+        long double Cminus = logNlogN*prodSeries1*prodSeries2;
+        long double CminusAsym = KPRODKPROD*logN/ln3;
+        uint64_t delta = (n>>1);
+        uint64_t n_min = n-delta-1;
+        uint64_t pairCount = countRangedPairs(n,n_min,&current,prime_array,prime_array_end);
+        long double Cmin = ((logNlogN)/delta)*pairCount;
+        r->decade = (int)(logN*invlog10);
+        r->n = n;
+        r->Cmin = Cmin;
+        r->Cminus = Cminus;
+        r->CminusAsym = CminusAsym;
+        r->ok = 1;
+    }
+    return NULL;
+}
+
 int main(int argc, char* argv[]) {
+    int num_threads = 1;
+    if (argc == 4 && !strncmp(argv[1],"--threads=",10)) {
+        num_threads = atoi(argv[1]+10);
+        if (num_threads < 1) {
+            fprintf(stderr,"Threads must be >= 1\n");
+            exit(1);
+        }
+        argv++;
+        argc--;
+    }
     if (argc != 3) {
-        fprintf(stderr,"Usage: %s <prime_raw_file> <inputlist>\n",argv[0]);
+        fprintf(stderr,"Usage: %s [--threads=N] <prime_raw_file> <inputlist>\n",argv[0]);
         exit(1);
     }
 
     const char *prime_file = argv[1];
     const char *input_file = argv[2];
-    // const uint64_t end_n = strtoull(argv[2], NULL, 10);
 
     FILE *fin = fopen(input_file,"r");
     if(fin == NULL) {
@@ -79,62 +190,92 @@ int main(int argc, char* argv[]) {
         exit(1);
     }
 
-
     const uint64_t *prime_array_end = prime_array + ((uint64_t)st.st_size/sizeof(uint64_t));
-    const uint64_t *prime_array_last = prime_array_end-1;
-    const uint64_t *current = prime_array; 
 
-    long double l32 = log((long double)(3.0L/2.0L));
-    uint64_t n=0;
-    // primePtr1[0] is reserved for sanity-checking sorted input
-    // primePtr1[1] is the actual current prime
-    uint64_t *primePtr1 = prime_array;
-    long double prodSeries1 = 1.0L;
-    // primePtr2[0] is reserved for sanity-checking sorted input
-    // primePtr2[1] is the actual current prime
-    uint64_t *primePtr2 = prime_array;
-    long double prodSeries2 = 1.0L;
-    printf("Dec.,n_0,Cmin,Cminus,Cmin-Cminus,CminusAsym,Cmin-CminusAsym\n");
-    long double invlog10 = 1.0L/log(10.0L);
+    // Slurp the whole input list, remembering original positions.
+    size_t count = 0, cap = 1u << 16;
+    InputN *items = malloc(cap * sizeof(InputN));
+    if (!items) {
+        fprintf(stderr, "Failed to allocate input list\n");
+        exit(1);
+    }
+    uint64_t n = 0;
     while(fscanf(fin,"%" PRIu64,&n) == 1) {
-        uint64_t y2 = (uint64_t)floor(sqrt(1.5L*(long double)n));
-        if(primePtr2[0] > y2) {
-           primePtr2 = prime_array; 
-           prodSeries2 = 1.0L;
+        if (count == cap) {
+            cap <<= 1;
+            InputN *grown = realloc(items, cap * sizeof(InputN));
+            if (!grown) {
+                fprintf(stderr, "Failed to grow input list\n");
+                exit(1);
+            }
+            items = grown;
         }
-        for(;primePtr2[1] < 3;primePtr2++);
-        for(;primePtr2 < prime_array_last && primePtr2[1] <= y2;primePtr2++) {
-            prodSeries2 *= 1.0L - 1.0L/((long double)(primePtr2[1]-1));
-        }
-        if(primePtr2 == prime_array_last) {
-            fprintf(stderr, "Error: more primes needed for n=%" PRIu64 "\n", n);
-            break;
+        items[count].n = n;
+        items[count].idx = count;
+        count++;
+    }
+    fclose(fin);
+
+    Result *results = calloc(count ? count : 1, sizeof(Result));
+    if (!results) {
+        fprintf(stderr, "Failed to allocate result list\n");
+        exit(1);
+    }
+
+    qsort(items, count, sizeof(InputN), cmp_input);
+    for (size_t k = 0; k < count; ++k) {
+        results[items[k].idx].n = items[k].n;
+    }
+
+    if ((size_t)num_threads > count && count > 0) {
+        num_threads = (int)count;
+    }
+    Chunk *chunks = calloc(num_threads, sizeof(Chunk));
+    pthread_t *threads = calloc(num_threads, sizeof(pthread_t));
+    if (!chunks || !threads) {
+        fprintf(stderr, "Failed to allocate worker chunks\n");
+        exit(1);
+    }
+    for (int t = 0; t < num_threads; ++t) {
+        chunks[t].items = items;
+        chunks[t].begin = count * (size_t)t / num_threads;
+        chunks[t].end   = count * (size_t)(t+1) / num_threads;
+        chunks[t].prime_array = prime_array;
+        chunks[t].prime_array_end = prime_array_end;
+        chunks[t].results = results;
+    }
+    if (num_threads == 1) {
+        process_chunk(&chunks[0]);
+    }
+    else {
+        for (int t = 0; t < num_threads; ++t) {
+            if (pthread_create(&threads[t], NULL, process_chunk, &chunks[t])) {
+                fprintf(stderr, "Failed to create worker thread\n");
+                exit(1);
+            }
         }
-        uint64_t y1 = (uint64_t)floor(sqrt((long double)n));
-        if(primePtr1[0] > y1) {
-           primePtr1 = prime_array; 
-           prodSeries1 = 1.0L;
+        for (int t = 0; t < num_threads; ++t) {
+            pthread_join(threads[t], NULL);
         }
-        for(;primePtr1[1] < 3;primePtr1++);
-        for(;primePtr1[1] <= y1;primePtr1++) {
-            prodSeries1 *= 1.0L - 1.0L/((long double)(primePtr1[1]-1));
+    }
+
+    // Emit in original input order, stopping at the first entry the prime
+    // store could not cover - same truncation the streaming loop had.
+    printf("Dec.,n_0,Cmin,Cminus,Cmin-Cminus,CminusAsym,Cmin-CminusAsym\n");
+    for (size_t i = 0; i < count; ++i) {
+        const Result *r = &results[i];
+        if (!r->ok) {
+            fprintf(stderr, "Error: more primes needed for n=%" PRIu64 "\n", r->n);
+            break;
         }
-        long double logN  = log((long double)n);
-        long double ln3  = l32 + logN;
-	long double logNlogN = logN*logN;
-        long double Cminus = logNlogN*prodSeries1*prodSeries2;
-        long double CminusAsym = KPRODKPROD*logN/ln3;
-        uint64_t delta = (n>>1);
-        uint64_t n_min = n-delta-1;
-        uint64_t pairCount = countRangedPairs(n,n_min,&current,prime_array,prime_array_end);
-        long double Cmin = ((logNlogN)/delta)*pairCount;
-	int decade = (int)(logN*invlog10);
         printf("%d,%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF\n",
-            decade,n,Cmin,Cminus,Cmin-Cminus,CminusAsym,Cmin-CminusAsym);
+            r->decade,r->n,r->Cmin,r->Cminus,r->Cmin-r->Cminus,r->CminusAsym,r->Cmin-r->CminusAsym);
     }
-    fclose(fin);
+    free(threads);
+    free(chunks);
+    free(results);
+    free(items);
     munmap(prime_array, st.st_size);
     close(fd);
     exit(0);
 }
-
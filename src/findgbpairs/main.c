@@ -29,14 +29,68 @@
 #include <inttypes.h>
 #include "libprime.h"
 
+// Buffered writer for --binary mode: 4096 records (64KB) per fwrite so the
+// per-n cost is a couple of stores instead of a printf.
+#define PAIR_BUF_RECORDS 4096
+
+typedef struct {
+    FILE *out;
+    GBPairRecord buf[PAIR_BUF_RECORDS];
+    size_t fill;
+} PairWriter;
+
+static void pair_writer_flush(PairWriter *w) {
+    if (w->fill) {
+        fwrite(w->buf, sizeof(GBPairRecord), w->fill, w->out);
+        w->fill = 0;
+    }
+}
+
+static void pair_writer_put(PairWriter *w, uint64_t n, uint64_t m) {
+    if (w->fill == PAIR_BUF_RECORDS) {
+        pair_writer_flush(w);
+    }
+    w->buf[w->fill].n = n;
+    w->buf[w->fill].m = m;
+    w->fill++;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        fprintf(stderr,"Usage: %s <prime_raw_file> <end_n>\n",argv[0]);
+    // --bitmap: read the odd-prime bitmap from primesieve_bitmap directly,
+    // skipping the storeprimes stage and its 8-byte-per-prime raw file.
+    int use_bitmap = 0;
+    // --binary: GBPAIRS0 magic plus fixed-width (n,m) records on stdout,
+    // so sweep consumers can mmap the output instead of re-parsing CSV.
+    int binary = 0;
+    uint64_t start_n = 2;
+    uint64_t stride = 1;
+    int i = 1;
+    for (; i < argc && !strncmp(argv[i],"--",2); i++) {
+        if (!strcmp(argv[i],"--bitmap")) {
+            use_bitmap = 1;
+        }
+        else if (!strcmp(argv[i],"--binary")) {
+            binary = 1;
+        }
+        else if (!strncmp(argv[i],"--start=",8)) {
+            start_n = strtoull(argv[i]+8, NULL, 10);
+        }
+        else if (!strncmp(argv[i],"--stride=",9)) {
+            stride = strtoull(argv[i]+9, NULL, 10);
+        }
+        else {
+            fprintf(stderr,"Unknown flag: %s\n",argv[i]);
+            exit(1);
+        }
+    }
+    if (argc - i != 2 || stride == 0) {
+        fprintf(stderr,"Usage: %s [--bitmap] [--binary] [--start=N] [--stride=K]"
+            " <prime_raw_file|prime_bitmap_file> <end_n>\n",argv[0]);
         exit(1);
     }
 
-    const char *prime_file = argv[1];
-    const uint64_t end_n = strtoull(argv[2], NULL, 10);
+    const char *prime_file = argv[i];
+    const uint64_t end_n = strtoull(argv[i+1], NULL, 10);
 
     // Open and mmap prime file
     int fd = open(prime_file, O_RDONLY);
@@ -65,20 +119,43 @@ int main(int argc, char* argv[]) {
     uint64_t *prime_array_end = prime_array + ((uint64_t)st.st_size/sizeof(uint64_t));
     uint64_t *current = prime_array; 
 
-    uint64_t n_start = 4;
     int exitStatus = 0;
-    printf("2N,N-M,N+M,2M\n");
-    printf("4,2,2,0\n");
-    printf("6,3,3,0\n");
-    for (uint64_t n = n_start;n < end_n ;n++) {
-        int m = findPair(n,&current,prime_array,prime_array_end);
+    PairWriter writer = { stdout, {{0,0}}, 0 };
+    if (binary) {
+        fwrite(GB_PAIRS_MAGIC, 1, GB_PAIRS_HDR_BYTES, stdout);
+    }
+    else {
+        printf("2N,N-M,N+M,2M\n");
+    }
+    if (start_n < 2) {
+        start_n = 2;
+    }
+    const uint8_t *bitmap = (const uint8_t*)prime_array;
+    const uint64_t bitmap_bits = (uint64_t)st.st_size << 3;
+    for (uint64_t n = start_n;n < end_n ;n += stride) {
+        int m;
+        // 4=2+2 and 6=3+3 are the diagonal pairs below the search range.
+        if (n < 4) {
+            m = 0;
+        }
+        else {
+            m = use_bitmap
+                ? findPairBitmap(n,bitmap,bitmap_bits)
+                : findPair(n,&current,prime_array,prime_array_end);
+        }
 	if(m < 0) {
 	    fprintf(stderr,"Failed to find pair at %" PRIu64 "\n",n);
 	    exitStatus= -1;
 	    break;
 	}
-        printf("%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%d\n",n<<1,n-m,n+m,m<<1);
+        if (binary) {
+            pair_writer_put(&writer,n,(uint64_t)m);
+        }
+        else {
+            printf("%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%d\n",n<<1,n-m,n+m,m<<1);
+        }
     }
+    pair_writer_flush(&writer);
 
     munmap(prime_array, st.st_size);
     close(fd);
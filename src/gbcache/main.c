@@ -0,0 +1,379 @@
+// gbcache - content-addressed stage cache for pipeline restarts
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Stages are fingerprinted by the SHA-256 of their input file CONTENTS
+// plus the exact parameter strings (alpha, n range, compat, model, ...),
+// never by timestamps or tool binaries, so a rebuilt binary with
+// unchanged behavior or a re-clone on another node still hits.  Wrap a
+// recipe like:
+//
+//   gbcache run --in primes.raw --param "alpha=0.5 4..1e9 v0.2.0 emp"
+//       --out dec-full.csv --out dec-cps.csv -- gbpairsummary ...
+//
+// On a hit the stored outputs are copied back and the command never
+// runs; on a miss the command runs and its outputs are stored under
+// store/<key>/ (atomically, via a temp directory rename).  The store
+// directory comes from --store=DIR, $GBCACHE_STORE, or ./.gbcache.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "libprime.h"
+
+#define COPY_CHUNK (1u << 20)
+#define MAX_FILES 64
+
+static const char *store_dir = NULL;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Usage: %s [--store=DIR] <command>\n"
+        "Commands:\n"
+        "  key --in FILE... --param STR...\n"
+        "      Print the stage fingerprint (input contents + parameters)\n"
+        "  get KEY --out FILE...\n"
+        "      Restore stored outputs for KEY; exit 1 on miss\n"
+        "  put KEY --out FILE...\n"
+        "      Store the outputs under KEY\n"
+        "  run --in FILE... --param STR... --out FILE... -- COMMAND...\n"
+        "      Restore on hit, else run COMMAND and store its outputs\n"
+        "The store comes from --store, $GBCACHE_STORE, or ./.gbcache.\n",
+        prog);
+}
+
+static int hash_file(GBSha256 *s, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "gbcache: cannot read input %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    static uint8_t chunk[COPY_CHUNK];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        gbSha256Update(s, chunk, got);
+    }
+    const int err = ferror(f);
+    fclose(f);
+    if (err) {
+        fprintf(stderr, "gbcache: read error on %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+// Fingerprint: tagged, length-delimited fields so boundaries cannot
+// collide ("F" <len> <content>)* ("P" <len> <param>)*.
+static int stage_key(char hex[65], char **ins, int nin, char **params, int nparams) {
+    GBSha256 s;
+    gbSha256Init(&s);
+    for (int i = 0; i < nin; ++i) {
+        struct stat st;
+        if (stat(ins[i], &st) < 0) {
+            fprintf(stderr, "gbcache: cannot stat input %s: %s\n", ins[i], strerror(errno));
+            return -1;
+        }
+        const uint64_t len = (uint64_t)st.st_size;
+        gbSha256Update(&s, "F", 1);
+        gbSha256Update(&s, &len, sizeof(len));
+        if (hash_file(&s, ins[i]) != 0) {
+            return -1;
+        }
+    }
+    for (int i = 0; i < nparams; ++i) {
+        const uint64_t len = (uint64_t)strlen(params[i]);
+        gbSha256Update(&s, "P", 1);
+        gbSha256Update(&s, &len, sizeof(len));
+        gbSha256Update(&s, params[i], (size_t)len);
+    }
+    uint8_t digest[32];
+    gbSha256Final(&s, digest);
+    gbSha256Hex(digest, hex);
+    return 0;
+}
+
+static int copy_file(const char *src, const char *dst) {
+    FILE *in = fopen(src, "rb");
+    if (!in) {
+        fprintf(stderr, "gbcache: cannot read %s: %s\n", src, strerror(errno));
+        return -1;
+    }
+    FILE *out = fopen(dst, "wb");
+    if (!out) {
+        fprintf(stderr, "gbcache: cannot write %s: %s\n", dst, strerror(errno));
+        fclose(in);
+        return -1;
+    }
+    static uint8_t chunk[COPY_CHUNK];
+    size_t got;
+    int rc = 0;
+    while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        if (fwrite(chunk, 1, got, out) != got) {
+            rc = -1;
+            break;
+        }
+    }
+    if (ferror(in)) {
+        rc = -1;
+    }
+    fclose(in);
+    if (fclose(out) != 0) {
+        rc = -1;
+    }
+    if (rc != 0) {
+        fprintf(stderr, "gbcache: copy %s -> %s failed\n", src, dst);
+    }
+    return rc;
+}
+
+static int mkdir_p(const char *path) {
+    char buf[4096];
+    snprintf(buf, sizeof(buf), "%s", path);
+    for (char *p = buf + 1; *p; ++p) {
+        if (*p == '/') {
+            *p = '\0';
+            if (mkdir(buf, 0777) < 0 && errno != EEXIST) {
+                return -1;
+            }
+            *p = '/';
+        }
+    }
+    if (mkdir(buf, 0777) < 0 && errno != EEXIST) {
+        return -1;
+    }
+    return 0;
+}
+
+// Stored outputs keep only their position; the caller's --out list names
+// the destinations, so the same artifacts can be restored to new paths.
+static void entry_path(char *buf, size_t buflen, const char *key, int i) {
+    snprintf(buf, buflen, "%s/%s/out%d", store_dir, key, i);
+}
+
+// A hit requires the terminal manifest (written last in the temp
+// directory, made visible by the rename) to record the output count.
+static int cache_lookup(const char *key, int nout) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s/manifest", store_dir, key);
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return 0;
+    }
+    int stored = -1;
+    const int ok = (fscanf(f, "%d", &stored) == 1 && stored == nout);
+    fclose(f);
+    return ok;
+}
+
+static int cache_restore(const char *key, char **outs, int nout) {
+    char path[4096];
+    for (int i = 0; i < nout; ++i) {
+        entry_path(path, sizeof(path), key, i);
+        if (copy_file(path, outs[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int cache_store(const char *key, char **outs, int nout) {
+    char tmpdir[4096], final_dir[4096], path[4352];
+    snprintf(final_dir, sizeof(final_dir), "%s/%s", store_dir, key);
+    snprintf(tmpdir, sizeof(tmpdir), "%s/%s.tmp.%d", store_dir, key, (int)getpid());
+    if (mkdir_p(tmpdir) < 0) {
+        fprintf(stderr, "gbcache: cannot create %s: %s\n", tmpdir, strerror(errno));
+        return -1;
+    }
+    for (int i = 0; i < nout; ++i) {
+        snprintf(path, sizeof(path), "%s/out%d", tmpdir, i);
+        if (copy_file(outs[i], path) != 0) {
+            return -1;
+        }
+    }
+    snprintf(path, sizeof(path), "%s/manifest", tmpdir);
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "gbcache: cannot write manifest: %s\n", strerror(errno));
+        return -1;
+    }
+    fprintf(f, "%d\n", nout);
+    for (int i = 0; i < nout; ++i) {
+        fprintf(f, "%s\n", outs[i]);
+    }
+    if (fclose(f) != 0) {
+        return -1;
+    }
+    if (rename(tmpdir, final_dir) < 0) {
+        if (errno == EEXIST || errno == ENOTEMPTY) {
+            // Another run of the same stage won the race; its artifacts
+            // are identical by construction.
+            char cleanup[8192];
+            snprintf(cleanup, sizeof(cleanup), "rm -rf '%s'", tmpdir);
+            if (system(cleanup) != 0) {
+                fprintf(stderr, "gbcache: warning: could not remove %s\n", tmpdir);
+            }
+            return 0;
+        }
+        fprintf(stderr, "gbcache: rename %s failed: %s\n", tmpdir, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+// Collect repeated --in/--param/--out options; returns the index of the
+// first unconsumed argument (or argc).
+static int collect(int argc, char **argv, int argi,
+                   char **ins, int *nin, char **params, int *nparams,
+                   char **outs, int *nout) {
+    for (; argi < argc; ++argi) {
+        char **list = NULL;
+        int *count = NULL;
+        if (!strcmp(argv[argi], "--in")) {
+            list = ins; count = nin;
+        }
+        else if (!strcmp(argv[argi], "--param")) {
+            list = params; count = nparams;
+        }
+        else if (!strcmp(argv[argi], "--out")) {
+            list = outs; count = nout;
+        }
+        else {
+            break;
+        }
+        if (argi + 1 >= argc) {
+            fprintf(stderr, "gbcache: %s needs a value\n", argv[argi]);
+            return -1;
+        }
+        if (*count >= MAX_FILES) {
+            fprintf(stderr, "gbcache: too many %s entries (max %d)\n", argv[argi], MAX_FILES);
+            return -1;
+        }
+        list[(*count)++] = argv[++argi];
+    }
+    return argi;
+}
+
+int main(int argc, char *argv[]) {
+    int argi = 1;
+    if (argi < argc && !strncmp(argv[argi], "--store=", 8)) {
+        store_dir = argv[argi] + 8;
+        argi++;
+    }
+    if (!store_dir) {
+        store_dir = getenv("GBCACHE_STORE");
+    }
+    if (!store_dir || !*store_dir) {
+        store_dir = ".gbcache";
+    }
+    if (argi >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *cmd = argv[argi++];
+    static char *ins[MAX_FILES], *params[MAX_FILES], *outs[MAX_FILES];
+    int nin = 0, nparams = 0, nout = 0;
+    char key[65];
+
+    if (!strcmp(cmd, "key")) {
+        if (collect(argc, argv, argi, ins, &nin, params, &nparams, outs, &nout) != argc
+            || nout > 0 || (nin == 0 && nparams == 0)) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (stage_key(key, ins, nin, params, nparams) != 0) {
+            return 1;
+        }
+        printf("%s\n", key);
+        return 0;
+    }
+    if (!strcmp(cmd, "get") || !strcmp(cmd, "put")) {
+        if (argi >= argc || strlen(argv[argi]) != 64) {
+            usage(argv[0]);
+            return 1;
+        }
+        snprintf(key, sizeof(key), "%s", argv[argi++]);
+        if (collect(argc, argv, argi, ins, &nin, params, &nparams, outs, &nout) != argc
+            || nin > 0 || nparams > 0 || nout == 0) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (!strcmp(cmd, "get")) {
+            if (!cache_lookup(key, nout)) {
+                fprintf(stderr, "gbcache: miss %s\n", key);
+                return 1;
+            }
+            return cache_restore(key, outs, nout) == 0 ? 0 : 1;
+        }
+        return cache_store(key, outs, nout) == 0 ? 0 : 1;
+    }
+    if (!strcmp(cmd, "run")) {
+        argi = collect(argc, argv, argi, ins, &nin, params, &nparams, outs, &nout);
+        if (argi < 0 || nout == 0 || argi >= argc || strcmp(argv[argi], "--")
+            || argi + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        char **run_argv = argv + argi + 1;
+        if (stage_key(key, ins, nin, params, nparams) != 0) {
+            return 1;
+        }
+        if (cache_lookup(key, nout)) {
+            if (cache_restore(key, outs, nout) == 0) {
+                fprintf(stderr, "gbcache: hit %s\n", key);
+                return 0;
+            }
+            // Damaged entry: fall through and recompute.
+            fprintf(stderr, "gbcache: damaged entry %s; recomputing\n", key);
+        }
+        const pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            execvp(run_argv[0], run_argv);
+            perror("execvp");
+            _exit(127);
+        }
+        int status = 0;
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)) {
+            fprintf(stderr, "gbcache: command exited abnormally\n");
+            return 1;
+        }
+        if (WEXITSTATUS(status) != 0) {
+            return WEXITSTATUS(status);
+        }
+        if (cache_store(key, outs, nout) != 0) {
+            // The outputs exist either way; a failed store only costs the
+            // next run a recompute.
+            fprintf(stderr, "gbcache: warning: could not store %s\n", key);
+        }
+        else {
+            fprintf(stderr, "gbcache: stored %s\n", key);
+        }
+        return 0;
+    }
+    usage(argv[0]);
+    return 1;
+}
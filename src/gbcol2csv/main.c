@@ -0,0 +1,96 @@
+// gbcol2csv - convert binary columnar interval output back to CSV
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "libprime.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr,"Usage: %s <columnar_file> [csv_file]\n",argv[0]);
+        fprintf(stderr,"Converts gbpairsummary --columnar output back to the CSV the\n");
+        fprintf(stderr,"equivalent text stream would have written (stdout by default).\n");
+        exit(1);
+    }
+
+    const char *in_file = argv[1];
+
+    int fd = open(in_file, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        exit(1);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror("fstat");
+        close(fd);
+        exit(1);
+    }
+
+    uint8_t* data = (uint8_t*)(
+        mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
+    );
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        exit(1);
+    }
+
+    GBColumnarReader reader;
+    if (gbColumnarReaderInit(&reader, data, (size_t)st.st_size) != 0) {
+        fprintf(stderr, "Error: %s is not a valid columnar file\n", in_file);
+        exit(1);
+    }
+
+    FILE *out = stdout;
+    if (argc == 3) {
+        out = fopen(argv[2], "w");
+        if (!out) {
+            perror("fopen");
+            exit(1);
+        }
+    }
+
+    if (reader.header_len) {
+        fwrite(reader.header, 1, reader.header_len, out);
+    }
+    char line[4096];
+    for (uint64_t row = 0; row < reader.nrows; row++) {
+        const int len = gbColumnarFormatRow(&reader, row, line, sizeof(line));
+        if (len < 0) {
+            fprintf(stderr, "Error: failed to format row %" PRIu64 "\n", row);
+            exit(1);
+        }
+        fwrite(line, 1, (size_t)len, out);
+    }
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    munmap(data, st.st_size);
+    close(fd);
+    exit(0);
+}
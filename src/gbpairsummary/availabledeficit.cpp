@@ -109,6 +109,79 @@ static inline uint64_t min_u64(uint64_t a, uint64_t b) {
     return (a < b) ? a : b;
 }
 
+// cap_tent expressed over the residue n mod p instead of n itself, so the
+// phase can be tabulated per prime.
+static inline uint64_t cap_tent_res(uint64_t n_mod_p, uint64_t p, uint64_t r) {
+    uint64_t m = p - r;
+    uint64_t t = (n_mod_p + r) % p;
+    uint64_t k = t + 1;
+    return (k < m ? k : m);
+}
+
+// Builds the per-prime residue tables, the combined low-primorial tables
+// and the committed-product chains for this parameter configuration.  Only
+// configurations where no residue count can reach zero are table-indexable:
+// a zero count makes the loop skip the prime entirely, which changes the
+// committed set per n instead of just the term value.
+void AvailableDeficit::build_tables()
+{
+    tabs_built = true;
+    if (allow_reductions ? residue < 2ULL : residue < 1ULL) {
+        return;
+    }
+    if (allow_tail_reductions ? residue_tail < 2ULL : residue_tail < 1ULL) {
+        return;
+    }
+
+    tab_off.resize(PRIMES_COUNT);
+    std::size_t total = 0;
+    for (std::size_t j = 0; j < PRIMES_COUNT; ++j) {
+        tab_off[j] = total;
+        total += (std::size_t)PRIMES[j];
+    }
+    base_tab.resize(total);
+    tail_tab.resize(total);
+    for (std::size_t j = 0; j < PRIMES_COUNT; ++j) {
+        const uint64_t p = PRIMES[j];
+        for (uint64_t res = 0; res < p; ++res) {
+            const uint64_t rb = (allow_reductions && res == 0ULL) ? residue - 1ULL : residue;
+            base_tab[tab_off[j] + (std::size_t)res] =
+                ln_small_upto99(tenting ? cap_tent_res(res, p, rb) : (p - rb));
+            const uint64_t rt = (allow_tail_reductions && res == 0ULL) ? residue_tail - 1ULL : residue_tail;
+            tail_tab[tab_off[j] + (std::size_t)res] =
+                ln_small_upto99(tenting ? cap_tent_res(res, p, rt) : (p - rt));
+        }
+    }
+
+    for (std::size_t start = 0; start < 2; ++start) {
+        prodq[start].assign(PRIMES_COUNT, UINT64_MAX);
+        uint64_t q = 1ULL;
+        for (std::size_t k = start; k < PRIMES_COUNT; ++k) {
+            if (q > UINT32_MAX) {
+                break;  // the fence scan never looks past the first overrun
+            }
+            q *= PRIMES[k] - prime_offset;
+            prodq[start][k] = q;
+        }
+        for (std::size_t lvl = 0; lvl <= kCumLowLevels; ++lvl) {
+            uint64_t Q = 1ULL;
+            for (std::size_t j = start; j < lvl; ++j) {
+                Q *= PRIMES[j];
+            }
+            cum_low_mod[start][lvl] = Q;
+            cum_low[start][lvl].resize((std::size_t)Q);
+            for (uint64_t res = 0; res < Q; ++res) {
+                long double s = 0.0L;
+                for (std::size_t j = start; j < lvl; ++j) {
+                    s += base_tab[tab_off[j] + (std::size_t)(res % PRIMES[j])];
+                }
+                cum_low[start][lvl][(std::size_t)res] = s;
+            }
+        }
+    }
+    tabs_usable = true;
+}
+
 /*
  * ============================================================================
  *  CONJECTURAL: Unproven prime curvature geometry approximation
@@ -175,21 +248,47 @@ long double AvailableDeficit::allowed_prime_deficit_internal(std::uint64_t n, st
         const std::uint64_t pm = PRIMES[PRIMES_COUNT-1]-prime_offset;
         // if(residue > 1ULL && w_int > pm*pm) {
         if(residue > 1ULL && w_int > pm) {
-            size_t j = i;
-            for (q_next = q_committed; i <  PRIMES_COUNT; ++i, q_committed = q_next) {
-                q_next *= (PRIMES[i]-prime_offset);
-                // Check if q_next exceeds UINT32_MAX before squaring to avoid overflow
-                if ((q_next > UINT32_MAX) || ((q_next*q_next) > w_int)) {
-                // if (q_next > w_int) {
-                    break;
+            if (!tabs_built) {
+                build_tables();
+            }
+            if (tabs_usable) {
+                // Residue-table path: the committed set for this start index
+                // depends only on w_int, so the fence scan is comparisons
+                // against the tabulated products, the first levels are one
+                // load indexed by n mod their primorial, and the rest are
+                // per-prime loads.  Matches the loop below term for term.
+                const size_t start = i;
+                size_t k = start;
+                for (q_next = q_committed; k < PRIMES_COUNT; ++k, q_committed = q_next) {
+                    q_next = prodq[start][k];
+                    if ((q_next > UINT32_MAX) || ((q_next*q_next) > w_int)) {
+                        break;
+                    }
+                }
+                i = k;
+                const size_t lvl = (k < kCumLowLevels) ? k : kCumLowLevels;
+                sumlog = cum_low[start][lvl][(size_t)(n % cum_low_mod[start][lvl])];
+                for (size_t j = lvl; j < k; ++j) {
+                    sumlog += base_tab[tab_off[j] + (size_t)(n % PRIMES[j])];
                 }
             }
-            // q = product of NONDIVIDING primes (transition primes included)
-            // Note: j < i (not j <= i) because i points to the prime AFTER the break
-            for (; j < i; ++j) {
-                const uint64_t p = PRIMES[j];
-                const uint64_t r = (allow_reductions && (n % p) == 0ULL) ? residue-1ULL : residue;
-                sumlog += ln_small_upto99(tenting?cap_tent(n, p, r):(p-r));
+            else {
+                size_t j = i;
+                for (q_next = q_committed; i <  PRIMES_COUNT; ++i, q_committed = q_next) {
+                    q_next *= (PRIMES[i]-prime_offset);
+                    // Check if q_next exceeds UINT32_MAX before squaring to avoid overflow
+                    if ((q_next > UINT32_MAX) || ((q_next*q_next) > w_int)) {
+                    // if (q_next > w_int) {
+                        break;
+                    }
+                }
+                // q = product of NONDIVIDING primes (transition primes included)
+                // Note: j < i (not j <= i) because i points to the prime AFTER the break
+                for (; j < i; ++j) {
+                    const uint64_t p = PRIMES[j];
+                    const uint64_t r = (allow_reductions && (n % p) == 0ULL) ? residue-1ULL : residue;
+                    sumlog += ln_small_upto99(tenting?cap_tent(n, p, r):(p-r));
+                }
             }
         }
         else {
@@ -235,12 +334,21 @@ long double AvailableDeficit::allowed_prime_deficit_internal(std::uint64_t n, st
             if(p > p_max) {
                 break;
             }
-            const uint64_t r = (allow_tail_reductions && (n % p) == 0ULL) ? residue_tail-1ULL : residue_tail;
-            if (r == 0ULL) {
-                continue;
+            long double lnterm;
+            if (tabs_usable) {
+                // r can never be 0 when the tables are usable, so the skip
+                // below is unreachable and the term is a single load.
+                lnterm = tail_tab[tab_off[i-1] + (size_t)(n % p)];
+            }
+            else {
+                const uint64_t r = (allow_tail_reductions && (n % p) == 0ULL) ? residue_tail-1ULL : residue_tail;
+                if (r == 0ULL) {
+                    continue;
+                }
+                lnterm = ln_small_upto99(tenting?cap_tent(n, p, r):(p-r));
             }
             q *= (long double)(p-prime_offset);
-            const long double term = ln_small_upto99(tenting?cap_tent(n, p, r):(p-r)) / (use_short_interval ? q : q*q);
+            const long double term = lnterm / (use_short_interval ? q : q*q);
             tailfactor += term;
             if (term < 1e-14L) {
                 break;
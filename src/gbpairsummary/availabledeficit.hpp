@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 
 /**
  * @brief C++ wrapper class for prime curvature geometry deficit calculations
@@ -192,6 +193,36 @@ private:
     int exposure_count;               ///< Maximum number of tail exposure passes (typically 5-20)
     long double tailfactor = 0.0L;   ///< Accumulated tail(δ,n) = Σ log(p-r) / (R_i^{(s)})²
 
+    /**
+     * \subsection Precomputed residue tables
+     *
+     * Every per-prime term above depends on n only through n mod p (the
+     * divisibility reduction and the tenting phase), and the fence index
+     * depends only on w_int and on whether 3|n.  So the term logs are
+     * precomputed per prime residue on first use, the first few committed
+     * levels (3·5·7·11·13) collapse into one table indexed by n mod their
+     * primorial, and the committed products R_k are tabulated per start
+     * prime.  Evaluation then costs one primorial residue, a handful of
+     * table loads, and the unchanged tail recurrence - bitwise identical
+     * to the loop path, which remains as the fallback for configurations
+     * where a residue count can reach zero (those change the fence shape
+     * per n and are not table-indexable).
+     */
+    static const std::size_t kCumLowLevels = 5;  ///< Combined-table levels: primes 3,5,7,11,13
+    bool tabs_built = false;          ///< Residue tables attempted (lazy, first call)
+    bool tabs_usable = false;         ///< Residue tables valid for this configuration
+    std::vector<std::size_t> tab_off; ///< Flattened per-prime table offsets
+    std::vector<long double> base_tab;///< Per-prime base term logs, indexed by n mod p
+    std::vector<long double> tail_tab;///< Per-prime tail term logs, indexed by n mod p
+    std::vector<std::uint64_t> prodq[2];                      ///< Committed products per start index
+    std::vector<long double> cum_low[2][kCumLowLevels + 1];   ///< Combined base sums per (start, level)
+    std::uint64_t cum_low_mod[2][kCumLowLevels + 1] = {};     ///< Primorial modulus per (start, level)
+
+    /**
+     * @brief Builds the residue tables for this parameter configuration
+     */
+    void build_tables();
+
     /**
      * @brief Internal implementation of R(δ,n) calculation
      * 
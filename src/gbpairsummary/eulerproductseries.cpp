@@ -19,8 +19,75 @@
 #include "eulerproductseries.hpp"
 
 #include <cstdio>
+#include "gbcheckpoint.hpp"
 #include <limits>
 
+// One table per process: every series built over the same prime array shares
+// the memoized prefixes, so ~80 windows no longer recompute the same
+// PROD (p-2)/(p-1) products independently.
+static EulerProductTable g_product_table;
+
+void EulerProductTable::init(std::uint64_t * const prime_left, const std::uint64_t * const prime_end)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (prime_left_ == prime_left && prime_end_ == prime_end) {
+        return; // same array; keep what has been built so far
+    }
+    prime_left_ = prime_left;
+    prime_end_ = prime_end;
+    samples_.clear();
+    built_ = 0;
+    plateau_ = false;
+}
+
+bool EulerProductTable::lookup(std::uint64_t n, const std::uint64_t * const prime_left, std::size_t &m, long double &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!prime_left_ || prime_left != prime_left_) {
+        return false;
+    }
+    const std::size_t avail = (std::size_t)(prime_end_ - prime_left_);
+    // Append-only extension: fold the next STRIDE primes while the chunk's
+    // last prime p still satisfies p^2 <= n (overflow-safe as p <= n/p).
+    while (!plateau_ && built_ + STRIDE <= avail) {
+        const std::uint64_t p_last = prime_left_[built_ + STRIDE - 1];
+        if (p_last > n / p_last) {
+            break;
+        }
+        long double prod = samples_.empty() ? 1.0L : samples_.back();
+        for (std::size_t i = built_; i < built_ + STRIDE; ++i) {
+            const long double pm1 = (long double)(prime_left_[i] - 1);
+            const long double next = prod * ((pm1 - 1.0L) / pm1);
+            if (next == prod) {
+                // Later factors are even closer to 1, so the product has
+                // converged at long double precision for good.
+                plateau_ = true;
+                break;
+            }
+            prod = next;
+        }
+        built_ += STRIDE;
+        samples_.push_back(prod);
+    }
+    // Deepest sample whose last folded prime squared is still <= n.
+    std::size_t lo = 0, hi = samples_.size();
+    while (lo < hi) {
+        const std::size_t mid = (lo + hi + 1) / 2;
+        const std::uint64_t p = prime_left_[mid * STRIDE - 1];
+        if (p <= n / p) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (lo == 0) {
+        return false;
+    }
+    m = lo * STRIDE;
+    result = samples_[lo - 1];
+    return true;
+}
+
 EulerProductSeries::EulerProductSeries() {}
 
 EulerProductSeries::EulerProductSeries(std::uint64_t* const primeArray, const std::uint64_t* const primeArrayEndend) {
@@ -46,9 +113,44 @@ void EulerProductSeries::init(std::uint64_t* const primeArray, const std::uint64
     if (! prime_left) {
         std::fprintf(stderr, "Invalid prime array.\n");
     }
+    else {
+        g_product_table.init(prime_left, prime_end);
+    }
     reset();
 }
 
+// Repositions via the shared memoized table: lands on the deepest sampled
+// prefix still valid for n and leaves the short tail (< STRIDE primes) to
+// the caller's advance loop.  Backward jumps without table coverage fall
+// back to the old from-scratch reset().
+void EulerProductSeries::seek(std::uint64_t n) {
+    std::size_t m = 0;
+    long double res = 1.0L;
+    if (!prime_left || !g_product_table.lookup(n, prime_left, m, res)) {
+        if (n < n_left) {
+            reset();
+        }
+        return;
+    }
+    if (n >= n_left && prime_ptr >= prime_left + m) {
+        return; // already at or past the sampled prefix; keep walking
+    }
+    warned_out = false;
+    result = res;
+    prime_ptr = prime_left + m;
+    n_left = prime_ptr[-1] * prime_ptr[-1]; // p^2 <= n guaranteed by lookup
+    if (prime_ptr >= prime_end) {
+        y_next = n_right = std::numeric_limits<std::uint64_t>::max();
+        return;
+    }
+    y_next = *prime_ptr;
+    if (y_next > std::numeric_limits<std::uint64_t>::max() / y_next) {
+        y_next = n_right = std::numeric_limits<std::uint64_t>::max();
+    } else {
+        n_right = y_next * y_next - 1;
+    }
+}
+
 
 void EulerProductSeries::reset() {
     warned_out = false;
@@ -99,3 +201,71 @@ void EulerProductSeries::advance_interval() {
     }
 }
 
+
+// Crosses every interval up to n in one step: all remaining primes p with
+// p^2 <= n are folded with the blocked (p-2)/(p-1) form, then the interval
+// bounds are rebuilt from the cursor the same way seek() does.  Only called
+// for jumps spanning >= BULK_MIN primes; the per-interval stepper keeps the
+// plateau short-circuit for the incremental case.
+void EulerProductSeries::advance_bulk(std::uint64_t n) {
+    // Largest count with prime_ptr[count-1]^2 <= n (overflow-safe as
+    // p <= n/p), found by binary search over the sorted tail.
+    std::size_t lo = 0, hi = (std::size_t)(prime_end - prime_ptr);
+    while (lo < hi) {
+        const std::size_t mid = (lo + hi + 1) / 2;
+        const std::uint64_t p = prime_ptr[mid - 1];
+        if (p <= n / p) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (lo == 0) {
+        return;
+    }
+    result *= eulerBlockFold<EulerPairForm>(prime_ptr, lo);
+    prime_ptr += lo;
+    n_left = prime_ptr[-1] * prime_ptr[-1];
+    if (prime_ptr >= prime_end) {
+        if (!warned_out) {
+            std::fprintf(stderr,
+                "EulerProductSeries: need a prime > %" PRIu64 " for next p^2 threshold\n",
+                prime_ptr[-1]);
+            warned_out = true;
+        }
+        y_next = n_right = std::numeric_limits<std::uint64_t>::max();
+        return;
+    }
+    y_next = *prime_ptr;
+    if (y_next > std::numeric_limits<std::uint64_t>::max() / y_next) {
+        y_next = n_right = std::numeric_limits<std::uint64_t>::max();
+    } else {
+        n_right = y_next * y_next - 1;
+    }
+}
+
+int EulerProductSeries::checkpointWrite(std::FILE *f) const {
+    int rc = 0;
+    const std::uint64_t idx = prime_ptr
+        ? (std::uint64_t)(prime_ptr - prime_left) : ~0ULL;
+    rc |= gbCkPut(f, idx);
+    rc |= gbCkPut(f, n_left);
+    rc |= gbCkPut(f, n_right);
+    rc |= gbCkPut(f, y_next);
+    rc |= gbCkPut(f, result);
+    rc |= gbCkPut(f, warned_out);
+    return rc;
+}
+
+int EulerProductSeries::checkpointRead(std::FILE *f) {
+    int rc = 0;
+    std::uint64_t idx = ~0ULL;
+    rc |= gbCkGet(f, idx);
+    rc |= gbCkGet(f, n_left);
+    rc |= gbCkGet(f, n_right);
+    rc |= gbCkGet(f, y_next);
+    rc |= gbCkGet(f, result);
+    rc |= gbCkGet(f, warned_out);
+    prime_ptr = (idx == ~0ULL) ? nullptr : prime_left + idx;
+    return rc;
+}
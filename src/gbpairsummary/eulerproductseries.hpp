@@ -19,6 +19,86 @@
 #define EULER_PRODUCT_SERIES_HPP 1
 #include <cstdint>
 #include <cinttypes>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+// Per-prime factor forms for the blocked folder below, selected at compile
+// time so each consumer keeps its historical per-factor rounding.  The two
+// expressions are algebraically the same number but round differently in
+// long double:
+//   EulerPairForm: (p-2)/(p-1) evaluated as (pm1 - 1)/pm1  (this series)
+//   EulerCpsForm:  1 - 1/(p-1)                             (cpslowerbound's
+//                  lower-bound series; its C kernel keeps its own loop, the
+//                  form is here for C++ consumers of that series)
+struct EulerPairForm {
+    static long double factor(std::uint64_t p) {
+        const long double pm1 = (long double)(p - 1);
+        return (pm1 - 1.0L) / pm1;
+    }
+};
+
+struct EulerCpsForm {
+    static long double factor(std::uint64_t p) {
+        return 1.0L - 1.0L / (long double)(p - 1);
+    }
+};
+
+// Folds factor(p) over primes[0..count) into LANES independent partial
+// products and combines them at the end.  A single running product is a
+// loop-carried FPU dependency (one multiply per fdiv/fmul latency); with
+// independent lanes the multiplies pipeline, which is what matters when a
+// window jumps (alpha change, resume) and thousands of factors must be
+// crossed at once.  The combined product can differ from the sequential
+// fold in the last ulp; callers print well inside long double precision.
+template<class FORM, unsigned LANES = 4>
+static inline long double eulerBlockFold(const std::uint64_t *primes, std::size_t count) {
+    long double acc[LANES];
+    for (unsigned l = 0; l < LANES; ++l) {
+        acc[l] = 1.0L;
+    }
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        for (unsigned l = 0; l < LANES; ++l) {
+            acc[l] *= FORM::factor(primes[i + l]);
+        }
+    }
+    for (; i < count; ++i) {
+        acc[0] *= FORM::factor(primes[i]);
+    }
+    long double prod = acc[0];
+    for (unsigned l = 1; l < LANES; ++l) {
+        prod *= acc[l];
+    }
+    return prod;
+}
+
+// Process-wide memoized prefix products shared by every series instance.
+// samples_[k-1] holds PROD (p-2)/(p-1) over the first k*STRIDE odd primes,
+// appended lazily under a mutex, so each prefix is computed once no matter
+// how many windows own a series or how often one restarts.  Out-of-order
+// queries then cost a table lookup plus at most a STRIDE-length tail walk.
+class EulerProductTable {
+public:
+    static constexpr std::size_t STRIDE = 64;
+
+    void init(std::uint64_t * const prime_left, const std::uint64_t * const prime_end);
+
+    // Finds the deepest sampled prefix whose last folded prime p still has
+    // p^2 <= n, extending the table as needed.  On success sets m (odd
+    // primes consumed) and result and returns true; returns false when the
+    // caller's array is not the registered one or n precedes the first
+    // sample, in which case the series falls back to a plain walk.
+    bool lookup(std::uint64_t n, const std::uint64_t * const prime_left, std::size_t &m, long double &result);
+
+private:
+    std::mutex mutex_;
+    std::vector<long double> samples_;
+    std::uint64_t *prime_left_ = nullptr;
+    const std::uint64_t *prime_end_ = nullptr;
+    std::size_t built_ = 0;   // odd primes folded into the deepest sample
+    bool plateau_ = false;    // product stopped changing at long double precision
+};
 
 class EulerProductSeries {
 public:
@@ -30,10 +110,20 @@ public:
 
     void reset();
 
+    // --checkpoint: persist/restore the cached interval and cursor.  The
+    // cursor is stored as an index into the registered prime array, so
+    // restore requires init() to have been called first with the same
+    // array.
+    int checkpointWrite(std::FILE *f) const;
+    int checkpointRead(std::FILE *f);
+
     // Product over odd primes p with p^2 <= n: PROD (p-2)/(p-1)
     long double operator()(std::uint64_t n) {
-        if (n < n_left) {
-            reset();
+        if (n < n_left || n > n_right) {
+            seek(n);
+        }
+        if (n > n_right && spans_block(n)) {
+            advance_bulk(n); // blocked catch-up for multi-interval jumps
         }
         while (n > n_right) {
             advance_interval();
@@ -53,6 +143,21 @@ private:
     bool warned_out = true; // indicates if we have warned about running out of primes
 
     void advance_interval();
+    void seek(std::uint64_t n);
+
+    // O(1) gate for the blocked catch-up: true when at least BULK_MIN
+    // primes from the cursor still satisfy p^2 <= n, so the binary search
+    // and lane setup in advance_bulk() pay for themselves.  The common
+    // one-interval step stays on advance_interval().
+    static constexpr std::size_t BULK_MIN = 32;
+    bool spans_block(std::uint64_t n) const {
+        if (!prime_ptr || prime_ptr + BULK_MIN > prime_end) {
+            return false;
+        }
+        const std::uint64_t p = prime_ptr[BULK_MIN - 1];
+        return p <= n / p;
+    }
+    void advance_bulk(std::uint64_t n);
 };
 
 #endif // EULER_PRODUCT_SERIES_HPP
@@ -19,3 +19,66 @@
 #include "gbaggregate.hpp"
 
 GBAggregate::GBAggregate() {}
+
+// --checkpoint serialization.  The HLCorrState calculators are flat
+// scalar structs and are dumped as raw bytes; the label travels as a
+// length-prefixed string.
+int GBAggregate::checkpointWrite(std::FILE *f) const {
+    int rc = 0;
+    const std::uint64_t label_len = label.size();
+    rc |= gbCkPut(f, label_len);
+    if (label_len) {
+        rc |= gbCkWrite(f, label.data(), label_len);
+    }
+    rc |= gbCkPut(f, left);
+    rc |= gbCkPut(f, right);
+    rc |= gbCkPut(f, n_start);
+    rc |= gbCkPut(f, n_end);
+    rc |= gbCkPut(f, base);
+    rc |= gbCkPut(f, n_geom);
+    rc |= gbCkPut(f, oddCalc);
+    rc |= gbCkPut(f, evenCalc);
+    rc |= gbCkPut(f, minCalc);
+    rc |= gbCkPut(f, maxCalc);
+    rc |= gbCkPut(f, minNormCalc);
+    rc |= gbCkPut(f, maxNormCalc);
+    rc |= gbCkPut(f, alignNormMinCalc);
+    rc |= gbCkPut(f, alignNormMaxCalc);
+    rc |= gbCkPut(f, boundNormMinCalc);
+    rc |= gbCkPut(f, boundNormMaxCalc);
+    rc |= gbCkPut(f, boundDeltaMinNormCalc);
+    rc |= gbCkPut(f, boundDeltaMaxNormCalc);
+    return rc;
+}
+
+int GBAggregate::checkpointRead(std::FILE *f) {
+    int rc = 0;
+    std::uint64_t label_len = 0;
+    rc |= gbCkGet(f, label_len);
+    if (rc) {
+        return rc;
+    }
+    label.resize(label_len);
+    if (label_len) {
+        rc |= gbCkRead(f, &label[0], label_len);
+    }
+    rc |= gbCkGet(f, left);
+    rc |= gbCkGet(f, right);
+    rc |= gbCkGet(f, n_start);
+    rc |= gbCkGet(f, n_end);
+    rc |= gbCkGet(f, base);
+    rc |= gbCkGet(f, n_geom);
+    rc |= gbCkGet(f, oddCalc);
+    rc |= gbCkGet(f, evenCalc);
+    rc |= gbCkGet(f, minCalc);
+    rc |= gbCkGet(f, maxCalc);
+    rc |= gbCkGet(f, minNormCalc);
+    rc |= gbCkGet(f, maxNormCalc);
+    rc |= gbCkGet(f, alignNormMinCalc);
+    rc |= gbCkGet(f, alignNormMaxCalc);
+    rc |= gbCkGet(f, boundNormMinCalc);
+    rc |= gbCkGet(f, boundNormMaxCalc);
+    rc |= gbCkGet(f, boundDeltaMinNormCalc);
+    rc |= gbCkGet(f, boundDeltaMaxNormCalc);
+    return rc;
+}
@@ -41,6 +41,13 @@ public:
     GBAggregate();
 
     virtual void reset(std::uint64_t &n_start,bool useLegacy) = 0;
+
+    // --checkpoint: persist/restore the interval bounds, label and the
+    // HLCorr calculators.  Subclasses append their own stepping state.
+    virtual int checkpointWrite(std::FILE *f) const;
+    virtual int checkpointRead(std::FILE *f);
+
+    virtual ~GBAggregate() = default;
 };
 
 #endif // GB_AGGREGATE_HPP
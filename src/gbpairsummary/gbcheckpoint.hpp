@@ -0,0 +1,53 @@
+// gbcheckpoint - binary checkpoint primitives for decade-granular restart
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef GB_CHECKPOINT_HPP
+#define GB_CHECKPOINT_HPP 1
+
+#include <cstdio>
+#include <cstddef>
+
+// --checkpoint/--checkpoint-resume: engine state is dumped as raw in-memory
+// bytes (native endian, x87 long doubles included) so a resumed shard
+// continues bit-exactly.  A checkpoint is therefore only portable between
+// builds on the same architecture, which is what the shard schedulers
+// guarantee anyway.  Each class serializes its own fields in declaration
+// order; helpers return 0 on success, nonzero on a short read/write, and
+// are safe to chain with |= since stdio latches the error state.
+
+#define GB_CHECKPOINT_MAGIC "GBCKPT00"
+#define GB_CHECKPOINT_MAGIC_BYTES 8
+
+static inline int gbCkWrite(std::FILE *f, const void *p, std::size_t len) {
+    return std::fwrite(p, 1, len, f) == len ? 0 : -1;
+}
+
+static inline int gbCkRead(std::FILE *f, void *p, std::size_t len) {
+    return std::fread(p, 1, len, f) == len ? 0 : -1;
+}
+
+template<typename T>
+static inline int gbCkPut(std::FILE *f, const T &v) {
+    return gbCkWrite(f, &v, sizeof v);
+}
+
+template<typename T>
+static inline int gbCkGet(std::FILE *f, T &v) {
+    return gbCkRead(f, &v, sizeof v);
+}
+
+#endif // GB_CHECKPOINT_HPP
@@ -57,3 +57,17 @@ void GBDecade::reset(std::uint64_t &n_start,bool useLegacy) {
     label = std::string(buf);
 }
 
+
+int GBDecade::checkpointWrite(std::FILE *f) const {
+    int rc = GBAggregate::checkpointWrite(f);
+    rc |= gbCkPut(f, decade);
+    rc |= gbCkPut(f, threshold);
+    return rc;
+}
+
+int GBDecade::checkpointRead(std::FILE *f) {
+    int rc = GBAggregate::checkpointRead(f);
+    rc |= gbCkGet(f, decade);
+    rc |= gbCkGet(f, threshold);
+    return rc;
+}
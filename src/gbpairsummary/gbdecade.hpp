@@ -30,6 +30,9 @@ public:
     GBDecade();
 
     void reset(std::uint64_t &n_start,bool useLegacy) override;
+
+    int checkpointWrite(std::FILE *f) const override;
+    int checkpointRead(std::FILE *f) override;
 };
 
 #endif // GB_DECADE_HPP
@@ -20,8 +20,82 @@
 
 #include <math.h>
 
+#include <string>
+
+#include "gbcheckpoint.hpp"
 #include "gblongintervalsummary.hpp"
 
+// --rle-eps: one pending run of collapsed raw/norm rows.  The run keeps
+// the first row's label, locations and values as the representative;
+// later rows only extend [first,last] and bump repeat while every value
+// column stays within epsilon of the representative.  Both streams share
+// the same nine-column row shape, so one struct covers both: nA/vA is
+// minAt/G(minAt) for raw and n_0/C_min(n_0) for norm, nB/vB likewise.
+class GBRleRun {
+public:
+    bool pending = false;
+    std::uint64_t first = 0;
+    std::uint64_t last = 0;
+    std::uint64_t repeat = 0;
+    std::string label;
+    std::uint64_t nA = 0;
+    long double vA = 0.0L;
+    std::uint64_t nB = 0;
+    long double vB = 0.0L;
+    long double n_geom = 0.0L;
+    long double avg = 0.0L;
+
+    // A pending run is output state the flushed files do not cover yet,
+    // so it rides along in the decade checkpoint when --rle-eps is on.
+    int checkpointWrite(std::FILE *f) const {
+        int rc = 0;
+        const std::uint8_t pend = pending ? 1 : 0;
+        rc |= gbCkPut(f, pend);
+        rc |= gbCkPut(f, first);
+        rc |= gbCkPut(f, last);
+        rc |= gbCkPut(f, repeat);
+        rc |= gbCkPut(f, nA);
+        rc |= gbCkPut(f, vA);
+        rc |= gbCkPut(f, nB);
+        rc |= gbCkPut(f, vB);
+        rc |= gbCkPut(f, n_geom);
+        rc |= gbCkPut(f, avg);
+        const std::uint64_t len = label.size();
+        rc |= gbCkPut(f, len);
+        if (len) {
+            rc |= gbCkWrite(f, label.data(), len);
+        }
+        return rc;
+    }
+
+    int checkpointRead(std::FILE *f) {
+        int rc = 0;
+        std::uint8_t pend = 0;
+        rc |= gbCkGet(f, pend);
+        pending = (pend != 0);
+        rc |= gbCkGet(f, first);
+        rc |= gbCkGet(f, last);
+        rc |= gbCkGet(f, repeat);
+        rc |= gbCkGet(f, nA);
+        rc |= gbCkGet(f, vA);
+        rc |= gbCkGet(f, nB);
+        rc |= gbCkGet(f, vB);
+        rc |= gbCkGet(f, n_geom);
+        rc |= gbCkGet(f, avg);
+        std::uint64_t len = 0;
+        rc |= gbCkGet(f, len);
+        if (rc != 0 || len > 256) {
+            std::fprintf(stderr, "checkpoint: rle run label length invalid\n");
+            return -1;
+        }
+        label.assign(len, '\0');
+        if (len) {
+            rc |= gbCkRead(f, &label[0], len);
+        }
+        return rc;
+    }
+};
+
 class GBLongInterval {
 public:
     int active = -1;
@@ -34,8 +108,11 @@ public:
     FILE *norm = nullptr;
     FILE *trace = nullptr;
     FILE *cps = nullptr;
+    FILE *cps_summary = nullptr;  // per-window cps summary (multi-alpha runs)
     FILE *boundRatioMin = nullptr;  // v0.2.0: bound ratio minimum output
     FILE *boundRatioMax = nullptr;   // v0.2.0: bound ratio maximum output
+    GBRleRun rawRle;   // --rle-eps: pending run on the raw stream
+    GBRleRun normRle;  // --rle-eps: pending run on the norm stream
     GBLongIntervalSummary summary = GBLongIntervalSummary();
 };
 
@@ -45,6 +45,7 @@ void GBLongIntervalSummary::outputCps(
     if(! interval.cps) {
         return;
     }
+    flushAggregates();
     // trivial sorting of 6 values
     // substituting a 0 for repeats, so a bubble sort is sufficient to detect repeats
     uint64_t a = cMinima.n_first, b = cMinima.n_last, c = n2First, d = n2Last, e = n3First, f = n3Last;
@@ -120,7 +121,7 @@ static inline long double getRatio(const long double c_meas, const long double c
     static const long double epsilon = 2e-8L;
     
     // Values are equal if: difference is within absolute tolerance OR within relative tolerance
-    if (std::fabsl(c_meas - current) <= epsilon) {
+    if (fabsl(c_meas - current) <= epsilon) {
         return 1.0L;
     }
     else if (current != 0.0L) {
@@ -404,7 +405,7 @@ void GBLongIntervalSummary::outputCpsLine(
         deltaC = cMinima.c_first - cminus_of_n0First;
         deltaCAsymp = cMinima.c_first - cminusAsymp_of_n0First;
         if(decade < 0) {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF,%s,%s,%0.12LF\n",
                 cMinima.n_first,cMinima.c_first,cminus_of_n0First,deltaC,
                 cminusAsymp_of_n0First,deltaCAsymp,
@@ -412,7 +413,7 @@ void GBLongIntervalSummary::outputCpsLine(
                 alpha_n);
         }
         else {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%d,%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF\n",
                 decade,cMinima.n_first,cMinima.c_first,cminus_of_n0First,deltaC,
                 cminusAsymp_of_n0First,deltaCAsymp
@@ -423,7 +424,7 @@ void GBLongIntervalSummary::outputCpsLine(
         deltaC = cMinima.c_last - cminus_of_n0Last;
         deltaCAsymp = cMinima.c_last - cminusAsymp_of_n0Last;
         if(decade < 0) {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF,%s,%s,%0.12LF\n",
                 cMinima.n_last,cMinima.c_last,cminus_of_n0Last,deltaC,
                 cminusAsymp_of_n0Last,deltaCAsymp,
@@ -431,7 +432,7 @@ void GBLongIntervalSummary::outputCpsLine(
                 alpha_n);
         }
         else {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%d,%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF\n",
                 decade,cMinima.n_last,cMinima.c_last,cminus_of_n0Last,deltaC,
                 cminusAsymp_of_n0Last,deltaCAsymp
@@ -442,7 +443,7 @@ void GBLongIntervalSummary::outputCpsLine(
         deltaC = c_of_n2First - cminus_of_n2First;
         deltaCAsymp = c_of_n2First - cminusAsymp_of_n2First;
         if(decade < 0) {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF,%s,%s,%0.12LF\n",
                 n2First,c_of_n2First,cminus_of_n2First,deltaC,
                 cminusAsymp_of_n2First,deltaCAsymp,
@@ -455,7 +456,7 @@ void GBLongIntervalSummary::outputCpsLine(
         deltaC = c_of_n2Last - cminus_of_n2Last;
         deltaCAsymp = c_of_n2Last - cminusAsymp_of_n2Last;
         if(decade < 0) {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF,%s,%s,%0.12LF\n",
                 n2Last,c_of_n2Last,cminus_of_n2Last,deltaC,
                 cminusAsymp_of_n2Last,deltaCAsymp,
@@ -468,7 +469,7 @@ void GBLongIntervalSummary::outputCpsLine(
         deltaC = c_of_n3First - cminus_of_n3First;
         deltaCAsymp = c_of_n3First - cminusAsymp_of_n3First;
         if(decade < 0) {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF,%s,%s,%0.12LF\n",
                 n3First,c_of_n3First,cminus_of_n3First,deltaC,
                 cminusAsymp_of_n3First,deltaCAsymp,
@@ -481,7 +482,7 @@ void GBLongIntervalSummary::outputCpsLine(
         deltaC = c_of_n3Last - cminus_of_n3Last;
         deltaCAsymp = c_of_n3Last - cminusAsymp_of_n3Last;
         if(decade < 0) {
-            std::fprintf(interval.cps,
+            gbOutPrintf(interval.cps,
                 "%" PRIu64 ",%0.6LF,%0.6LF,%0.6LF,%0.6LF,%0.6LF,%s,%s,%0.12LF\n",
                 n3Last,c_of_n3Last,cminus_of_n3Last,deltaC,
                 cminusAsymp_of_n3Last,deltaCAsymp,
@@ -515,6 +516,7 @@ void GBLongIntervalSummary::outputBoundRatioMin(GBLongInterval &interval) {
     if(! interval.boundRatioMin || boundRatioMinima.n_first == 0) {
         return;
     }
+    flushAggregates();
     // TODO: This function already includes both ratio and lambda - good example to follow for other outputs
     long double ratio = boundRatioMinima.getFirstRatio();
     long double lambda = boundRatioMinima.getLambda();
@@ -548,7 +550,7 @@ void GBLongIntervalSummary::outputBoundRatioMin(GBLongInterval &interval) {
         std::snprintf(baseline_buf, sizeof(baseline_buf), "%.8Lf", baseline);
     }
     
-    std::fprintf(interval.boundRatioMin,
+    gbOutPrintf(interval.boundRatioMin,
         "%" PRIu64 ",%s,%s,%s,%.8Lf,%s,%s\n",
         boundRatioMinima.n_first,
         ratio_buf,
@@ -564,6 +566,7 @@ void GBLongIntervalSummary::outputBoundRatioMax(GBLongInterval &interval) {
     if(! interval.boundRatioMax || boundRatioMaxima.n_first == 0) {
         return;
     }
+    flushAggregates();
     // TODO: This function already includes both ratio and lambda - good example to follow for other outputs
     long double ratio = boundRatioMaxima.getFirstRatio();
     long double lambda = boundRatioMaxima.getLambda();
@@ -597,7 +600,7 @@ void GBLongIntervalSummary::outputBoundRatioMax(GBLongInterval &interval) {
         std::snprintf(baseline_buf, sizeof(baseline_buf), "%.8Lf", baseline);
     }
     
-    std::fprintf(interval.boundRatioMax,
+    gbOutPrintf(interval.boundRatioMax,
         "%" PRIu64 ",%s,%s,%s,%.8Lf,%s,%s\n",
         boundRatioMaxima.n_first,
         ratio_buf,
@@ -609,3 +612,105 @@ void GBLongIntervalSummary::outputBoundRatioMax(GBLongInterval &interval) {
     );
 }
 
+
+// --checkpoint serialization.  ExtremaValues and the scalar members are
+// trivially copyable, so each field is dumped as raw bytes; the order here
+// is the restore contract and must not change without bumping the
+// checkpoint magic.
+int GBLongIntervalSummary::checkpointWrite(std::FILE *f) {
+    flushAggregates();
+    int rc = 0;
+    rc |= gbCkPut(f, useHLCorrInst);
+    rc |= gbCkPut(f, pairCount);
+    rc |= gbCkPut(f, c_of_n);
+    rc |= gbCkPut(f, pairCountMinima);
+    rc |= gbCkPut(f, pairCountMaxima);
+    rc |= gbCkPut(f, pairCountAlignMaxima);
+    rc |= gbCkPut(f, alignMinima);
+    rc |= gbCkPut(f, alignMaxima);
+    rc |= gbCkPut(f, boundMinima);
+    rc |= gbCkPut(f, boundMaxima);
+    rc |= gbCkPut(f, boundRatioMinima);
+    rc |= gbCkPut(f, boundRatioMaxima);
+    rc |= gbCkPut(f, cMinima);
+    rc |= gbCkPut(f, cMaxima);
+    rc |= gbCkPut(f, cminus_of_n0First);
+    rc |= gbCkPut(f, cminusAsymp_of_n0First);
+    rc |= gbCkPut(f, cminus_of_n0Last);
+    rc |= gbCkPut(f, cminusAsymp_of_n0Last);
+    rc |= gbCkPut(f, pairCountTotal);
+    rc |= gbCkPut(f, pairCountTotalNorm);
+    rc |= gbCkPut(f, pairCountAvg);
+    rc |= gbCkPut(f, c_of_n2First);
+    rc |= gbCkPut(f, c_of_n2Last);
+    rc |= gbCkPut(f, cminus_of_n2First);
+    rc |= gbCkPut(f, cminus_of_n2Last);
+    rc |= gbCkPut(f, cminusAsymp_of_n2First);
+    rc |= gbCkPut(f, cminusAsymp_of_n2Last);
+    rc |= gbCkPut(f, c_of_n3First);
+    rc |= gbCkPut(f, c_of_n3Last);
+    rc |= gbCkPut(f, cminus_of_n3First);
+    rc |= gbCkPut(f, cminus_of_n3Last);
+    rc |= gbCkPut(f, cminusAsymp_of_n3First);
+    rc |= gbCkPut(f, cminusAsymp_of_n3Last);
+    rc |= gbCkPut(f, cAvg);
+    rc |= gbCkPut(f, hlCorrAvg);
+    rc |= gbCkPut(f, currentJitter);
+    rc |= gbCkPut(f, n2First);
+    rc |= gbCkPut(f, n2Last);
+    rc |= gbCkPut(f, n3First);
+    rc |= gbCkPut(f, n3Last);
+    rc |= gbCkPut(f, pairCountTotalComp);
+    rc |= gbCkPut(f, pairCountTotalNormComp);
+    rc |= hlCorrEstimate.checkpointWrite(f);
+    return rc;
+}
+
+int GBLongIntervalSummary::checkpointRead(std::FILE *f) {
+    batchLen_ = 0;
+    int rc = 0;
+    rc |= gbCkGet(f, useHLCorrInst);
+    rc |= gbCkGet(f, pairCount);
+    rc |= gbCkGet(f, c_of_n);
+    rc |= gbCkGet(f, pairCountMinima);
+    rc |= gbCkGet(f, pairCountMaxima);
+    rc |= gbCkGet(f, pairCountAlignMaxima);
+    rc |= gbCkGet(f, alignMinima);
+    rc |= gbCkGet(f, alignMaxima);
+    rc |= gbCkGet(f, boundMinima);
+    rc |= gbCkGet(f, boundMaxima);
+    rc |= gbCkGet(f, boundRatioMinima);
+    rc |= gbCkGet(f, boundRatioMaxima);
+    rc |= gbCkGet(f, cMinima);
+    rc |= gbCkGet(f, cMaxima);
+    rc |= gbCkGet(f, cminus_of_n0First);
+    rc |= gbCkGet(f, cminusAsymp_of_n0First);
+    rc |= gbCkGet(f, cminus_of_n0Last);
+    rc |= gbCkGet(f, cminusAsymp_of_n0Last);
+    rc |= gbCkGet(f, pairCountTotal);
+    rc |= gbCkGet(f, pairCountTotalNorm);
+    rc |= gbCkGet(f, pairCountAvg);
+    rc |= gbCkGet(f, c_of_n2First);
+    rc |= gbCkGet(f, c_of_n2Last);
+    rc |= gbCkGet(f, cminus_of_n2First);
+    rc |= gbCkGet(f, cminus_of_n2Last);
+    rc |= gbCkGet(f, cminusAsymp_of_n2First);
+    rc |= gbCkGet(f, cminusAsymp_of_n2Last);
+    rc |= gbCkGet(f, c_of_n3First);
+    rc |= gbCkGet(f, c_of_n3Last);
+    rc |= gbCkGet(f, cminus_of_n3First);
+    rc |= gbCkGet(f, cminus_of_n3Last);
+    rc |= gbCkGet(f, cminusAsymp_of_n3First);
+    rc |= gbCkGet(f, cminusAsymp_of_n3Last);
+    rc |= gbCkGet(f, cAvg);
+    rc |= gbCkGet(f, hlCorrAvg);
+    rc |= gbCkGet(f, currentJitter);
+    rc |= gbCkGet(f, n2First);
+    rc |= gbCkGet(f, n2Last);
+    rc |= gbCkGet(f, n3First);
+    rc |= gbCkGet(f, n3Last);
+    rc |= gbCkGet(f, pairCountTotalComp);
+    rc |= gbCkGet(f, pairCountTotalNormComp);
+    rc |= hlCorrEstimate.checkpointRead(f);
+    return rc;
+}
@@ -102,7 +102,7 @@ public:
             return -LDBL_MAX;  // Negative sentinel
         }
         // ratio > 0: lambda = logl(ratio) (sign comes from log function)
-        return std::logl(ratio);
+        return logl(ratio);
     }
     
     // Get bound status for maximum bound (measured should be <= predicted)
@@ -173,9 +173,29 @@ private:
     void copyLastToFirst();  // Copy all last values to first (including extra_last to extra_first)
 };
 
+// One staged aggregation row: everything aggregate() reads that changes
+// per n, captured at call time so a block of consecutive rows can be
+// replayed later.  pcAdd/cnAdd carry the (HLCorr-corrected) addends for
+// the running totals, so the totals pass over a block is a plain sum.
+struct GBAggRow {
+    std::uint64_t n;
+    std::uint64_t delta;
+    long double cminus;
+    long double cminusAsymp;
+    long double pairCount;
+    long double c_of_n;
+    long double hlCorr;
+    long double pcAdd;
+    long double cnAdd;
+};
+
 class GBLongIntervalSummary {
 public:
     bool useHLCorrInst = false;
+    // PSI stream: the interval totals come from the GBPSI prefix store
+    // (see gbpsi.hpp), so the replay skips the running sums.  Set once
+    // when the store is wired and deliberately left alone by reset().
+    bool usePrefixTotals = false;
     long double pairCount = 0.0L;
     long double c_of_n = 0.0L;
     ExtremaValues pairCountMinima;
@@ -226,6 +246,11 @@ public:
 
     void reset() {
         GBLongIntervalSummary temp;
+        // Staged rows belong to the interval being closed; its readers
+        // have already flushed, so just drop the block and the carries.
+        batchLen_ = 0;
+        pairCountTotalComp = temp.pairCountTotalComp;
+        pairCountTotalNormComp = temp.pairCountTotalNormComp;
         // Copy all non-reference members manually since references can't be reassigned
         useHLCorrInst = temp.useHLCorrInst;
         pairCount = temp.pairCount;
@@ -278,57 +303,118 @@ public:
         long double cminusAsymp,
         bool useHLCorr
     ) {
-        // Store the current hlCorrAvg value that's embedded in the data
-        pairCountMaxima.putMaxima(pairCount, 0.0L, n, delta, hlCorrAvg);
-        cMinima.putMinima(c_of_n, 0.0L, n, delta, hlCorrAvg);
-        cMaxima.putMaxima(c_of_n, 0.0L, n, delta, hlCorrAvg);
-        // Conservative bound: use raw values without HLCorr
-        if (useHLCorrInst && useHLCorr && hlCorrAvg != 0.0L) {
-            pairCountTotal     += pairCount     / hlCorrAvg;
-            pairCountTotalNorm += c_of_n / hlCorrAvg;
-            hlCorrAvg = 1.0L;
-        } else {
-            pairCountTotal     += pairCount;
-            pairCountTotalNorm += c_of_n;
-        }
+        // The jitter stamps must see this row's alignMinima state (the
+        // caller updated it just before us), so they cannot be deferred.
         if(n == alignMinima.n_last) {
             jitterLast = currentJitter;
         }
         if(n == alignMinima.n_first) {
             jitterFirst = currentJitter;
         }
-        if(n == cMinima.n_last) {
-            if(n == cMinima.n_first) {
-                cminus_of_n0First = cminus;
-                cminusAsymp_of_n0First = cminusAsymp;
+        // Everything else only touches state no other per-row writer
+        // shares (pairCountMaxima, cMinima/cMaxima, the totals and the
+        // n0/n2/n3 tracking), so the row is staged and replayed in order
+        // by flushAggregates() a block at a time.
+        GBAggRow &r = batch_[batchLen_++];
+        r.n = n;
+        r.delta = delta;
+        r.cminus = cminus;
+        r.cminusAsymp = cminusAsymp;
+        r.pairCount = pairCount;
+        r.c_of_n = c_of_n;
+        r.hlCorr = hlCorrAvg;
+        // Conservative bound: use raw values without HLCorr
+        if (useHLCorrInst && useHLCorr && hlCorrAvg != 0.0L) {
+            r.pcAdd = pairCount / hlCorrAvg;
+            r.cnAdd = c_of_n / hlCorrAvg;
+            hlCorrAvg = 1.0L;
+        } else {
+            r.pcAdd = pairCount;
+            r.cnAdd = c_of_n;
+        }
+        if (batchLen_ == BATCH_ROWS) {
+            flushAggregates();
+        }
+    }
+
+    // Batch entry point: stages pre-built rows (see GBAggRow) and flushes
+    // full blocks.  Callers that already have consecutive rows in hand
+    // avoid the per-call staging branches above.
+    void aggregateBatch(const GBAggRow *rows, std::size_t nrows) {
+        while (nrows) {
+            std::size_t take = BATCH_ROWS - batchLen_;
+            if (take > nrows) {
+                take = nrows;
+            }
+            for (std::size_t i = 0; i < take; ++i) {
+                batch_[batchLen_++] = rows[i];
+            }
+            rows += take;
+            nrows -= take;
+            if (batchLen_ == BATCH_ROWS) {
+                flushAggregates();
             }
-            cminus_of_n0Last = cminus;
-            cminusAsymp_of_n0Last = cminusAsymp;
         }
-        if (c_of_n-cminus <= c_of_n2Last-cminus_of_n2Last || !n2Last) {
-            if (c_of_n-cminus < c_of_n2First-cminus_of_n2First || !n2First) {
-                c_of_n2First = c_of_n;
-                cminus_of_n2First = cminus;
-                cminusAsymp_of_n2First = cminusAsymp;
-                n2First = n;
+    }
+
+    // Replays the staged block: one flat pass over the totals (folded into
+    // the running sums with Kahan compensation, so billion-row intervals
+    // stay exact even on the --precision=double fast path), then the
+    // order-dependent extrema and crossing tracking row by row.  Cheap
+    // no-op when nothing is staged; every reader calls it first.
+    void flushAggregates() {
+        if (!batchLen_) {
+            return;
+        }
+        if (!usePrefixTotals) {
+            long double pcSum = 0.0L;
+            long double cnSum = 0.0L;
+            for (std::size_t i = 0; i < batchLen_; ++i) {
+                pcSum += batch_[i].pcAdd;
+                cnSum += batch_[i].cnAdd;
             }
-            c_of_n2Last = c_of_n;
-            cminus_of_n2Last = cminus;
-            cminusAsymp_of_n2Last = cminusAsymp;
-            n2Last = n;
+            kahanAdd(pairCountTotal, pairCountTotalComp, pcSum);
+            kahanAdd(pairCountTotalNorm, pairCountTotalNormComp, cnSum);
         }
-        if (c_of_n-cminusAsymp <= c_of_n3Last-cminusAsymp_of_n3Last  || !n3Last) {
-            if (c_of_n-cminusAsymp < c_of_n3First-cminusAsymp_of_n3First  || !n3First) {
-                c_of_n3First = c_of_n;
-                cminus_of_n3First = cminus;
-                cminusAsymp_of_n3First = cminusAsymp;
-                n3First = n;
+        for (std::size_t i = 0; i < batchLen_; ++i) {
+            const GBAggRow &r = batch_[i];
+            pairCountMaxima.putMaxima(r.pairCount, 0.0L, r.n, r.delta, r.hlCorr);
+            cMinima.putMinima(r.c_of_n, 0.0L, r.n, r.delta, r.hlCorr);
+            cMaxima.putMaxima(r.c_of_n, 0.0L, r.n, r.delta, r.hlCorr);
+            if(r.n == cMinima.n_last) {
+                if(r.n == cMinima.n_first) {
+                    cminus_of_n0First = r.cminus;
+                    cminusAsymp_of_n0First = r.cminusAsymp;
+                }
+                cminus_of_n0Last = r.cminus;
+                cminusAsymp_of_n0Last = r.cminusAsymp;
+            }
+            if (r.c_of_n-r.cminus <= c_of_n2Last-cminus_of_n2Last || !n2Last) {
+                if (r.c_of_n-r.cminus < c_of_n2First-cminus_of_n2First || !n2First) {
+                    c_of_n2First = r.c_of_n;
+                    cminus_of_n2First = r.cminus;
+                    cminusAsymp_of_n2First = r.cminusAsymp;
+                    n2First = r.n;
+                }
+                c_of_n2Last = r.c_of_n;
+                cminus_of_n2Last = r.cminus;
+                cminusAsymp_of_n2Last = r.cminusAsymp;
+                n2Last = r.n;
+            }
+            if (r.c_of_n-r.cminusAsymp <= c_of_n3Last-cminusAsymp_of_n3Last  || !n3Last) {
+                if (r.c_of_n-r.cminusAsymp < c_of_n3First-cminusAsymp_of_n3First  || !n3First) {
+                    c_of_n3First = r.c_of_n;
+                    cminus_of_n3First = r.cminus;
+                    cminusAsymp_of_n3First = r.cminusAsymp;
+                    n3First = r.n;
+                }
+                c_of_n3Last = r.c_of_n;
+                cminus_of_n3Last = r.cminus;
+                cminusAsymp_of_n3Last = r.cminusAsymp;
+                n3Last = r.n;
             }
-            c_of_n3Last = c_of_n;
-            cminus_of_n3Last = cminus;
-            cminusAsymp_of_n3Last = cminusAsymp;
-            n3Last = n;
         }
+        batchLen_ = 0;
     }
 
     void applyHLCorr(
@@ -349,6 +435,7 @@ public:
         HLCorrState &boundDeltaMinNormState,
         HLCorrState &boundDeltaMaxNormState
     ) {
+        flushAggregates();
         hlCorrAvg = 0.5L*(evenState(n_geom_even,delta_even)+oddState(n_geom_odd,delta_odd));
         pairCountAvg *= hlCorrAvg;
         cAvg *= hlCorrAvg;
@@ -367,6 +454,7 @@ public:
         HLCorrState &boundDeltaMinNormState,
         HLCorrState &boundDeltaMaxNormState
     ) {
+        flushAggregates();
         // Note: pairCountMinima should NOT call applyHLCorrStateMin because that method
         // has swapping logic designed for alignment calculations, not regular minimum tracking.
         // For pairCountMinima, we just need to apply the HLCorr to the c values without swapping n values.
@@ -401,7 +489,30 @@ public:
     void outputBoundRatioMin(GBLongInterval &interval);
     void outputBoundRatioMax(GBLongInterval &interval);
 
+    // --checkpoint: persist/restore the full summary (totals with their
+    // Kahan carries, extrema, crossing tracking and the interpolator
+    // samples).  Any staged rows are flushed first, so the snapshot never
+    // contains a partial batch.  The reference members alias extrema
+    // fields and travel with them.
+    int checkpointWrite(std::FILE *f);
+    int checkpointRead(std::FILE *f);
+
 private:
+    // Staged aggregation block and the Kahan compensation carried by the
+    // running totals across flushes.
+    static constexpr std::size_t BATCH_ROWS = 64;
+    GBAggRow batch_[BATCH_ROWS];
+    std::size_t batchLen_ = 0;
+    long double pairCountTotalComp = 0.0L;
+    long double pairCountTotalNormComp = 0.0L;
+
+    static void kahanAdd(long double &total, long double &comp, long double v) {
+        const long double y = v - comp;
+        const long double t = total + y;
+        comp = (t - total) - y;
+        total = t;
+    }
+
     void outputCpsLine(
         class GBLongInterval &interval,
         std::uint64_t n,
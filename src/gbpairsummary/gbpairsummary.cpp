@@ -30,8 +30,11 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <ctime>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 // C interop
 extern "C" {
@@ -55,6 +58,9 @@ static void print_usage(const char* prog) {
         "Counts Goldbach pairs in a sliding window of half-width delta = floor(alpha(n)*n).\n"
         "By default applies the Euler safety cap M(n)=ceil(((2n+1)-sqrt(8n+1))/2)-1.\n"
         "\n"
+        "--alpha may be repeated; all windows are updated in a single pass over the\n"
+        "prime array, with per-window output selected by the -=ALPHA=- path macro.\n"
+        "\n"
         "Positional:\n"
         "  prime_raw_file       Path to raw uint64_t prime array file\n"
         "\n"
@@ -77,7 +83,39 @@ static void print_usage(const char* prog) {
         "  --prim-cps-summary-resume=FILE Resume processing by reading previous cps summary from FILE\n"
         "  --prim-psi=FILE      Write primorial short interval (PSI) CSV to FILE (use \"-\" for stdout)\n"
         "  --compat=VERSION     v0.1 (aka v0.1.5) or v0.2/current. Default: v0.2\n"
+        "  --threads=N          Fan the per-n work out across N threads, one contiguous\n"
+        "                       block of alpha windows per thread (empirical model only)\n"
+        "  --bitmap=FILE        Count pairs with the word-reversed AND + popcount kernel\n"
+        "                       over the odd-prime bitmap instead of the two-pointer walk\n"
+        "  --pi-index=FILE      Sampled pi(x) index (primeindex tool) for the prime\n"
+        "                       array; seeds cursors in O(1) instead of a linear scan\n"
+        "  --huge-pages         madvise(MADV_HUGEPAGE) the prime array mapping\n"
+        "  --mlock              mlock the prime array mapping (dedicated boxes)\n"
+        "  --readahead=MB       Background thread keeps MB MiB of the prime array\n"
+        "                       resident ahead of the row cursor and ahead of the\n"
+        "                       upper window cursors near 2n; 0 disables (default)\n"
+        "  --stream             The prime file is a live gbpipeline shared-memory\n"
+        "                       stream; gate each n on the published sieve coverage\n"
+        "  --instrument         Keep per-window hot-path counters (cursor walk length,\n"
+        "                       Euler product calls/time, rows per stream) and dump a\n"
+        "                       CSV profile on stderr at exit\n"
+        "  --checkpoint=FILE    Snapshot the full engine state to FILE at every decade\n"
+        "                       boundary (atomic tmp+rename); needs a decade stream\n"
+        "  --checkpoint-resume=FILE  Restore a --checkpoint snapshot and continue from\n"
+        "                       its decade bit-exactly; pair with --append so the rows\n"
+        "                       already written before the interruption are kept\n"
+        "  --hlcorr-cache=FILE  Persist exact HLCorr pre-scan samples to FILE, keyed by\n"
+        "                       (alpha, model, compat); later shards seed their\n"
+        "                       interpolators from it and skip the pre-scan\n"
+        "  --columnar           Write the full/raw/norm interval streams in the binary\n"
+        "                       columnar format instead of CSV (convert with gbcol2csv)\n"
+        "  --rle-eps=EPS        Run-length encode the raw/norm streams: emit a row only\n"
+        "                       when a value column moves more than EPS (absolute) from\n"
+        "                       the previous emitted row, with a REPEAT count column\n"
         "  --model=MODE         empirical (default) or hl-a\n"
+        "  --precision=MODE     long-double (default) or double; double evaluates the\n"
+        "                       per-n model curves in the SSE unit instead of x87 for\n"
+        "                       exploratory sweeps (certified runs keep long-double)\n"
         "  --start-n=N          Start n (uint64). Default: 4\n"
         "  --dec-start-n=N      Start n (uint64). Default: 4\n"
         "  --prim-start-n=N     Start n (uint64). Default: 6\n"
@@ -120,19 +158,114 @@ public:
         if (p == MAP_FAILED) {
             throw std::runtime_error("mmap failed");
         }
+        // A delta-encoded store (storeprimes --gaps) is decoded into an
+        // anonymous mapping so callers see the same uint64_t array either way.
+        if (isPrimeGapData(static_cast<const std::uint8_t*>(p), (size_t)st_.st_size)) {
+            PrimeGapDecoder dec;
+            if (primeGapDecoderInit(&dec, static_cast<const std::uint8_t*>(p), (size_t)st_.st_size) != 0) {
+                ::munmap(p, st_.st_size);
+                throw std::runtime_error("bad prime gap header");
+            }
+            decoded_size_ = (std::size_t)dec.total * sizeof(std::uint64_t);
+            void* buf = ::mmap(nullptr, decoded_size_, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (buf == MAP_FAILED) {
+                ::munmap(p, st_.st_size);
+                throw std::runtime_error("mmap (decode buffer) failed");
+            }
+            std::uint64_t* dst = static_cast<std::uint64_t*>(buf);
+            std::size_t produced = 0;
+            for (std::size_t got; (got = primeGapDecoderNextBlock(&dec, dst + produced, 1u << 16)) > 0; ) {
+                produced += got;
+            }
+            ::munmap(p, st_.st_size);
+            if (produced != (std::size_t)dec.total) {
+                ::munmap(buf, decoded_size_);
+                throw std::runtime_error("truncated prime gap stream");
+            }
+            base_ = dst;
+            len_  = produced;
+            return;
+        }
         base_ = static_cast<std::uint64_t*>(p);
         len_  = (std::size_t)(st_.st_size / sizeof(std::uint64_t));
     }
 
+    // --stream: the file is a live gbpipeline stream (header page followed
+    // by prime slots) still being appended to by the driver.  Map it shared
+    // so the producer's writes become visible, and keep the header so the
+    // row loop can gate on published coverage.
+    void open_stream(const char* path) {
+        close();
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("open failed");
+        }
+        if (::fstat(fd_, &st_) < 0) {
+            throw std::runtime_error("fstat failed");
+        }
+        if ((std::size_t)st_.st_size < GB_PRIME_STREAM_HDR_BYTES + sizeof(std::uint64_t)) {
+            throw std::runtime_error("stream too small");
+        }
+        void* p = ::mmap(nullptr, st_.st_size, PROT_READ, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("mmap failed");
+        }
+        hdr_ = static_cast<const GBPrimeStreamHdr*>(p);
+        if (hdr_->magic != GB_PRIME_STREAM_MAGIC) {
+            ::munmap(p, st_.st_size);
+            hdr_ = nullptr;
+            throw std::runtime_error("not a prime stream");
+        }
+        base_ = reinterpret_cast<std::uint64_t*>(
+            reinterpret_cast<std::uint8_t*>(p) + GB_PRIME_STREAM_HDR_BYTES);
+        len_  = (std::size_t)hdr_->capacity;
+    }
+
+    bool isStream() const {
+        return hdr_ != nullptr;
+    }
+
+    // Block until the published primes cover 2n with slack for the seeks
+    // that overshoot it (computeDelta at alpha=1 wants the first prime past
+    // ~2n; 2048 clears every known prime gap in 64-bit range).  Returns the
+    // largest n the caller may process before gating again; once the
+    // producer is done that bound is final and the caller errors past it.
+    std::uint64_t streamWait(std::uint64_t n) const {
+        const std::uint64_t need = (n << 1) + GB_STREAM_GATE_SLACK;
+        for (;;) {
+            const std::uint64_t pub = gbPrimeStreamPublished(hdr_);
+            const std::uint64_t pmax = pub ? base_[pub - 1] : 0;
+            if (pmax >= need) {
+                return (pmax - GB_STREAM_GATE_SLACK) >> 1;
+            }
+            if (gbPrimeStreamDone(hdr_)) {
+                return (pmax > GB_STREAM_GATE_SLACK) ? ((pmax - GB_STREAM_GATE_SLACK) >> 1) : 0;
+            }
+            struct timespec ts = {0, 200000}; // 0.2 ms
+            ::nanosleep(&ts, nullptr);
+        }
+    }
+
     void close() {
+        if (pf_thread_.joinable()) {
+            pf_stop_.store(true, std::memory_order_relaxed);
+            pf_thread_.join();
+        }
+        if (hdr_) {
+            ::munmap(const_cast<GBPrimeStreamHdr*>(hdr_), (std::size_t)st_.st_size);
+            hdr_ = nullptr;
+            base_ = nullptr;
+        }
         if (base_ && base_ != MAP_FAILED) {
-            ::munmap(base_, st_.st_size);
+            ::munmap(base_, decoded_size_ ? decoded_size_ : (std::size_t)st_.st_size);
             base_ = nullptr;
         }
         if (fd_ >= 0) {
             ::close(fd_); fd_ = -1;
         }
         len_ = 0;
+        decoded_size_ = 0;
     }
 
     std::uint64_t* begin() const {
@@ -145,11 +278,179 @@ public:
         return len_;
     }
 
+    // Mapping tuning for big arrays (--huge-pages, --mlock).  Both are
+    // advisory: a kernel without transparent hugepages or an over-limit
+    // mlock leaves the plain demand-fault behavior.
+    void advise(bool hugepage, bool lock) {
+        if (!base_) {
+            return;
+        }
+        const std::size_t bytes = decoded_size_ ? decoded_size_
+            : (hdr_ ? len_ * sizeof(std::uint64_t) : (std::size_t)st_.st_size);
+#ifdef MADV_HUGEPAGE
+        if (hugepage) {
+            ::madvise(base_, bytes, MADV_HUGEPAGE);
+        }
+#else
+        (void)hugepage;
+#endif
+        if (lock && ::mlock(base_, bytes) != 0) {
+            std::perror("mlock"); // keep running unlocked
+        }
+    }
+
+    // Readahead (--readahead): MADV_WILLNEED for the window ahead of the
+    // walk cursor, so the pages the upper cursors are about to touch are
+    // resident before the two-pointer walk reaches them.  Cheap to call
+    // often - only pages past the previous high-water mark are advised.
+    // A decoded gap store is an anonymous mapping written at load time, so
+    // there is nothing to fetch.
+    void prefetch(const std::uint64_t* cursor, std::size_t aheadBytes) {
+        if (!base_ || decoded_size_) {
+            return;
+        }
+        const char* begin_b = reinterpret_cast<const char*>(base_);
+        const char* end_b   = begin_b + len_ * sizeof(std::uint64_t);
+        const char* from    = reinterpret_cast<const char*>(cursor);
+        if (from < begin_b || from >= end_b) {
+            return;
+        }
+        const char* want = (aheadBytes < (std::size_t)(end_b - from))
+            ? from + aheadBytes : end_b;
+        if (want <= prefetched_) {
+            return;
+        }
+        if (prefetched_ > from) {
+            from = prefetched_;
+        }
+        static const std::uintptr_t page_mask = ~((std::uintptr_t)::sysconf(_SC_PAGESIZE) - 1);
+        char* aligned = reinterpret_cast<char*>(reinterpret_cast<std::uintptr_t>(from) & page_mask);
+        ::madvise(aligned, (std::size_t)(want - aligned), MADV_WILLNEED);
+        prefetched_ = want;
+    }
+
+    // Async readahead: a background thread keeps two WILLNEED bands
+    // resident - one ahead of the row cursor near n, one ahead of the
+    // upper window cursors near 2n, which run megabytes ahead and would
+    // otherwise be pure demand faults.  The row loop only stores the
+    // current prime value (prefetchTarget); the thread advances its own
+    // monotonic positions, so neither side ever blocks on the other.
+    // Decoded gap stores and live streams are memory-resident already.
+    void startPrefetchThread(std::size_t aheadBytes) {
+        if (!base_ || decoded_size_ || hdr_ || pf_thread_.joinable()) {
+            return;
+        }
+        pf_stop_.store(false, std::memory_order_relaxed);
+        pf_thread_ = std::thread([this, aheadBytes] { prefetchLoop(aheadBytes); });
+    }
+    bool prefetchAsync() const {
+        return pf_thread_.joinable();
+    }
+    void prefetchTarget(std::uint64_t prime_near_n) {
+        pf_target_.store(prime_near_n, std::memory_order_relaxed);
+    }
+
 private:
+    void prefetchLoop(std::size_t aheadBytes) {
+        std::size_t lo_pos = 0, hi_pos = 0;
+        const char *lo_mark = nullptr, *hi_mark = nullptr;
+        while (!pf_stop_.load(std::memory_order_relaxed)) {
+            const std::uint64_t t = pf_target_.load(std::memory_order_relaxed);
+            if (t) {
+                adviseBand(lo_pos, lo_mark, t, aheadBytes);
+                adviseBand(hi_pos, hi_mark, 2 * t, aheadBytes);
+            }
+            struct timespec ts = {0, 2000000}; // 2 ms
+            ::nanosleep(&ts, nullptr);
+        }
+    }
+
+    // Advance pos to the first prime >= value and WILLNEED aheadBytes from
+    // there, past the band's previous high-water mark only.
+    void adviseBand(std::size_t &pos, const char *&mark,
+                    std::uint64_t value, std::size_t aheadBytes) {
+        while (pos < len_ && base_[pos] < value) {
+            ++pos;
+        }
+        const char *from  = reinterpret_cast<const char*>(base_ + pos);
+        const char *end_b = reinterpret_cast<const char*>(base_ + len_);
+        const char *want  = (aheadBytes < (std::size_t)(end_b - from))
+            ? from + aheadBytes : end_b;
+        if (want <= mark) {
+            return;
+        }
+        if (mark > from) {
+            from = mark;
+        }
+        static const std::uintptr_t page_mask = ~((std::uintptr_t)::sysconf(_SC_PAGESIZE) - 1);
+        char* aligned = reinterpret_cast<char*>(reinterpret_cast<std::uintptr_t>(from) & page_mask);
+        ::madvise(aligned, (std::size_t)(want - aligned), MADV_WILLNEED);
+        mark = want;
+    }
     int fd_ = -1;
     struct stat st_ {};
     std::uint64_t* base_ = nullptr;
     std::size_t len_ = 0;
+    std::size_t decoded_size_ = 0; // nonzero when base_ is a decoded gap store
+    const char* prefetched_ = nullptr; // readahead high-water mark
+    std::thread pf_thread_;            // async readahead worker
+    std::atomic<std::uint64_t> pf_target_{0}; // prime value near the row cursor
+    std::atomic<bool> pf_stop_{false};
+    const GBPrimeStreamHdr* hdr_ = nullptr; // set when mapped via open_stream
+    static constexpr std::uint64_t GB_STREAM_GATE_SLACK = 2048;
+};
+
+// ----- RAII mmap wrapper (byte view, for the odd-prime bitmap) -----
+class MMapU8 {
+public:
+    MMapU8() = default;
+    MMapU8(const MMapU8&) = delete;
+    MMapU8& operator=(const MMapU8&) = delete;
+
+    ~MMapU8() {
+        close();
+    }
+
+    void open_file(const char* path) {
+        close();
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("open failed");
+        }
+        if (::fstat(fd_, &st_) < 0) {
+            throw std::runtime_error("fstat failed");
+        }
+        void* p = ::mmap(nullptr, st_.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("mmap failed");
+        }
+        base_ = static_cast<std::uint8_t*>(p);
+        len_  = (std::size_t)st_.st_size;
+    }
+
+    void close() {
+        if (base_ && base_ != MAP_FAILED) {
+            ::munmap(base_, st_.st_size);
+            base_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_); fd_ = -1;
+        }
+        len_ = 0;
+    }
+
+    const std::uint8_t* begin() const {
+        return base_;
+    }
+    std::size_t size() const {
+        return len_;
+    }
+
+private:
+    int fd_ = -1;
+    struct stat st_ {};
+    std::uint8_t* base_ = nullptr;
+    std::size_t len_ = 0;
 };
 
 // "%.6Lg" is compact (no forced fixed/scientific); tweak precision if you like.
@@ -231,6 +532,11 @@ int main(int argc, char* argv[]) try {
     const char* psi_boundRatioMin_path = nullptr;  // v0.2.0: bound ratio minimum output
     const char* psi_boundRatioMax_path = nullptr;  // v0.2.0: bound ratio maximum output
     bool append_to_file  = false;
+    const char* bitmap_path = nullptr;
+    const char* pi_index_path = nullptr;
+    bool use_huge_pages = false;
+    bool use_mlock = false;
+    bool stream_input = false;
     std::vector<long double> alphas;
     FILE * dec_trace = nullptr;
     FILE * prim_trace = nullptr;
@@ -240,6 +546,7 @@ int main(int argc, char* argv[]) try {
         {"alpha",           required_argument, 0,  0 },
         {"trace",           required_argument, 0,  0 },
         {"model",           required_argument, 0,  0 },
+        {"precision",       required_argument, 0,  0 },
         {"dec-out",         required_argument, 0,  0 },
         {"dec-full",        required_argument, 0,  0 },
         {"dec-raw",         required_argument, 0,  0 },
@@ -270,6 +577,19 @@ int main(int argc, char* argv[]) try {
         {"dec-n-end",       required_argument, 0,  0 },
         {"psi-n-end",       required_argument, 0,  0 },
         {"compat",          required_argument, 0,  0 },
+        {"threads",         required_argument, 0,  0 },
+        {"bitmap",          required_argument, 0,  0 },
+        {"pi-index",        required_argument, 0,  0 },
+        {"huge-pages",      no_argument,       0,  0 },
+        {"mlock",           no_argument,       0,  0 },
+        {"readahead",       required_argument, 0,  0 },
+        {"stream",          no_argument,       0,  0 },
+        {"instrument",      no_argument,       0,  0 },
+        {"hlcorr-cache",    required_argument, 0,  0 },
+        {"checkpoint",      required_argument, 0,  0 },
+        {"checkpoint-resume",required_argument,0,  0 },
+        {"columnar",        no_argument,       0,  0 },
+        {"rle-eps",         required_argument, 0,  0 },
         {"euler-cap",       no_argument,       0,  0 },
         {"no-euler-cap",    no_argument,       0,  0 },
         {"append",          no_argument,       0,  0 },
@@ -449,6 +769,63 @@ int main(int argc, char* argv[]) try {
                         n_end_opt = range.psiAgg.n_end;
                     }
                 }
+                else if (!std::strcmp(name, "bitmap")) {
+                    bitmap_path = optarg;
+                }
+                else if (!std::strcmp(name, "pi-index")) {
+                    pi_index_path = optarg;
+                }
+                else if (!std::strcmp(name, "huge-pages")) {
+                    use_huge_pages = true;
+                }
+                else if (!std::strcmp(name, "mlock")) {
+                    use_mlock = true;
+                }
+                else if (!std::strcmp(name, "readahead")) {
+                    char* endp = nullptr;
+                    unsigned long long mb = strtoull(optarg, &endp, 10);
+                    if (!endp || *endp != '\0') {
+                        std::fprintf(stderr, "Error: --readahead must be an integer (MiB)\n");
+                        return 1;
+                    }
+                    range.readaheadBytes = (std::size_t)mb << 20;
+                }
+                else if (!std::strcmp(name, "stream")) {
+                    stream_input = true;
+                }
+                else if (!std::strcmp(name, "instrument")) {
+                    range.instrument = true;
+                }
+                else if (!std::strcmp(name, "hlcorr-cache")) {
+                    range.hlcorrCache.setPath(optarg);
+                }
+                else if (!std::strcmp(name, "checkpoint")) {
+                    range.checkpointPath = optarg;
+                }
+                else if (!std::strcmp(name, "checkpoint-resume")) {
+                    range.checkpointResumePath = optarg;
+                }
+                else if (!std::strcmp(name, "columnar")) {
+                    range.columnar = true;
+                }
+                else if (!std::strcmp(name, "rle-eps")) {
+                    char* endp = nullptr;
+                    long double eps = strtold(optarg, &endp);
+                    if (!endp || *endp != '\0' || !(eps >= 0.0L)) {
+                        std::fprintf(stderr, "Error: --rle-eps must be a number >= 0\n");
+                        return 1;
+                    }
+                    range.rle_eps = eps;
+                }
+                else if (!std::strcmp(name, "threads")) {
+                    char* endp = nullptr;
+                    long tmp = strtol(optarg, &endp, 10);
+                    if (!endp || *endp != '\0' || tmp < 1) {
+                        std::fprintf(stderr, "Error: --threads must be an integer >= 1\n");
+                        return 1;
+                    }
+                    range.numThreads = (int)tmp;
+                }
                 else if (!std::strcmp(name, "compat")) {
                     if (!std::strcmp(optarg, "v0.1") || !std::strncmp(optarg, "v0.1.", 5)) {
                         range.compat_ver = CompatVer::V01x;
@@ -509,6 +886,18 @@ int main(int argc, char* argv[]) try {
                         return 1;
                     }
                 }
+                else if (!std::strcmp(name, "precision")) {
+                    if (!strcasecmp(optarg, "long-double")) {
+                        range.fastDouble = false;
+                    }
+                    else if (!strcasecmp(optarg, "double")) {
+                        range.fastDouble = true;
+                    }
+                    else {
+                        std::fprintf(stderr, "Error: --precision must be long-double or double\n");
+                        return 1;
+                    }
+                }
             } break;
             case 'h': print_usage(argv[0]); return 0;
             case 'V': std::fprintf(stderr, "gbpairsummary (GPL-3.0-or-later) v0.2.0\n"); return 0;
@@ -522,6 +911,19 @@ int main(int argc, char* argv[]) try {
 
     const char* prime_file = argv[optind];
 
+    if (range.columnar && range.compat_ver == CompatVer::V01x) {
+        std::fprintf(stderr, "Error: --columnar is not supported with --compat=v0.1 output\n");
+        return 1;
+    }
+    if (range.columnar && append_to_file) {
+        std::fprintf(stderr, "Error: --columnar cannot append to existing files\n");
+        return 1;
+    }
+    if (range.rle_eps >= 0.0L && range.columnar) {
+        std::fprintf(stderr, "Error: --rle-eps applies to the CSV raw/norm streams and"
+            " is not supported with --columnar\n");
+        return 1;
+    }
     if (n_end_opt > 0 && n_end_opt <= n_start_opt) {
         std::fprintf(stderr, "Error: *-n-end (%" PRIu64 ") must be > *-n-start (%" PRIu64 ")\n", n_end_opt, n_start_opt);
         return 1;
@@ -537,11 +939,72 @@ int main(int argc, char* argv[]) try {
     // Map primes with RAII
     MMapU64 primes;
     try {
-        primes.open_file(prime_file);
+        if (stream_input) {
+            primes.open_stream(prime_file);
+        }
+        else {
+            primes.open_file(prime_file);
+        }
     } catch (const std::exception& e) {
         std::perror(e.what());
         return 1;
     }
+    if (stream_input) {
+        range.streamWaitCtx = &primes;
+        range.streamWaitFn = [](void *ctx, std::uint64_t n) {
+            return static_cast<const MMapU64*>(ctx)->streamWait(n);
+        };
+        if (pi_index_path) {
+            // The index binary-searches the whole array, which is not yet
+            // sorted past the published watermark.
+            std::fprintf(stderr, "Warning: --pi-index ignored with --stream\n");
+            pi_index_path = nullptr;
+        }
+    }
+    primes.advise(use_huge_pages, use_mlock);
+    if (range.readaheadBytes) {
+        range.prefetchCtx = &primes;
+        primes.startPrefetchThread(range.readaheadBytes);
+        if (primes.prefetchAsync()) {
+            range.prefetchFn = [](void *ctx, const std::uint64_t *cursor, std::size_t) {
+                static_cast<MMapU64*>(ctx)->prefetchTarget(*cursor);
+            };
+        } else {
+            range.prefetchFn = [](void *ctx, const std::uint64_t *cursor, std::size_t bytes) {
+                static_cast<MMapU64*>(ctx)->prefetch(cursor, bytes);
+            };
+        }
+    }
+
+    // Optional odd-prime bitmap for the popcount pair-counting kernel
+    MMapU8 bitmap;
+    if (bitmap_path) {
+        try {
+            bitmap.open_file(bitmap_path);
+        } catch (const std::exception& e) {
+            std::perror(e.what());
+            return 1;
+        }
+        range.bitmap = bitmap.begin();
+        range.bitmapBits = (std::uint64_t)bitmap.size() * 8ULL;
+    }
+
+    // Optional sampled pi(x) index for O(1) cursor seeding
+    MMapU8 pi_index_map;
+    PrimeIndex pi_index;
+    if (pi_index_path) {
+        try {
+            pi_index_map.open_file(pi_index_path);
+        } catch (const std::exception& e) {
+            std::perror(e.what());
+            return 1;
+        }
+        if (primeIndexInit(&pi_index, pi_index_map.begin(), pi_index_map.size()) != 0) {
+            std::fprintf(stderr, "Error: %s is not a primeindex file\n", pi_index_path);
+            return 1;
+        }
+        range.primeIndex = &pi_index;
+    }
    
     // sort low → high and (optionally) dedupe exact repeats
     std::sort(alphas.begin(), alphas.end());
@@ -685,9 +1148,19 @@ int main(int argc, char* argv[]) try {
             need_trace = false;
         }
         if (dec_cps_summary_path) {
-            range.decAgg.cps_summary  = open_stream_from_template(dec_cps_summary_path, w->alpha, "cps-summary", false);
-            if(! range.decAgg.cps_summary) {
-                return 1;
+            if (containsKey(dec_cps_summary_path,ALPHA_KEY)) {
+                // Per-window summary file; one stream per alpha.
+                w->dec.cps_summary  = open_stream_from_template(dec_cps_summary_path, w->alpha, "cps-summary", false);
+                if(! w->dec.cps_summary) {
+                    return 1;
+                }
+            }
+            else if (! range.decAgg.cps_summary) {
+                // Shared summary file; rows carry the alpha column. Open once.
+                range.decAgg.cps_summary  = open_stream_from_template(dec_cps_summary_path, w->alpha, "cps-summary", false);
+                if(! range.decAgg.cps_summary) {
+                    return 1;
+                }
             }
         }
         if (dec_boundRatioMin_path) {
@@ -738,9 +1211,19 @@ int main(int argc, char* argv[]) try {
             need_trace = false;
         }
         if (prim_cps_summary_path) {
-            range.primAgg.cps_summary  = open_stream_from_template(prim_cps_summary_path, w->alpha, "cps-summary", false);
-            if(! range.primAgg.cps_summary) {
-                return 1;
+            if (containsKey(prim_cps_summary_path,ALPHA_KEY)) {
+                // Per-window summary file; one stream per alpha.
+                w->prim.cps_summary  = open_stream_from_template(prim_cps_summary_path, w->alpha, "cps-summary", false);
+                if(! w->prim.cps_summary) {
+                    return 1;
+                }
+            }
+            else if (! range.primAgg.cps_summary) {
+                // Shared summary file; rows carry the alpha column. Open once.
+                range.primAgg.cps_summary  = open_stream_from_template(prim_cps_summary_path, w->alpha, "cps-summary", false);
+                if(! range.primAgg.cps_summary) {
+                    return 1;
+                }
             }
         }
         if (prim_boundRatioMin_path) {
@@ -790,21 +1273,48 @@ int main(int argc, char* argv[]) try {
         range.printHeaders();
     }
 
-    // Resume from previous cps summary if specified
+    // Resume from previous cps summary if specified.  With the ALPHA macro the
+    // summary lives in one file per window; expand and load each in turn.
     if (dec_cps_summary_resume_path) {
-        int resume_result = range.decInputCpsSummary(dec_cps_summary_resume_path);
-        if (resume_result != 0) {
-            std::fprintf(stderr, "Error: Failed to resume decade from %s (return code: %d)\n", 
-                dec_cps_summary_resume_path, resume_result);
-            return -1;
+        if (containsKey(dec_cps_summary_resume_path,ALPHA_KEY)) {
+            for(auto &w : range.windows) {
+                std::string path = expand_template(dec_cps_summary_resume_path, w->alpha, "cps-summary");
+                int resume_result = range.decInputCpsSummary(path.c_str());
+                if (resume_result != 0) {
+                    std::fprintf(stderr, "Error: Failed to resume decade from %s (return code: %d)\n",
+                        path.c_str(), resume_result);
+                    return -1;
+                }
+            }
+        }
+        else {
+            int resume_result = range.decInputCpsSummary(dec_cps_summary_resume_path);
+            if (resume_result != 0) {
+                std::fprintf(stderr, "Error: Failed to resume decade from %s (return code: %d)\n",
+                    dec_cps_summary_resume_path, resume_result);
+                return -1;
+            }
         }
     }
     if (prim_cps_summary_resume_path) {
-        int resume_result = range.primInputCpsSummary(prim_cps_summary_resume_path);
-        if (resume_result != 0) {
-            std::fprintf(stderr, "Error: Failed to resume primorial from %s (return code: %d)\n", 
-                prim_cps_summary_resume_path, resume_result);
-            return -1;
+        if (containsKey(prim_cps_summary_resume_path,ALPHA_KEY)) {
+            for(auto &w : range.windows) {
+                std::string path = expand_template(prim_cps_summary_resume_path, w->alpha, "cps-summary");
+                int resume_result = range.primInputCpsSummary(path.c_str());
+                if (resume_result != 0) {
+                    std::fprintf(stderr, "Error: Failed to resume primorial from %s (return code: %d)\n",
+                        path.c_str(), resume_result);
+                    return -1;
+                }
+            }
+        }
+        else {
+            int resume_result = range.primInputCpsSummary(prim_cps_summary_resume_path);
+            if (resume_result != 0) {
+                std::fprintf(stderr, "Error: Failed to resume primorial from %s (return code: %d)\n",
+                    prim_cps_summary_resume_path, resume_result);
+                return -1;
+            }
         }
     }
     range.printCpsSummaryHeaders();
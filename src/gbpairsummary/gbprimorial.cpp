@@ -127,3 +127,21 @@ void GBPrimorial::reset(std::uint64_t &n_start,bool) {
     label = std::string(buf);
 }
 
+
+int GBPrimorial::checkpointWrite(std::FILE *f) const {
+    int rc = GBAggregate::checkpointWrite(f);
+    rc |= gbCkPut(f, thresholdMajor);
+    rc |= gbCkPut(f, thresholdMinor);
+    rc |= gbCkPut(f, major);
+    rc |= gbCkPut(f, minor);
+    return rc;
+}
+
+int GBPrimorial::checkpointRead(std::FILE *f) {
+    int rc = GBAggregate::checkpointRead(f);
+    rc |= gbCkGet(f, thresholdMajor);
+    rc |= gbCkGet(f, thresholdMinor);
+    rc |= gbCkGet(f, major);
+    rc |= gbCkGet(f, minor);
+    return rc;
+}
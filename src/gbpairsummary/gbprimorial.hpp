@@ -29,8 +29,11 @@ public:
     FILE *cps_summary = nullptr;
 
     GBPrimorial();
-    
+
     void reset(std::uint64_t &n_start,bool inclusiveInterval) override;
+
+    int checkpointWrite(std::FILE *f) const override;
+    int checkpointRead(std::FILE *f) override;
 };
 
 #endif // GB_PRIMORIAL_HPP
@@ -50,3 +50,33 @@ void GBPSI::reset(std::uint64_t &n_start,bool) {
     label = std::string(buf);
 }
 
+
+int GBPSI::checkpointWrite(std::FILE *f) const {
+    int rc = GBAggregate::checkpointWrite(f);
+    rc |= gbCkPut(f, prime_index);
+    rc |= gbCkPut(f, q_next);
+    // Prefix slots are plain scalar bundles; dump them raw.  The count is
+    // validated on restore so the wired window pointers stay valid.
+    const std::uint64_t slots = (std::uint64_t)prefix.size();
+    rc |= gbCkPut(f, slots);
+    if (slots) {
+        rc |= gbCkWrite(f, prefix.data(), slots * sizeof(GBPSIPrefix));
+    }
+    return rc;
+}
+
+int GBPSI::checkpointRead(std::FILE *f) {
+    int rc = GBAggregate::checkpointRead(f);
+    rc |= gbCkGet(f, prime_index);
+    rc |= gbCkGet(f, q_next);
+    std::uint64_t slots = 0;
+    rc |= gbCkGet(f, slots);
+    if (slots != (std::uint64_t)prefix.size()) {
+        std::fprintf(stderr, "checkpoint: psi prefix slot count mismatch\n");
+        return -1;
+    }
+    if (slots) {
+        rc |= gbCkRead(f, prefix.data(), slots * sizeof(GBPSIPrefix));
+    }
+    return rc;
+}
@@ -18,16 +18,63 @@
 #ifndef GB_PSI_HPP
 #define GB_PSI_HPP 1
 
+#include <vector>
+
 #include "gbaggregate.hpp"
 
+// One per-window slot of the prefix-sum store backing the PSI stream.
+// The sweep folds each row's (already HLCorr-corrected) pair-count
+// addends into running sums over the whole range, and markLeft()
+// samples the running prefix when an interval opens.  The interval
+// totals then fall out as the difference of two prefix values, so the
+// boundary cost stays flat no matter how wide the primorial steps have
+// grown.  The sums carry Kahan compensation like the summary totals;
+// the sampled left-edge values deliberately omit the carry, since a
+// prefix difference cancels it to well below the printed precision.
+struct GBPSIPrefix {
+    long double pairCountCum = 0.0L;
+    long double normCum = 0.0L;
+    long double pairCountLeft = 0.0L;
+    long double normLeft = 0.0L;
+    long double pairCountComp = 0.0L;
+    long double normComp = 0.0L;
+
+    void add(long double pcAdd, long double cnAdd) {
+        long double y = pcAdd - pairCountComp;
+        long double t = pairCountCum + y;
+        pairCountComp = (t - pairCountCum) - y;
+        pairCountCum = t;
+        y = cnAdd - normComp;
+        t = normCum + y;
+        normComp = (t - normCum) - y;
+        normCum = t;
+    }
+
+    void markLeft() {
+        pairCountLeft = pairCountCum;
+        normLeft = normCum;
+    }
+
+    long double pairCountTotal() const { return pairCountCum - pairCountLeft; }
+    long double normTotal() const { return normCum - normLeft; }
+};
+
 class GBPSI : public GBAggregate {
 public:
     size_t prime_index = 0;
     std::uint64_t q_next = 1ULL;
 
+    // Prefix-sum backing store, one slot per window.  Sized and wired to
+    // the windows by GBRange::init() before the first reset; psiReset()
+    // marks each slot's left edge when a new interval opens.
+    std::vector<GBPSIPrefix> prefix;
+
     GBPSI();
-    
+
     void reset(std::uint64_t &n_start,bool inclusiveInterval) override;
+
+    int checkpointWrite(std::FILE *f) const override;
+    int checkpointRead(std::FILE *f) override;
 };
 
 #endif // GB_PSI_HPP
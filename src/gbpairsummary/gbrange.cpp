@@ -22,8 +22,21 @@
 #include <cinttypes> // for SCNu64, PRIu64
 #include <cmath>     // for math functions
 #include <vector>    // for std::vector
+#include <memory>    // for std::unique_ptr
+#include <atomic>    // for std::atomic
+#include <mutex>     // for std::mutex
+#include <thread>    // for std::thread
+#include <condition_variable> // for std::condition_variable
+#include <ctime>     // for clock_gettime (--instrument timing)
 #include "gbrange.hpp"
 
+// Monotonic nanosecond clock for the --instrument counters.
+static inline std::uint64_t instr_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (std::uint64_t)ts.tv_sec * 1000000000ULL + (std::uint64_t)ts.tv_nsec;
+}
+
 // ----- Small helpers -----
 static inline std::uint64_t maxPrefEven(long double value, std::uint64_t minValue) {
     std::uint64_t retval = (~1ULL) & (std::uint64_t)ceill(value);
@@ -35,17 +48,36 @@ static inline std::uint64_t minPrefOdd(long double value, std::uint64_t maxValue
     return (retval <= maxValue) ? retval : maxValue;
 }
 
-// Printf to up to two FILE*s.
+// Printf to up to two FILE*s, through the shared per-FILE output buffers
+// (gbOutBuf.c) so rows batch into one fwrite per megabyte instead of a
+// locked fprintf + fflush per row.
 static inline void vfprintf_both(FILE* a, FILE* b, const char* fmt, va_list ap) {
+    char tmp[2048];
+    va_list ap2;
+    va_copy(ap2, ap);
+    int n = std::vsnprintf(tmp, sizeof(tmp), fmt, ap2);
+    va_end(ap2);
+    if (n < 0) {
+        return;
+    }
+    if ((size_t)n >= sizeof(tmp)) {
+        // Oversized row: keep ordering by flushing, then let stdio format it.
+        if (a) {
+            va_copy(ap2, ap);
+            gbOutFlushFILE(a);
+            std::vfprintf(a, fmt, ap2); va_end(ap2);
+        }
+        if (b) {
+            gbOutFlushFILE(b);
+            std::vfprintf(b, fmt, ap);
+        }
+        return;
+    }
     if (a) {
-        va_list ap2;
-        va_copy(ap2, ap);
-        std::vfprintf(a, fmt, ap2); va_end(ap2);
-        std::fflush(a);
+        gbOutWrite(a, tmp, (size_t)n);
     }
     if (b) {
-        std::vfprintf(b, fmt, ap);
-        std::fflush(b);
+        gbOutWrite(b, tmp, (size_t)n);
     }
 }
 
@@ -56,14 +88,32 @@ static inline void fprintf_both(FILE* a, FILE* b, const char* fmt, ...) {
 }
 
 static inline void fputs_both(const char* s, FILE* a, FILE* b) {
+    const size_t len = std::strlen(s);
     if (a) {
-        std::fputs(s, a);
+        gbOutWrite(a, s, len);
     }
     if (b) {
-        std::fputs(s, b);
+        gbOutWrite(b, s, len);
     }
 }
 
+// Builds one CSV row with the fast fixed-decimal formatters (gbOutBuf.c),
+// then hands the finished line to the per-FILE output buffers in a single
+// write.  Sized for the widest row (the 23-column hl-a full format).
+struct RowBuf {
+    char buf[1024];
+    int len = 0;
+    void u64(std::uint64_t v)           { len += gbFmtU64(buf + len, v); }
+    void fixed(long double x, int prec) { len += gbFmtFixedLd(buf + len, sizeof(buf) - (size_t)len, x, prec); }
+    void str(const char *s)             { size_t n = std::strlen(s); std::memcpy(buf + len, s, n); len += (int)n; }
+    void sep()                          { buf[len++] = ','; }
+    void nl()                           { buf[len++] = '\n'; }
+    void emit(FILE *a, FILE *b) const {
+        if (a) { gbOutWrite(a, buf, (size_t)len); }
+        if (b) { gbOutWrite(b, buf, (size_t)len); }
+    }
+};
+
 static void printHeaderFull(FILE *out1,FILE *out2,bool useLegacy,Model model) {
     fputs_both(
         useLegacy
@@ -77,29 +127,37 @@ static void printHeaderFull(FILE *out1,FILE *out2,bool useLegacy,Model model) {
         out1, out2);
 }
 
-static void printHeaderRaw(FILE *out1,FILE *out2,Model model) {
+static void printHeaderRaw(FILE *out1,FILE *out2,Model model,bool rle) {
     fputs_both(
         (model == Model::Empirical
-            ?"FIRST,LAST,START,minAt,G(minAt),maxAt,G(maxAt),n_geom,<COUNT>\n"
-            :"FIRST,LAST,START,minAt*,Gpred(minAt*),maxAt*,Gpred(maxAt*),n_geom,<COUNT>*\n"),
+            ?(rle
+                ?"FIRST,LAST,START,minAt,G(minAt),maxAt,G(maxAt),n_geom,<COUNT>,REPEAT\n"
+                :"FIRST,LAST,START,minAt,G(minAt),maxAt,G(maxAt),n_geom,<COUNT>\n")
+            :(rle
+                ?"FIRST,LAST,START,minAt*,Gpred(minAt*),maxAt*,Gpred(maxAt*),n_geom,<COUNT>*,REPEAT\n"
+                :"FIRST,LAST,START,minAt*,Gpred(minAt*),maxAt*,Gpred(maxAt*),n_geom,<COUNT>*\n")),
         out1, out2);
 }
 
-static void printHeaderNorm(FILE *out1,FILE *out2,Model model) {
+static void printHeaderNorm(FILE *out1,FILE *out2,Model model,bool rle) {
     fputs_both(
         (model == Model::Empirical
-            ?"FIRST,LAST,START,n_0,C_min(n_0),n_1,C_max(n_1),n_geom,<COUNT>,C_avg\n"
-            :"FIRST,LAST,START,n_0*,Cpred_min(n_0*),n_1*,Cpred_max(n_1*),n_geom,Cpred_avg\n"),
+            ?(rle
+                ?"FIRST,LAST,START,n_0,C_min(n_0),n_1,C_max(n_1),n_geom,<COUNT>,C_avg,REPEAT\n"
+                :"FIRST,LAST,START,n_0,C_min(n_0),n_1,C_max(n_1),n_geom,<COUNT>,C_avg\n")
+            :(rle
+                ?"FIRST,LAST,START,n_0*,Cpred_min(n_0*),n_1*,Cpred_max(n_1*),n_geom,Cpred_avg,REPEAT\n"
+                :"FIRST,LAST,START,n_0*,Cpred_min(n_0*),n_1*,Cpred_max(n_1*),n_geom,Cpred_avg\n")),
         out1, out2);
 }
 
 static void printHeaderCps(FILE *out1,bool legacy) {
     if(out1) {
-        std::fputs(
+        fputs_both(
             (legacy
                 ?"Dec.,n_0,Cmin,Cminus,Cmin-Cminus,CminusAsym,Cmin-CminusAsym\n"
                 :"n,C(n),Cminus(n),C(n)-Cminus(n),CminusAsym(n),C(n)-CminusAsym(n),preMertens,preMertensAsymp,alpha(n)\n"),
-        out1);
+        out1, nullptr);
     }
 }
 
@@ -113,17 +171,26 @@ static void printHeaderCpsSummary(FILE *out1,FILE *out2,Model model) {
 
 static void printHeaderBoundRatio(FILE *out) {
     if(out) {
-        std::fputs("n,ratio,c_pred,baseline,c_meas,lambda,status\n", out);
+        fputs_both("n,ratio,c_pred,baseline,c_meas,lambda,status\n", out, nullptr);
     }
 }
 
 void GBRange::printHeaders() {
     for(auto &w : windows) {
-        printHeaderFull(w->dec.out,w->dec.trace,(compat_ver == CompatVer::V01x),model);
-        printHeaderFull(w->prim.out,w->prim.trace,false,model);
-        printHeaderFull(w->psi.out,w->psi.trace,false,model);
-        printHeaderRaw(w->dec.raw,w->prim.raw,model);
-        printHeaderNorm(w->dec.norm,w->prim.norm,model);
+        if (columnar) {
+            // The binary writers store the header line themselves; only the
+            // trace copies still get a text header.
+            printHeaderFull(nullptr,w->dec.trace,(compat_ver == CompatVer::V01x),model);
+            printHeaderFull(nullptr,w->prim.trace,false,model);
+            printHeaderFull(nullptr,w->psi.trace,false,model);
+        }
+        else {
+            printHeaderFull(w->dec.out,w->dec.trace,(compat_ver == CompatVer::V01x),model);
+            printHeaderFull(w->prim.out,w->prim.trace,false,model);
+            printHeaderFull(w->psi.out,w->psi.trace,false,model);
+            printHeaderRaw(w->dec.raw,w->prim.raw,model,rle_eps >= 0.0L);
+            printHeaderNorm(w->dec.norm,w->prim.norm,model,rle_eps >= 0.0L);
+        }
         printHeaderCps(w->dec.cps,(compat_ver == CompatVer::V01x));
         printHeaderCps(w->prim.cps,false);
         if(compat_ver != CompatVer::V01x) {
@@ -139,6 +206,10 @@ void GBRange::printHeaders() {
 
 void GBRange::printCpsSummaryHeaders() {
     printHeaderCpsSummary(decAgg.cps_summary,primAgg.cps_summary,model);
+    // Per-window summary streams (multi-alpha runs with the ALPHA macro)
+    for(auto &w : windows) {
+        printHeaderCpsSummary(w->dec.cps_summary,w->prim.cps_summary,model);
+    }
 }
 
 std::uint64_t GBRange::decReset(std::uint64_t n_start) {
@@ -203,6 +274,9 @@ std::uint64_t GBRange::psiReset(std::uint64_t n_start) {
         if(w->is_psi_active()) {
             need_reset = 1;
             w->psi.summary.reset();
+            if(w->psi_prefix) {
+                w->psi_prefix->markLeft();
+            }
         }
     }
     if(! need_reset) {
@@ -225,8 +299,137 @@ std::uint64_t GBRange::psiReset(std::uint64_t n_start) {
     return psiAgg.left;
 }
 
+// ----- Decade-granular checkpoint/restart -----
+// A snapshot is written right after the decade-boundary resets, so the
+// stored n is the left edge of the decade about to start and the resumed
+// loop replays exactly what the interrupted run would have done next.
+// Everything that evolves with n is covered: the three aggregates with
+// their HLCorr calculators, the shared HLCorr states, the left Euler
+// product cursor, and per window the crossing scalars, interval summaries
+// (with interpolator samples) and the right Euler product cursor.
+// Derived caches (EulerProductTable, AvailableDeficit tables) rebuild
+// deterministically and are not persisted.
+
+int GBRange::writeCheckpoint(std::uint64_t n) {
+    // Push buffered rows first so the files on disk cover everything up
+    // to the boundary when the shard is killed after this snapshot.
+    columnarFlushAll();
+    gbOutFlushAll();
+    const std::string tmp_path = std::string(checkpointPath) + ".tmp";
+    std::FILE *f = std::fopen(tmp_path.c_str(), "wb");
+    if (!f) {
+        std::perror(tmp_path.c_str());
+        return -1;
+    }
+    int rc = 0;
+    rc |= gbCkWrite(f, GB_CHECKPOINT_MAGIC, GB_CHECKPOINT_MAGIC_BYTES);
+    rc |= gbCkPut(f, n);
+    const int model_tag = (int)model;
+    const int compat_tag = (int)compat_ver;
+    const std::uint64_t window_count = windows.size();
+    rc |= gbCkPut(f, model_tag);
+    rc |= gbCkPut(f, compat_tag);
+    rc |= gbCkPut(f, window_count);
+    rc |= decAgg.checkpointWrite(f);
+    rc |= primAgg.checkpointWrite(f);
+    rc |= psiAgg.checkpointWrite(f);
+    rc |= gbCkPut(f, decState);
+    rc |= gbCkPut(f, primState);
+    rc |= gbCkPut(f, psiState);
+    rc |= product_series_left.checkpointWrite(f);
+    for (auto &w : windows) {
+        rc |= gbCkPut(f, w->alpha);
+        rc |= w->checkpointWrite(f);
+        if (rle_eps >= 0.0L) {
+            // Pending RLE runs are rows the flushed files do not carry
+            // yet; they must survive the restart or the runs get lost.
+            rc |= w->dec.rawRle.checkpointWrite(f);
+            rc |= w->dec.normRle.checkpointWrite(f);
+            rc |= w->prim.rawRle.checkpointWrite(f);
+            rc |= w->prim.normRle.checkpointWrite(f);
+        }
+    }
+    if (std::fclose(f) != 0) {
+        rc = -1;
+    }
+    if (rc == 0 && std::rename(tmp_path.c_str(), checkpointPath) != 0) {
+        std::perror(checkpointPath);
+        rc = -1;
+    }
+    if (rc != 0) {
+        std::fprintf(stderr, "Error: failed to write checkpoint %s\n", checkpointPath);
+    }
+    return rc;
+}
+
+int GBRange::restoreCheckpoint(std::uint64_t &n) {
+    std::FILE *f = std::fopen(checkpointResumePath, "rb");
+    if (!f) {
+        std::perror(checkpointResumePath);
+        return -1;
+    }
+    int rc = 0;
+    char magic[GB_CHECKPOINT_MAGIC_BYTES];
+    rc |= gbCkRead(f, magic, sizeof magic);
+    if (rc || std::memcmp(magic, GB_CHECKPOINT_MAGIC, sizeof magic) != 0) {
+        std::fprintf(stderr, "Error: %s is not a checkpoint file\n", checkpointResumePath);
+        std::fclose(f);
+        return -1;
+    }
+    rc |= gbCkGet(f, n);
+    int model_tag = 0, compat_tag = 0;
+    std::uint64_t window_count = 0;
+    rc |= gbCkGet(f, model_tag);
+    rc |= gbCkGet(f, compat_tag);
+    rc |= gbCkGet(f, window_count);
+    if (rc == 0 && (model_tag != (int)model || compat_tag != (int)compat_ver ||
+                    window_count != windows.size())) {
+        std::fprintf(stderr, "Error: checkpoint %s does not match this run"
+            " (model/compat/window configuration changed)\n", checkpointResumePath);
+        std::fclose(f);
+        return -1;
+    }
+    rc |= decAgg.checkpointRead(f);
+    rc |= primAgg.checkpointRead(f);
+    rc |= psiAgg.checkpointRead(f);
+    rc |= gbCkGet(f, decState);
+    rc |= gbCkGet(f, primState);
+    rc |= gbCkGet(f, psiState);
+    rc |= product_series_left.checkpointRead(f);
+    for (auto &w : windows) {
+        long double alpha = 0.0L;
+        rc |= gbCkGet(f, alpha);
+        if (rc == 0 && std::memcmp(&alpha, &w->alpha, sizeof alpha) != 0) {
+            std::fprintf(stderr, "Error: checkpoint %s was written with different"
+                " alpha windows\n", checkpointResumePath);
+            std::fclose(f);
+            return -1;
+        }
+        rc |= w->checkpointRead(f);
+        if (rle_eps >= 0.0L) {
+            rc |= w->dec.rawRle.checkpointRead(f);
+            rc |= w->dec.normRle.checkpointRead(f);
+            rc |= w->prim.rawRle.checkpointRead(f);
+            rc |= w->prim.normRle.checkpointRead(f);
+        }
+    }
+    std::fclose(f);
+    if (rc != 0) {
+        std::fprintf(stderr, "Error: failed to read checkpoint %s\n", checkpointResumePath);
+    }
+    return rc;
+}
+
 void GBRange::calcAverage(GBWindow &w,GBLongInterval &interval, GBAggregate &agg,  bool useLegacy) {
     GBLongIntervalSummary &summary = interval.summary;
+    summary.flushAggregates();
+    if(summary.usePrefixTotals && w.psi_prefix) {
+        // PSI: the interval totals are the difference of two running
+        // prefix values, so closing a wide interval costs the same as a
+        // narrow one.
+        summary.pairCountTotal = w.psi_prefix->pairCountTotal();
+        summary.pairCountTotalNorm = w.psi_prefix->normTotal();
+    }
     summary.pairCountAvg = summary.pairCountTotal / (agg.right - agg.left);
     summary.cAvg = summary.pairCountTotalNorm / (agg.right - agg.left);
     if(model != Model::HLA) {
@@ -254,6 +457,7 @@ void GBRange::outputFull(GBAggregate &agg,GBLongInterval &interval,bool useLegac
     if(! (interval.out || interval.trace)) {
         return;
     }
+    interval.summary.flushAggregates();
     // Skip output if aggregate is not properly initialized (empty label or zero n_geom)
     if(agg.label.empty() || agg.n_geom <= 0.0L) {
         return;
@@ -261,35 +465,45 @@ void GBRange::outputFull(GBAggregate &agg,GBLongInterval &interval,bool useLegac
     GBLongIntervalSummary &summary = interval.summary;
     // long double logN = logl((long double)(agg.right - 1));
     // long double logNlogN = logN*logN;
+    FILE *textOut = interval.out;
+    if (columnar && !useLegacy) {
+        outputFullColumnar(agg, interval);
+        if (!interval.trace) {
+            return;
+        }
+        textOut = nullptr; // text copy goes to the trace stream only
+    }
     if(! useLegacy) {
-        fprintf_both(interval.out,interval.trace,
-            (model == Model::Empirical) 
-                ? "%" PRIu64 ",%" PRIu64 ",%s,%" PRIu64 ",%.0Lf,%" PRIu64 ",%.0Lf,%" PRIu64 ",%.6Lf,%" PRIu64 ",%.8Lf,%.0Lf,%.6Lf,%.9Lf\n"
-                : "%" PRIu64 ",%" PRIu64 ",%s,%" PRIu64 ",%.3Lf,%" PRIu64 ",%.3Lf,%" PRIu64 ",%.6Lf,%" PRIu64 ",%.8Lf,%.0Lf,%.6Lf,%.9Lf,",
-            agg.left, agg.right -1,
-            agg.label.c_str(),
-            summary.pairCountMinima.n_last, summary.pairCountMinima.c_last,
-            summary.pairCountMaxima.n_first, summary.pairCountMaxima.c_first,
-            summary.cMinima.n_last, summary.cMinima.c_last,
-            summary.cMaxima.n_first, summary.cMaxima.c_first,
-            agg.n_geom,
-            summary.pairCountAvg,
-            summary.cAvg
-        );
+        const int countPrec = (model == Model::Empirical) ? 0 : 3;
+        RowBuf row;
+        row.u64(agg.left); row.sep();
+        row.u64(agg.right - 1); row.sep();
+        row.str(agg.label.c_str()); row.sep();
+        row.u64(summary.pairCountMinima.n_last); row.sep();
+        row.fixed(summary.pairCountMinima.c_last, countPrec); row.sep();
+        row.u64(summary.pairCountMaxima.n_first); row.sep();
+        row.fixed(summary.pairCountMaxima.c_first, countPrec); row.sep();
+        row.u64(summary.cMinima.n_last); row.sep();
+        row.fixed(summary.cMinima.c_last, 6); row.sep();
+        row.u64(summary.cMaxima.n_first); row.sep();
+        row.fixed(summary.cMaxima.c_first, 8); row.sep();
+        row.fixed(agg.n_geom, 0); row.sep();
+        row.fixed(summary.pairCountAvg, 6); row.sep();
+        row.fixed(summary.cAvg, 9);
         if (model != Model::Empirical) {
-            fprintf_both(interval.out,interval.trace,
-                "%" PRIu64 ",%.6Lf,%" PRIu64 ",%.8Lf,%" PRIu64 ",%.6Lf,%" PRIu64 ",%.8Lf,%.6LF\n",
-                summary.alignMinima.n_last,
-                std::max(0.0L, summary.alignMinima.c_last),  // Clamped for log plot compatibility
-                summary.alignMaxima.n_last,
-                std::max(0.0L, summary.alignMaxima.c_last),  // Clamped for log plot compatibility
-                summary.boundMinima.n_last,
-                std::max(0.0L, summary.boundMinima.c_last),  // Clamped for log plot compatibility
-                summary.boundMaxima.n_last,
-                std::max(0.0L, summary.boundMaxima.c_last),  // Clamped for log plot compatibility
-                summary.jitterLast
-            );
+            row.sep();
+            row.u64(summary.alignMinima.n_last); row.sep();
+            row.fixed(std::max(0.0L, summary.alignMinima.c_last), 6); row.sep();  // Clamped for log plot compatibility
+            row.u64(summary.alignMaxima.n_last); row.sep();
+            row.fixed(std::max(0.0L, summary.alignMaxima.c_last), 8); row.sep();  // Clamped for log plot compatibility
+            row.u64(summary.boundMinima.n_last); row.sep();
+            row.fixed(std::max(0.0L, summary.boundMinima.c_last), 6); row.sep();  // Clamped for log plot compatibility
+            row.u64(summary.boundMaxima.n_last); row.sep();
+            row.fixed(std::max(0.0L, summary.boundMaxima.c_last), 8); row.sep();  // Clamped for log plot compatibility
+            row.fixed(summary.jitterLast, 6);
         }
+        row.nl();
+        row.emit(textOut, interval.trace);
         return;
     }
     fprintf_both(interval.out,interval.trace,
@@ -315,19 +529,33 @@ void GBRange::outputRaw(GBAggregate &agg,GBLongInterval &interval) {
     if(agg.label.empty() || agg.n_geom <= 0.0L) {
         return;
     }
+    interval.summary.flushAggregates();
     if(interval.raw) {
+        if (columnar && compat_ver != CompatVer::V01x) {
+            outputRawColumnar(agg, interval);
+            return;
+        }
         GBLongIntervalSummary &summary = interval.summary;
-        std::fprintf(interval.raw,
-            (model == Model::Empirical)
-                ? "%" PRIu64 ",%" PRIu64 ",%s,%" PRIu64 ",%.0Lf,%" PRIu64 ",%.0Lf,%.0Lf,%.6Lf\n"
-                : "%" PRIu64 ",%" PRIu64 ",%s,%" PRIu64 ",%.3Lf,%" PRIu64 ",%.3Lf,%.0Lf,%.6Lf\n",
-            agg.left, agg.right -1,
-            agg.label.c_str(),
-            summary.pairCountMinima.n_last, summary.pairCountMinima.c_last,
-            summary.pairCountMaxima.n_first, summary.pairCountMaxima.c_first,
-            agg.n_geom,
-            summary.pairCountAvg
-        );
+        if (rle_eps >= 0.0L) {
+            rleAdd(interval, interval.rawRle, true, agg.left, agg.right - 1, agg.label,
+                summary.pairCountMinima.n_last, summary.pairCountMinima.c_last,
+                summary.pairCountMaxima.n_first, summary.pairCountMaxima.c_first,
+                agg.n_geom, summary.pairCountAvg);
+            return;
+        }
+        const int countPrec = (model == Model::Empirical) ? 0 : 3;
+        RowBuf row;
+        row.u64(agg.left); row.sep();
+        row.u64(agg.right - 1); row.sep();
+        row.str(agg.label.c_str()); row.sep();
+        row.u64(summary.pairCountMinima.n_last); row.sep();
+        row.fixed(summary.pairCountMinima.c_last, countPrec); row.sep();
+        row.u64(summary.pairCountMaxima.n_first); row.sep();
+        row.fixed(summary.pairCountMaxima.c_first, countPrec); row.sep();
+        row.fixed(agg.n_geom, 0); row.sep();
+        row.fixed(summary.pairCountAvg, 6);
+        row.nl();
+        row.emit(interval.raw, nullptr);
     }
 }
 
@@ -336,37 +564,287 @@ void GBRange::outputNorm(GBAggregate &agg,GBLongInterval &interval) {
     if(agg.label.empty() || agg.n_geom <= 0.0L) {
         return;
     }
+    interval.summary.flushAggregates();
     if(interval.norm) {
+        if (columnar && compat_ver != CompatVer::V01x) {
+            outputNormColumnar(agg, interval);
+            return;
+        }
         GBLongIntervalSummary &summary = interval.summary;
-        if (model == Model::Empirical) {
-            std::fprintf(interval.norm,
-                "%" PRIu64 ",%" PRIu64 ",%s,%" PRIu64 ",%.6Lf,%" PRIu64 ",%.8Lf,%.0Lf,%.9Lf\n",
-                agg.left, agg.right -1,
-                agg.label.c_str(),
+        if (rle_eps >= 0.0L) {
+            rleAdd(interval, interval.normRle, false, agg.left, agg.right - 1, agg.label,
                 summary.cMinima.n_first, summary.cMinima.c_first,
                 summary.cMaxima.n_last, summary.cMaxima.c_last,
-                agg.n_geom,
-                summary.cAvg );
+                agg.n_geom, summary.cAvg);
+            return;
+        }
+        RowBuf row;
+        row.u64(agg.left); row.sep();
+        row.u64(agg.right - 1); row.sep();
+        row.str(agg.label.c_str()); row.sep();
+        row.u64(summary.cMinima.n_first); row.sep();
+        row.fixed(summary.cMinima.c_first, 6); row.sep();
+        row.u64(summary.cMaxima.n_last); row.sep();
+        row.fixed(summary.cMaxima.c_last, 8); row.sep();
+        row.fixed(agg.n_geom, 0); row.sep();
+        row.fixed(summary.cAvg, 9);
+        row.nl();
+        row.emit(interval.norm, nullptr);
+    }
+}
+
+// --rle-eps: the raw/norm rows for long constant stretches collapse into
+// runs.  A row extends the pending run while each of its value columns is
+// within rle_eps (absolute) of the run's representative; otherwise the run
+// is written out with its REPEAT count and the row seeds a new run.  The
+// location columns (minAt, n_0, ...) move every row by construction, so
+// only the value columns take part in the comparison and the emitted row
+// keeps the representative's locations.
+void GBRange::rleAdd(GBLongInterval &interval, GBRleRun &run, bool isRaw,
+                     std::uint64_t first, std::uint64_t last, const std::string &label,
+                     std::uint64_t nA, long double vA, std::uint64_t nB, long double vB,
+                     long double n_geom, long double avg) {
+    if (run.pending &&
+        fabsl(vA - run.vA) <= rle_eps &&
+        fabsl(vB - run.vB) <= rle_eps &&
+        fabsl(avg - run.avg) <= rle_eps) {
+        run.last = last;
+        run.repeat++;
+        return;
+    }
+    if (run.pending) {
+        if (isRaw) {
+            rleEmitRaw(interval);
         }
         else {
-            std::fprintf(interval.norm,
-                "%" PRIu64 ",%" PRIu64 ",%s,%" PRIu64 ",%.6Lf,%" PRIu64 ",%.8Lf,%.0Lf,%.9Lf\n",
-                agg.left, agg.right -1,
-                agg.label.c_str(),
-                summary.cMinima.n_first, summary.cMinima.c_first,
-                summary.cMaxima.n_last, summary.cMaxima.c_last,
-                agg.n_geom,
-                summary.cAvg );
+            rleEmitNorm(interval);
+        }
+    }
+    run.pending = true;
+    run.first = first;
+    run.last = last;
+    run.repeat = 1;
+    run.label = label;
+    run.nA = nA;
+    run.vA = vA;
+    run.nB = nB;
+    run.vB = vB;
+    run.n_geom = n_geom;
+    run.avg = avg;
+}
+
+void GBRange::rleEmitRaw(GBLongInterval &interval) {
+    GBRleRun &run = interval.rawRle;
+    if (!run.pending) {
+        return;
+    }
+    run.pending = false;
+    if (!interval.raw) {
+        return;
+    }
+    const int countPrec = (model == Model::Empirical) ? 0 : 3;
+    RowBuf row;
+    row.u64(run.first); row.sep();
+    row.u64(run.last); row.sep();
+    row.str(run.label.c_str()); row.sep();
+    row.u64(run.nA); row.sep();
+    row.fixed(run.vA, countPrec); row.sep();
+    row.u64(run.nB); row.sep();
+    row.fixed(run.vB, countPrec); row.sep();
+    row.fixed(run.n_geom, 0); row.sep();
+    row.fixed(run.avg, 6); row.sep();
+    row.u64(run.repeat);
+    row.nl();
+    row.emit(interval.raw, nullptr);
+}
+
+void GBRange::rleEmitNorm(GBLongInterval &interval) {
+    GBRleRun &run = interval.normRle;
+    if (!run.pending) {
+        return;
+    }
+    run.pending = false;
+    if (!interval.norm) {
+        return;
+    }
+    RowBuf row;
+    row.u64(run.first); row.sep();
+    row.u64(run.last); row.sep();
+    row.str(run.label.c_str()); row.sep();
+    row.u64(run.nA); row.sep();
+    row.fixed(run.vA, 6); row.sep();
+    row.u64(run.nB); row.sep();
+    row.fixed(run.vB, 8); row.sep();
+    row.fixed(run.n_geom, 0); row.sep();
+    row.fixed(run.avg, 9); row.sep();
+    row.u64(run.repeat);
+    row.nl();
+    row.emit(interval.norm, nullptr);
+}
+
+void GBRange::rleFlush(GBLongInterval &interval) {
+    rleEmitRaw(interval);
+    rleEmitNorm(interval);
+}
+
+// --columnar layouts.  Types and per-column printf formats mirror the
+// fprintf calls above field for field, so gbcol2csv reproduces the CSV the
+// text streams would have written byte for byte.
+static const char *const columnar_full_emp_fmts[] = {
+    "%" PRIu64, "%" PRIu64, "%s", "%" PRIu64, "%.0Lf", "%" PRIu64, "%.0Lf",
+    "%" PRIu64, "%.6Lf", "%" PRIu64, "%.8Lf", "%.0Lf", "%.6Lf", "%.9Lf"
+};
+static const char *const columnar_full_hla_fmts[] = {
+    "%" PRIu64, "%" PRIu64, "%s", "%" PRIu64, "%.3Lf", "%" PRIu64, "%.3Lf",
+    "%" PRIu64, "%.6Lf", "%" PRIu64, "%.8Lf", "%.0Lf", "%.6Lf", "%.9Lf",
+    "%" PRIu64, "%.6Lf", "%" PRIu64, "%.8Lf", "%" PRIu64, "%.6Lf",
+    "%" PRIu64, "%.8Lf", "%.6LF"
+};
+static const char *const columnar_raw_emp_fmts[] = {
+    "%" PRIu64, "%" PRIu64, "%s", "%" PRIu64, "%.0Lf", "%" PRIu64, "%.0Lf", "%.0Lf", "%.6Lf"
+};
+static const char *const columnar_raw_hla_fmts[] = {
+    "%" PRIu64, "%" PRIu64, "%s", "%" PRIu64, "%.3Lf", "%" PRIu64, "%.3Lf", "%.0Lf", "%.6Lf"
+};
+static const char *const columnar_norm_fmts[] = {
+    "%" PRIu64, "%" PRIu64, "%s", "%" PRIu64, "%.6Lf", "%" PRIu64, "%.8Lf", "%.0Lf", "%.9Lf"
+};
+
+GBColumnarWriter* GBRange::columnarWriter(FILE *out, const char *header, const char *types, const char *const *formats) {
+    if (!out) {
+        return nullptr;
+    }
+    auto it = columnarWriters.find(out);
+    if (it != columnarWriters.end()) {
+        return &it->second;
+    }
+    GBColumnarWriter &w = columnarWriters[out];
+    if (gbColumnarWriterInit(&w, out, header, types, formats) != 0) {
+        std::fprintf(stderr, "Error: failed to set up columnar writer\n");
+        columnarWriters.erase(out);
+        return nullptr;
+    }
+    return &w;
+}
+
+void GBRange::columnarFlush(FILE *out) {
+    auto it = columnarWriters.find(out);
+    if (it != columnarWriters.end()) {
+        if (gbColumnarWriterClose(&it->second) != 0) {
+            std::fprintf(stderr, "Error: failed to write columnar output\n");
+        }
+        columnarWriters.erase(it);
+    }
+}
+
+void GBRange::columnarFlushAll() {
+    for (auto &e : columnarWriters) {
+        if (gbColumnarWriterClose(&e.second) != 0) {
+            std::fprintf(stderr, "Error: failed to write columnar output\n");
         }
     }
+    columnarWriters.clear();
+}
+
+void GBRange::outputFullColumnar(GBAggregate &agg, GBLongInterval &interval) {
+    GBLongIntervalSummary &summary = interval.summary;
+    summary.flushAggregates();
+    const bool emp = (model == Model::Empirical);
+    GBColumnarWriter *w = emp
+        ? columnarWriter(interval.out,
+            "FIRST,LAST,START,minAt,G(minAt),maxAt,G(maxAt),n_0,C_min(n_0),n_1,C_max(n_1),n_geom,<COUNT>,C_avg\n",
+            "uusufufufuffff", columnar_full_emp_fmts)
+        : columnarWriter(interval.out,
+            "FIRST,LAST,START,minAt*,Gpred(minAt*),maxAt*,Gpred(maxAt*),n_0*,Cpred_min(n_0*),n_1*,Cpred_max(n_1*),n_geom,<COUNT>*,Cpred_avg"
+                ",n_v,Calign_min(n_v),n_u,Calign_max(n_u),n_a,CboundMin(n_a),n_b,CboundMax(n_b),jitter\n",
+            "uusufufufuffffufufufuff", columnar_full_hla_fmts);
+    if (!w) {
+        return;
+    }
+    GBColValue row[23];
+    row[0].u = agg.left;
+    row[1].u = agg.right - 1;
+    row[2].s = agg.label.c_str();
+    row[3].u = summary.pairCountMinima.n_last;
+    row[4].f = summary.pairCountMinima.c_last;
+    row[5].u = summary.pairCountMaxima.n_first;
+    row[6].f = summary.pairCountMaxima.c_first;
+    row[7].u = summary.cMinima.n_last;
+    row[8].f = summary.cMinima.c_last;
+    row[9].u = summary.cMaxima.n_first;
+    row[10].f = summary.cMaxima.c_first;
+    row[11].f = agg.n_geom;
+    row[12].f = summary.pairCountAvg;
+    row[13].f = summary.cAvg;
+    if (!emp) {
+        row[14].u = summary.alignMinima.n_last;
+        row[15].f = std::max(0.0L, summary.alignMinima.c_last);
+        row[16].u = summary.alignMaxima.n_last;
+        row[17].f = std::max(0.0L, summary.alignMaxima.c_last);
+        row[18].u = summary.boundMinima.n_last;
+        row[19].f = std::max(0.0L, summary.boundMinima.c_last);
+        row[20].u = summary.boundMaxima.n_last;
+        row[21].f = std::max(0.0L, summary.boundMaxima.c_last);
+        row[22].f = summary.jitterLast;
+    }
+    gbColumnarWriterAppend(w, row);
+}
+
+void GBRange::outputRawColumnar(GBAggregate &agg, GBLongInterval &interval) {
+    GBLongIntervalSummary &summary = interval.summary;
+    summary.flushAggregates();
+    const bool emp = (model == Model::Empirical);
+    GBColumnarWriter *w = columnarWriter(interval.raw,
+        emp ? "FIRST,LAST,START,minAt,G(minAt),maxAt,G(maxAt),n_geom,<COUNT>\n"
+            : "FIRST,LAST,START,minAt*,Gpred(minAt*),maxAt*,Gpred(maxAt*),n_geom,<COUNT>*\n",
+        "uusufufff", emp ? columnar_raw_emp_fmts : columnar_raw_hla_fmts);
+    if (!w) {
+        return;
+    }
+    GBColValue row[9];
+    row[0].u = agg.left;
+    row[1].u = agg.right - 1;
+    row[2].s = agg.label.c_str();
+    row[3].u = summary.pairCountMinima.n_last;
+    row[4].f = summary.pairCountMinima.c_last;
+    row[5].u = summary.pairCountMaxima.n_first;
+    row[6].f = summary.pairCountMaxima.c_first;
+    row[7].f = agg.n_geom;
+    row[8].f = summary.pairCountAvg;
+    gbColumnarWriterAppend(w, row);
+}
+
+void GBRange::outputNormColumnar(GBAggregate &agg, GBLongInterval &interval) {
+    GBLongIntervalSummary &summary = interval.summary;
+    summary.flushAggregates();
+    GBColumnarWriter *w = columnarWriter(interval.norm,
+        (model == Model::Empirical)
+            ? "FIRST,LAST,START,n_0,C_min(n_0),n_1,C_max(n_1),n_geom,<COUNT>,C_avg\n"
+            : "FIRST,LAST,START,n_0*,Cpred_min(n_0*),n_1*,Cpred_max(n_1*),n_geom,Cpred_avg\n",
+        "uusufufff", columnar_norm_fmts);
+    if (!w) {
+        return;
+    }
+    GBColValue row[9];
+    row[0].u = agg.left;
+    row[1].u = agg.right - 1;
+    row[2].s = agg.label.c_str();
+    row[3].u = summary.cMinima.n_first;
+    row[4].f = summary.cMinima.c_first;
+    row[5].u = summary.cMaxima.n_last;
+    row[6].f = summary.cMaxima.c_last;
+    row[7].f = agg.n_geom;
+    row[8].f = summary.cAvg;
+    gbColumnarWriterAppend(w, row);
 }
 
 void GBRange::decOutputCpsSummary(GBWindow &w) {
-    if(! decAgg.cps_summary) {
+    FILE *out = w.dec.cps_summary ? w.dec.cps_summary : decAgg.cps_summary;
+    if(! out) {
         return;
     }
     //if(w->preMertens > 1 && w->dec.nstar > 1 && w->dec.deltaMertens > 0.0L) {
-        std::fprintf(decAgg.cps_summary,
+        gbOutPrintf(out,
             "%" PRIu64 ",%" PRIu64 ",%.12Lg,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%.6Lf\n",
             decAgg.n_start, decAgg.n_end,
             w.alpha,
@@ -460,10 +938,11 @@ int GBRange::decInputCpsSummary(const char* filename) {
 }
 
 void GBRange::primOutputCpsSummary(GBWindow &w) {
-    if(! primAgg.cps_summary) {
+    FILE *out = w.prim.cps_summary ? w.prim.cps_summary : primAgg.cps_summary;
+    if(! out) {
         return;
     }
-    std::fprintf(primAgg.cps_summary,
+    gbOutPrintf(out,
         "%" PRIu64 ",%" PRIu64 ",%.12Lg,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%.6Lf\n",
         primAgg.n_start, primAgg.n_end,
         w.alpha,
@@ -664,8 +1143,10 @@ int GBRange::addRow(
     }
 
     if (model == Model::Empirical) {
-        long double cminus = w.calcCminus(n,delta,logNlogN);
-        long double cminusAsymp = w.calcCminusAsymp(logN);
+        long double cminus = fastDouble ? w.calcCminusFast(n,delta,(double)logNlogN)
+                                        : instrCminus(w,n,delta,logNlogN);
+        long double cminusAsymp = fastDouble ? w.calcCminusAsympFast((double)logN)
+                                             : w.calcCminusAsymp(logN);
         long double pairCount = (long double)empiricalPairCount;
         long double c_of_n = pairCount * norm;
         // Only set values for active aggregates to avoid unnecessary work
@@ -798,22 +1279,106 @@ int GBRange::addRow(
             }
         }
     }
-    aggregate(w, n, delta, w.calcCminus(n,delta,logNlogN), w.calcCminusAsymp(logN));
+    const long double aggCminus = fastDouble ? w.calcCminusFast(n,delta,(double)logNlogN)
+                                             : instrCminus(w,n,delta,logNlogN);
+    const long double aggCminusAsymp = fastDouble ? w.calcCminusAsympFast((double)logN)
+                                                  : w.calcCminusAsymp(logN);
+    aggregate(w, n, delta, aggCminus, aggCminusAsymp);
     return 0;
 }
 
+// Times calcCminus when --instrument is active; otherwise a plain call.  The
+// Euler product series caches its interval, so the timing also exposes how
+// often an advance actually recomputes versus hits the cache.
+long double GBRange::instrCminus(GBWindow &w, std::uint64_t n, std::uint64_t delta, long double logNlogN)
+{
+    if (!instrument) {
+        return w.calcCminus(n,delta,logNlogN);
+    }
+    const std::uint64_t t0 = instr_now_ns();
+    long double cminus = w.calcCminus(n,delta,logNlogN);
+    w.instr.eulerCalls += 1;
+    w.instr.eulerNs += instr_now_ns() - t0;
+    return cminus;
+}
+
+// Dump the --instrument counters as CSV on stderr: one line per window plus a
+// line for the shared left Euler product (advanced serially in pool mode).
+void GBRange::printInstrumentation()
+{
+    std::fprintf(stderr, "# instrument,alpha,iter_calls,cursor_steps,euler_calls,euler_ns,dec_rows,prim_rows,psi_rows\n");
+    for(auto &w : windows) {
+        std::fprintf(stderr,
+            "instrument,%.6Lg,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+            w->alpha, w->instr.iterCalls, w->instr.cursorSteps,
+            w->instr.eulerCalls, w->instr.eulerNs,
+            w->instr.decRows, w->instr.primRows, w->instr.psiRows);
+    }
+    std::fprintf(stderr,
+        "instrument,left_series,0,0,%" PRIu64 ",%" PRIu64 ",0,0,0\n",
+        instrLeftCalls, instrLeftNs);
+}
+
+#ifndef HLCORR_USE_EXACT
+static HLCorrInterpolator& hlcorrEstimateFor(GBWindow &w, char stream) {
+    return (stream == 'p') ? w.prim.summary.hlCorrEstimate : w.dec.summary.hlCorrEstimate;
+}
+
+// Seed each listed interpolator from the persistent cache when it covers the
+// full sample grid; windows still needing a real pre-scan stay in the list.
+void GBRange::cacheSeedPrescan(std::vector<GBWindow*> &list, char stream)
+{
+    if (!hlcorrCache.enabled() || list.empty()) {
+        return;
+    }
+    std::vector<GBWindow*> remaining;
+    for (auto *w : list) {
+        const long double alpha = w->alpha;
+        bool seeded = hlcorrEstimateFor(*w, stream).seedFromCache(
+            [&](std::uint64_t n, long double &value) {
+                return hlcorrCache.get(alpha, (int)model, (int)compat_ver, stream, n, value);
+            });
+        if (!seeded) {
+            remaining.push_back(w);
+        }
+    }
+    list.swap(remaining);
+}
+
+// Fold samples collected by a pre-scan back into the cache for later shards.
+void GBRange::cacheAbsorbPrescan(const std::vector<GBWindow*> &list, char stream)
+{
+    if (!hlcorrCache.enabled()) {
+        return;
+    }
+    for (auto *w : list) {
+        for (const auto &s : hlcorrEstimateFor(*w, stream).getSamples()) {
+            hlcorrCache.put(w->alpha, (int)model, (int)compat_ver, stream, s.n, s.hlCorr);
+        }
+    }
+}
+#endif // HLCORR_USE_EXACT
+
 static inline void close(FILE *&out) {
-    if(out && out != stdout) {
-        std::fclose(out);
-        out = nullptr;
+    if(out) {
+        gbOutRelease(out); // push any buffered rows before the FILE goes away
+        if(out != stdout) {
+            std::fclose(out);
+            out = nullptr;
+        }
     }
 }
 
 void GBRange::prim_close() {
     primAgg.right = 0;
     for(auto &w : windows) {
+        columnarFlush(w->prim.out);
+        columnarFlush(w->prim.raw);
+        columnarFlush(w->prim.norm);
+        rleFlush(w->prim);
         w->closeInterval(w->prim);
         primOutputCpsSummary(*w);
+        close(w->prim.cps_summary);
     }
     close(primAgg.cps_summary);
 }
@@ -821,6 +1386,7 @@ void GBRange::prim_close() {
 void GBRange::psi_close() {
     psiAgg.right = 0;
     for(auto &w : windows) {
+        columnarFlush(w->psi.out);
         w->closeInterval(w->psi);
     }
 }
@@ -828,12 +1394,399 @@ void GBRange::psi_close() {
 void GBRange::dec_close() {
     decAgg.right = 0;
     for(auto &w : windows) {
+        columnarFlush(w->dec.out);
+        columnarFlush(w->dec.raw);
+        columnarFlush(w->dec.norm);
+        rleFlush(w->dec);
         w->closeInterval(w->dec);
         decOutputCpsSummary(*w);
+        close(w->dec.cps_summary);
     }
     close(decAgg.cps_summary);
 }
 
+// Fills hot.delta/hot.alpha_n for every window at this n in one pass over
+// the flat parallel arrays; the shared Euler-cap alpha(n) is computed once
+// for the whole sweep.  Mirrors GBWindow::computeDelta, which remains for
+// the boundary callers (geometric-midpoint output, HLCorr pre-scan).
+int GBRange::computeDeltas(std::uint64_t n) {
+    const long double nl = (long double)n;
+    const std::uint64_t max_delta = (n > 3) ? (n - 3) : 1;
+    long double eulerCapAlpha = 0.0L;
+    const std::size_t count = windows.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const long double alpha = hot.alpha[i];
+        std::uint64_t delta = (std::uint64_t)floorl(alpha*nl);
+        long double alpha_n = alpha;
+        if (hot.eulerCap[i]) {
+            if (eulerCapAlpha == 0.0L) {
+                eulerCapAlpha = 1.0L+(0.5L-sqrtl(2.0L*nl+0.25L))/nl; // alpha(n) = ((2n+1)-sqrt(8n+1))/(2n)
+            }
+            long double val = ceill(eulerCapAlpha*nl) - 1.0L;
+            std::uint64_t cap = (val < 1.0L) ? 1ULL : (std::uint64_t)val;
+            if (delta > cap) {
+                delta = cap;
+                alpha_n = eulerCapAlpha;
+            }
+        }
+        if ((compat_ver != CompatVer::V01x || alpha > 0.5L) && delta > max_delta) {
+            delta = max_delta;
+        }
+        if (delta == ~0ULL) {
+            return 2;
+        }
+        hot.delta[i] = delta;
+        hot.alpha_n[i] = alpha_n;
+    }
+    return 0;
+}
+
+// Count phase for windows[wbegin,wend) at a single n.  The first block (and
+// the bitmap kernel) produces absolute counts exactly like the serial sweep.
+// Later blocks exploit the nesting of the sorted windows: the previous
+// block's widest window already covered (inner, 2n-inner), so their cursors
+// are seeded just outside that boundary (innerLo/innerHi persist across n and
+// only nudge, since the boundary moves monotonically) and the zigzag counts
+// only the new stripe.  Stripe totals are cumulative within the block; the
+// row phase adds the block base.
+template<bool BITMAP, bool TRIVIAL>
+int GBRange::countWindowBlock(std::size_t wbegin, std::size_t wend, std::uint64_t n,
+    const std::uint64_t *&current, const std::uint64_t *&innerLo,
+    const std::uint64_t *&innerHi, bool &absolute)
+{
+    if constexpr (BITMAP) {
+        // Popcount kernel returns the full count per window; no
+        // cross-window accumulation or seeding needed.
+        absolute = true;
+        for (std::size_t i = wbegin; i < wend; ++i) {
+            const std::uint64_t delta = hot.delta[i];
+            std::uint64_t _pc = countRangedPairsBitmap(n, n - delta - 1, bitmap, bitmapBits);
+            if (_pc == ~0ULL) {
+                std::fprintf(stderr, "Failed to count pairs at %" PRIu64 "\n", n);
+                return -1;
+            }
+            if (TRIVIAL && (n & 1) && n >= 3 && ((n - 3) >> 1) < bitmapBits && is_odd_prime_fast(n, bitmap)) {
+                _pc += 1ULL;
+            }
+            hot.pairCount[i] = _pc;
+        }
+        return 0;
+    }
+    const std::uint64_t *lo = nullptr;
+    const std::uint64_t *hi = nullptr;
+    absolute = (wbegin == 0);
+    if (!absolute) {
+        const std::uint64_t inner = n - hot.delta[wbegin - 1] - 1;
+        const std::uint64_t target = (n << 1) - inner;
+        while (innerLo < primeArrayEndend && *innerLo <= inner) ++innerLo;
+        while (innerLo > primeArray && innerLo[-1] > inner) --innerLo;
+        while (innerHi < primeArrayEndend && *innerHi < target) ++innerHi;
+        while (innerHi > primeArray && innerHi[-1] >= target) --innerHi;
+        if (innerLo <= primeArray) {
+            absolute = true; // no prime at or below the boundary: count from scratch
+        }
+        else if (innerHi >= primeArrayEndend) {
+            std::fprintf(stderr, "Failed to count pairs at %" PRIu64 "\n", n);
+            return -1;
+        }
+        else {
+            lo = innerLo - 1;
+            hi = innerHi;
+        }
+    }
+    int need_trivial = (TRIVIAL && absolute) ? 1 : 0;
+    std::uint64_t running = 0;
+    for (std::size_t i = wbegin; i < wend; ++i) {
+        GBWindow &w = *windows[i];
+        const std::uint64_t delta = hot.delta[i];
+        const std::uint64_t *lo0 = lo;
+        const std::uint64_t *hi0 = hi;
+        std::uint64_t _pc = countRangedPairsIter(n, n - delta - 1, &current, primeArray, primeArrayEndend, &lo, &hi);
+        if (_pc == ~0ULL) {
+            std::fprintf(stderr, "Failed to count pairs at %" PRIu64 "\n", n);
+            return -1;
+        }
+        if (instrument) {
+            w.instr.iterCalls += 1;
+            if (lo) {
+                // Fresh cursors open a spread around n; resumed cursors
+                // only widen outward, so the pointer deltas are the walk.
+                w.instr.cursorSteps += hi0 ? (std::uint64_t)((hi - hi0) + (lo0 - lo))
+                                           : (std::uint64_t)(hi - lo - 1);
+            }
+        }
+        if (need_trivial && current > primeArray && current < primeArrayEndend && current[-1] == n) {
+            running += 1ULL + _pc;
+            need_trivial = 0;
+        }
+        else {
+            running += _pc;
+        }
+        hot.pairCount[i] = running;
+    }
+    return 0;
+}
+
+GBRange::CountFn GBRange::selectCountFn() const {
+    if (bitmap) {
+        return includeTrivial ? &GBRange::countWindowBlock<true,true>
+                              : &GBRange::countWindowBlock<true,false>;
+    }
+    return includeTrivial ? &GBRange::countWindowBlock<false,true>
+                          : &GBRange::countWindowBlock<false,false>;
+}
+
+// Row phase: turn the staged stripe totals into absolute counts and run the
+// per-window row work.  No kernel state; safe to fan out as soon as the
+// block bases are known.
+int GBRange::rowWindowBlock(std::size_t wbegin, std::size_t wend, std::uint64_t n,
+    long double logN, long double logNlogN, long double twoSGB_n, std::uint64_t base)
+{
+    for (std::size_t i = wbegin; i < wend; ++i) {
+        GBWindow &w = *windows[i];
+        w.alpha_n = hot.alpha_n[i];
+        int retval = addRow(w, n, hot.delta[i], logN, logNlogN, base + hot.pairCount[i], 0, twoSGB_n);
+        if (retval != 0) {
+            return retval;
+        }
+    }
+    return 0;
+}
+
+// Serial per-n window sweep; same loop the worker pool runs in blocks, plus
+// the HL-A model path that only positions the cursor.
+template<Model MODEL, bool BITMAP, bool TRIVIAL>
+int GBRange::sweepWindows(std::uint64_t n, long double twoSGB_n, const std::uint64_t *&current)
+{
+    int need_trivial = TRIVIAL;
+    std::uint64_t empiricalPairCount = 0;
+    std::uint64_t trivialPairCount = 0;
+    // we use pointers here, so we know where we left off.
+    const std::uint64_t *lo = nullptr;
+    const std::uint64_t *hi = nullptr;
+    long double logN = 0.0L;
+    long double logNlogN = 0.0L;
+    const std::size_t count = windows.size();
+    for(std::size_t i = 0; i < count; ++i) {
+        GBWindow &w = *windows[i];
+        const std::uint64_t delta = hot.delta[i];
+        w.alpha_n = hot.alpha_n[i];
+        if constexpr (MODEL == Model::Empirical && BITMAP) {
+            // Popcount kernel returns the full count per window; no
+            // cross-window accumulation needed.
+            std::uint64_t _pc = countRangedPairsBitmap(n, n - delta - 1, bitmap, bitmapBits);
+            if (_pc == ~0ULL) {
+                std::fprintf(stderr, "Failed to count pairs at %" PRIu64 "\n", n);
+                return -1;
+            }
+            empiricalPairCount = _pc;
+            if (need_trivial && (n & 1) && n >= 3 && ((n - 3) >> 1) < bitmapBits && is_odd_prime_fast(n, bitmap)) {
+                empiricalPairCount += 1ULL;
+            }
+        }
+        else if constexpr (MODEL == Model::Empirical) {
+            const std::uint64_t *lo0 = lo;
+            const std::uint64_t *hi0 = hi;
+            std::uint64_t _pc = countRangedPairsIter(n, n - delta - 1, &current, primeArray, primeArrayEndend, &lo, &hi);
+            if (_pc == ~0ULL) {
+                std::fprintf(stderr, "Failed to count pairs at %" PRIu64 "\n", n);
+                return -1;
+            }
+            if (instrument) {
+                w.instr.iterCalls += 1;
+                if (lo) {
+                    w.instr.cursorSteps += hi0 ? (std::uint64_t)((hi - hi0) + (lo0 - lo))
+                                               : (std::uint64_t)(hi - lo - 1);
+                }
+            }
+            if (need_trivial && current > primeArray && current < primeArrayEndend && current[-1] == n) {
+                empiricalPairCount += 1ULL+_pc;
+                need_trivial = 0;
+            }
+            else {
+                empiricalPairCount += _pc;
+            }
+        }
+        else if (need_trivial) {
+            need_trivial = 0;
+            // simply called to position the current pointer
+            countRangedPairs(n, n, &current, primeArray, primeArrayEndend);
+            if (current > primeArray && current < primeArrayEndend && current[-1] == n) {
+                trivialPairCount = 1;
+            }
+        }
+        if(logN == 0.0L) {
+            logN = fastDouble ? (long double)log((double)n) : logl((long double)n);
+            logNlogN = logN*logN;
+        }
+        int retval = addRow(w, n, delta, logN, logNlogN, empiricalPairCount, trivialPairCount, twoSGB_n);
+        if(retval != 0) {
+            return retval;
+        }
+    }
+    return 0;
+}
+
+GBRange::SweepFn GBRange::selectSweep() const {
+    if (model == Model::Empirical) {
+        if (bitmap) {
+            return includeTrivial ? &GBRange::sweepWindows<Model::Empirical,true,true>
+                                  : &GBRange::sweepWindows<Model::Empirical,true,false>;
+        }
+        return includeTrivial ? &GBRange::sweepWindows<Model::Empirical,false,true>
+                              : &GBRange::sweepWindows<Model::Empirical,false,false>;
+    }
+    return includeTrivial ? &GBRange::sweepWindows<Model::HLA,false,true>
+                          : &GBRange::sweepWindows<Model::HLA,false,false>;
+}
+
+// Fans the per-n window sweep out across contiguous alpha blocks.  Each worker
+// owns its block's cursor state for the lifetime of the run; the main thread
+// stays responsible for interval-boundary output and resets, so only the
+// independent per-window work runs concurrently.
+struct WindowWorkerPool {
+    struct Worker {
+        std::size_t wbegin = 0;
+        std::size_t wend = 0;
+        const std::uint64_t *current = nullptr;
+        const std::uint64_t *innerLo = nullptr;  // boundary cursors for stripe counting
+        const std::uint64_t *innerHi = nullptr;
+        std::uint64_t base = 0;                  // absolute count at wbegin-1
+        bool absolute = false;                   // count phase produced absolute totals
+        std::uint64_t generation = 0;
+    };
+
+    GBRange &range;
+    std::vector<Worker> workers;
+    std::vector<std::thread> threads;
+    std::mutex lock;
+    std::condition_variable start_cv, done_cv;
+    std::uint64_t generation = 0;
+    int pending = 0;
+    int phase = 0; // 1 = count, 2 = rows
+    bool shutdown = false;
+    std::uint64_t job_n = 0;
+    long double job_logN = 0.0L;
+    long double job_logNlogN = 0.0L;
+    long double job_twoSGB = 0.0L;
+    std::atomic<int> error{0};
+
+    GBRange::CountFn countFn;
+
+    WindowWorkerPool(GBRange &r, int numThreads) : range(r), countFn(r.selectCountFn()) {
+        // Contiguous blocks balanced by alpha weight: per-window cost scales
+        // with delta, so wide windows get proportionally fewer neighbours.
+        const std::size_t count = range.windows.size();
+        std::size_t nthreads = (std::size_t)numThreads;
+        if (nthreads > count) {
+            nthreads = count;
+        }
+        long double total = 0.0L;
+        for (auto &w : range.windows) {
+            total += w->alpha + 0.01L;
+        }
+        std::size_t begin = 0;
+        long double acc = 0.0L;
+        for (std::size_t t = 0; t < nthreads; ++t) {
+            const long double target = total * (long double)(t + 1) / (long double)nthreads;
+            acc += range.windows[begin]->alpha + 0.01L;
+            std::size_t end = begin + 1;
+            while (end < count && count - end > nthreads - t - 1 && acc < target) {
+                acc += range.windows[end]->alpha + 0.01L;
+                ++end;
+            }
+            if (t + 1 == nthreads) {
+                end = count;
+            }
+            Worker w;
+            w.wbegin = begin;
+            w.wend = end;
+            workers.push_back(w);
+            begin = end;
+        }
+        for (auto &w : workers) {
+            threads.emplace_back(&WindowWorkerPool::workerLoop, this, &w);
+        }
+    }
+
+    ~WindowWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lk(lock);
+            shutdown = true;
+        }
+        start_cv.notify_all();
+        for (auto &t : threads) {
+            t.join();
+        }
+    }
+
+    void init(const std::uint64_t *primeArray) {
+        for (auto &w : workers) {
+            w.current = primeArray;
+            w.innerLo = primeArray;
+            w.innerHi = primeArray;
+        }
+    }
+
+    void workerLoop(Worker *w) {
+        for (;;) {
+            std::unique_lock<std::mutex> lk(lock);
+            start_cv.wait(lk, [&]{ return shutdown || w->generation != generation; });
+            if (shutdown) {
+                return;
+            }
+            w->generation = generation;
+            const int ph = phase;
+            lk.unlock();
+            int rc = (ph == 1)
+                ? (range.*countFn)(w->wbegin, w->wend, job_n, w->current, w->innerLo, w->innerHi, w->absolute)
+                : range.rowWindowBlock(w->wbegin, w->wend, job_n, job_logN, job_logNlogN, job_twoSGB, w->base);
+            if (rc != 0) {
+                error.store(rc);
+            }
+            lk.lock();
+            if (--pending == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+
+    void dispatch(int ph) {
+        {
+            std::lock_guard<std::mutex> lk(lock);
+            phase = ph;
+            pending = (int)workers.size();
+            ++generation;
+        }
+        start_cv.notify_all();
+        std::unique_lock<std::mutex> lk(lock);
+        done_cv.wait(lk, [&]{ return pending == 0; });
+    }
+
+    int run(std::uint64_t n, long double logN, long double logNlogN, long double twoSGB_n) {
+        {
+            std::lock_guard<std::mutex> lk(lock);
+            job_n = n;
+            job_logN = logN;
+            job_logNlogN = logNlogN;
+            job_twoSGB = twoSGB_n;
+        }
+        dispatch(1);
+        if (int rc = error.load()) {
+            return rc;
+        }
+        // Prefix the block bases: a later block's stripes sit on top of the
+        // cumulative total at the previous block's widest window.
+        std::uint64_t base = 0;
+        for (auto &w : workers) {
+            w.base = w.absolute ? 0ULL : base;
+            base = w.base + (w.wend > w.wbegin ? range.hot.pairCount[w.wend - 1] : 0ULL);
+        }
+        dispatch(2);
+        return error.load();
+    }
+};
+
 int GBRange::processRows() {
     const std::uint64_t* current = primeArray;
     bool prim_is_active = false;
@@ -845,7 +1798,7 @@ int GBRange::processRows() {
         if(w->is_dec_active()) {
             dec_is_active = true;
         }
-        else if(decAgg.cps_summary) {
+        else if(decAgg.cps_summary || w->dec.cps_summary) {
             w->dec.out = std::fopen("/dev/null", "w");
             w->dec.active = true;
             dec_is_active = true;
@@ -857,7 +1810,7 @@ int GBRange::processRows() {
         if(w->is_prim_active()) {
             prim_is_active = true;
         }
-        else if(primAgg.cps_summary) {
+        else if(primAgg.cps_summary || w->prim.cps_summary) {
             w->prim.out = std::fopen("/dev/null", "w");
             w->prim.active = true;
             prim_is_active = true;
@@ -878,6 +1831,9 @@ int GBRange::processRows() {
         std::fprintf(stderr, "Error: No output streams configured. At least one of decade, primorial, or psi output must be specified.\n");
         return -1;
     }
+    if (hlcorrCache.enabled() && hlcorrCache.load() != 0) {
+        return -1;
+    }
     n_start = decAgg.left;
     n_end = decAgg.n_end;
     if (prim_is_active) {
@@ -891,6 +1847,36 @@ int GBRange::processRows() {
     for(auto &w : windows) {
         w->preMertens = w->preMertensAsymp = n_start - 1;
     }
+    // With a sampled pi(x) index the cursor starts at the first prime past
+    // n_start instead of linearly scanning up from the start of the array.
+    if (primeIndex) {
+        current = primeIndexSeekGT(primeIndex, primeArray, primeArrayEndend, n_start);
+    }
+    // Optional parallel mode: fan each n out across alpha-window blocks.
+    // Restricted to the empirical model without pointwise bound output, where
+    // per-window work is independent once the shared left Euler product and
+    // twoSGB values are computed serially.
+    std::unique_ptr<WindowWorkerPool> pool;
+    if (numThreads > 1 && windows.size() > 1 && model == Model::Empirical) {
+        bool needPointwise = false;
+        if (compat_ver != CompatVer::V01x) {
+            for(auto &w : windows) {
+                if (w->prim.boundRatioMin || w->prim.boundRatioMax || w->dec.boundRatioMin || w->dec.boundRatioMax) {
+                    needPointwise = true;
+                }
+            }
+        }
+        if (!needPointwise) {
+            pool = std::make_unique<WindowWorkerPool>(*this, numThreads);
+            pool->init(current);
+        }
+    }
+    if (numThreads > 1 && !pool) {
+        std::fprintf(stderr, "Warning: --threads requires the empirical model without pointwise bound output and multiple windows; running single-threaded.\n");
+    }
+    // Pick the window-sweep instantiation once; model, bitmap mode and
+    // trivial-pair handling are fixed for the whole run.
+    const SweepFn sweep = selectSweep();
     // Prescan now happens in decReset() and primReset() for each aggregate block
     std::vector<GBWindow*> dec_windows_to_prescan; 
     std::vector<GBWindow*> prim_windows_to_prescan;
@@ -912,7 +1898,73 @@ int GBRange::processRows() {
         }
     }
 #endif // HLCORR_USE_EXACT
-    for (std::uint64_t n = n_start; n < n_end; ) {
+    // --stream gate.  The HLCorr pre-scans sample deltas across the whole
+    // range before the first row, so they need the full stream up front;
+    // otherwise the gate only holds each n until the sieve covers 2n.
+    std::uint64_t streamSafeN = streamWaitFn ? 0 : ~0ULL;
+    if (streamWaitFn && (!dec_windows_to_prescan.empty() || !prim_windows_to_prescan.empty())) {
+        streamSafeN = streamWaitFn(streamWaitCtx, n_end - 1);
+        if (streamSafeN < n_end - 1) {
+            std::fprintf(stderr, "Error: prime stream ends before the pre-scan coverage at %" PRIu64 "\n", n_end - 1);
+            return -1;
+        }
+    }
+    // --checkpoint-resume: overwrite the freshly initialized engine state
+    // with the decade-boundary snapshot and continue from its n.  n_start
+    // itself stays at the configured range start (the cps outputs report
+    // it), only the loop entry point moves.
+    std::uint64_t first_n = n_start;
+    if (checkpointResumePath) {
+        if (restoreCheckpoint(first_n) != 0) {
+            return -1;
+        }
+        if (first_n < n_start || first_n >= n_end) {
+            std::fprintf(stderr, "Error: checkpoint n=%" PRIu64 " is outside the configured range\n", first_n);
+            return -1;
+        }
+        // The restored interpolators already carry their samples; only the
+        // streams whose interval begins exactly at the checkpoint still owe
+        // a pre-scan, mirroring what the boundary code re-registers for the
+        // HLA model.
+        dec_windows_to_prescan.clear();
+        prim_windows_to_prescan.clear();
+        psi_windows_to_prescan.clear();
+        if (model == Model::HLA && compat_ver != CompatVer::V01x) {
+            for (auto &w : windows) {
+                if (w->is_dec_active() && first_n == decAgg.left) {
+                    dec_windows_to_prescan.push_back(w.get());
+                }
+                if (w->is_prim_active() && first_n == primAgg.left) {
+                    prim_windows_to_prescan.push_back(w.get());
+                }
+                if (w->is_psi_active() && first_n == psiAgg.left) {
+                    psi_windows_to_prescan.push_back(w.get());
+                }
+            }
+        }
+        if (primeIndex) {
+            current = primeIndexSeekGT(primeIndex, primeArray, primeArrayEndend, first_n);
+        }
+    }
+    // --readahead anchor: kept just past n so the WILLNEED hints cover the
+    // pages the upper window cursors (up to ~(1+alpha)n) are heading into.
+    const std::uint64_t *prefetchCursor = current;
+    for (std::uint64_t n = first_n; n < n_end; ) {
+        if (n > streamSafeN) {
+            streamSafeN = streamWaitFn(streamWaitCtx, n);
+            if (n > streamSafeN) {
+                std::fprintf(stderr, "Error: prime stream ends before 2n coverage at %" PRIu64 "\n", n);
+                return -1;
+            }
+        }
+        if (prefetchFn && readaheadBytes) {
+            while (prefetchCursor < primeArrayEndend && *prefetchCursor <= n) {
+                ++prefetchCursor;
+            }
+            if (!(n & 0x3FF)) {
+                prefetchFn(prefetchCtx, prefetchCursor, readaheadBytes);
+            }
+        }
         // Reset at the beginning of each new range (needed to fix minAt bug)
         for(auto & w : windows) {
             if (w->is_dec_active() && n == decAgg.left) {
@@ -928,21 +1980,25 @@ int GBRange::processRows() {
 #ifndef HLCORR_USE_EXACT
         if(compat_ver != CompatVer::V01x) {
             if(! dec_windows_to_prescan.empty()) {
+                cacheSeedPrescan(dec_windows_to_prescan, 'd');
                 for(std::uint64_t i = n,next_n; i < n_end; i = next_n) {
                     next_n = n_end;
                     for(auto &w : dec_windows_to_prescan) {
                         w->dec.summary.hlCorrEstimate.prescan(i, next_n,[&w](long double n) { return w->computeDelta(n); });
                     }
                 }
+                cacheAbsorbPrescan(dec_windows_to_prescan, 'd');
                 dec_windows_to_prescan.clear();
             }
             if(! prim_windows_to_prescan.empty()) {
+                cacheSeedPrescan(prim_windows_to_prescan, 'p');
                 for(std::uint64_t i = n,next_n; i < n_end; i = next_n) {
                     next_n = n_end;
                     for(auto &w : prim_windows_to_prescan) {
                         w->prim.summary.hlCorrEstimate.prescan(i, next_n,[&w](long double n) { return w->computeDelta(n); });
                     }
                 }
+                cacheAbsorbPrescan(prim_windows_to_prescan, 'p');
                 prim_windows_to_prescan.clear();
             }
             if(! psi_windows_to_prescan.empty()) {
@@ -961,54 +2017,43 @@ int GBRange::processRows() {
             std::fprintf(stderr, "Failed HL-A prediction at %" PRIu64 "\n", n);
             return -1;
         }
-        int need_trivial = includeTrivial;
-        std::uint64_t empiricalPairCount = 0;
-        std::uint64_t trivialPairCount = 0;
-        // we use pointers here, so we know where we left off.
-        const std::uint64_t *lo = nullptr;
-        const std::uint64_t *hi = nullptr;
+        // One contiguous pass over the hot arrays; the sweep (and every
+        // pool worker block) then reads the deltas instead of recomputing
+        // them per window.
+        {
+            int rc = computeDeltas(n);
+            if (rc != 0) {
+                return rc;
+            }
+        }
         // Here is where we add a loop if we needed to support multiple windows,
         // as twoSGB_n is alpha independant and does not need to be recomputed.
         bool need_decReset = false;
         bool need_primReset = false;
         bool need_psiReset = false;
-        long double logN = 0.0L;
-        long double logNlogN = 0.0L;
-        long double eulerCapAlpha = 0.0L;
-        for(auto & w : windows) {
-            std::uint64_t delta = w->computeDelta(n,eulerCapAlpha);
-            if (delta == ~0ULL) {
-                return 2;
-            }
-            if (model == Model::Empirical) {
-                std::uint64_t _pc = countRangedPairsIter(n, n - delta - 1, &current, primeArray, primeArrayEndend, &lo, &hi);
-                if (_pc == ~0ULL) {
-                    std::fprintf(stderr, "Failed to count pairs at %" PRIu64 "\n", n);
-                    return -1;
-                }
-                if (need_trivial && current > primeArray && current < primeArrayEndend && current[-1] == n) {
-                    empiricalPairCount += 1ULL+_pc;
-                    need_trivial = 0;
-                }
-                else {
-                    empiricalPairCount += _pc;
-                }
+        if (pool) {
+            const long double logN = fastDouble ? (long double)log((double)n) : logl((long double)n);
+            const long double logNlogN = logN*logN;
+            // Advance the shared left product serially so worker reads hit
+            // the cached interval.
+            if (instrument) {
+                const std::uint64_t t0 = instr_now_ns();
+                product_series_left(n);
+                instrLeftCalls += 1;
+                instrLeftNs += instr_now_ns() - t0;
             }
-            else if (need_trivial) {
-                need_trivial = 0;
-                // simply called to position the current pointer
-                countRangedPairs(n, n, &current, primeArray, primeArrayEndend);
-                if (current > primeArray && current < primeArrayEndend && current[-1] == n) {
-                    trivialPairCount = 1;
-                }
+            else {
+                product_series_left(n);
             }
-            if(logN == 0.0L) {
-                logN = logl((long double)n); 
-                logNlogN = logN*logN;
+            int rc = pool->run(n, logN, logNlogN, twoSGB_n);
+            if (rc != 0) {
+                return rc;
             }
-            int retval = addRow(*w, n, delta, logN, logNlogN, empiricalPairCount, trivialPairCount, twoSGB_n);
-            if(retval != 0) {
-                return retval;
+        }
+        else {
+            int rc = (this->*sweep)(n, twoSGB_n, current);
+            if (rc != 0) {
+                return rc;
             }
         }
         n++;
@@ -1056,6 +2101,7 @@ int GBRange::processRows() {
                 }
             }
         }
+        const bool stream_boundary = need_decReset || need_primReset || need_psiReset;
         if(need_decReset) {
             decReset(decAgg.right);
             need_decReset = false;
@@ -1068,6 +2114,32 @@ int GBRange::processRows() {
             psiReset(psiAgg.right);
             need_psiReset = false;
         }
+        // --checkpoint: snapshot right after the boundary resets, so every
+        // output row on every stream is covered by the checkpoint that
+        // immediately follows it and a resume never re-emits rows.  Decade
+        // boundaries dominate; the primorial/psi boundaries between them
+        // are snapshotted too for the same no-duplicates property.
+        if (stream_boundary && checkpointPath && n < n_end) {
+            if (writeCheckpoint(n) != 0) {
+                return -1;
+            }
+        }
+    }
+    if (instrument) {
+        printInstrumentation();
+    }
+    // --rle-eps: a range that ends off a decade boundary never reaches
+    // dec_close/prim_close, so emit the runs still pending here.
+    if (rle_eps >= 0.0L) {
+        for(auto &w : windows) {
+            rleFlush(w->dec);
+            rleFlush(w->prim);
+        }
+    }
+    columnarFlushAll();
+    gbOutFlushAll(); // trace and bound-ratio streams are never fclose()d
+    if (hlcorrCache.dirty() && hlcorrCache.save() != 0) {
+        return -1;
     }
     return 0;
 }
@@ -22,10 +22,12 @@
 #include <cctype>
 #include <cinttypes>
 #include <vector>
+#include <map>
 #include <memory>
 
 #include "gbwindow.hpp"
 #include "hlcorrstate.hpp"
+#include "hlcorrcache.hpp"
 #include "gbdecade.hpp"
 #include "gbprimorial.hpp"
 #include "gbpsi.hpp"
@@ -40,6 +42,69 @@ public:
     
     bool includeTrivial = false;
     int eulerCap = 1;
+    int numThreads = 1;
+
+    // Opt-in hot-path instrumentation (--instrument): per-window counters in
+    // GBWindow::instr plus the shared left-product totals below, dumped as a
+    // CSV profile on stderr when processRows() finishes.
+    bool instrument = false;
+
+    // Write the full/raw/norm interval streams in the binary columnar
+    // format (--columnar) instead of CSV; gbcol2csv converts back.
+    bool columnar = false;
+
+    // --rle-eps: run-length encode the raw/norm interval streams.  A row
+    // is emitted only when a value column moves more than this epsilon
+    // away from the pending run's representative row; collapsed rows are
+    // accounted for in an appended REPEAT column.  Negative = disabled
+    // (every row emitted, no REPEAT column).
+    long double rle_eps = -1.0L;
+
+    // --precision=double: evaluate the per-n transcendental chains (logN,
+    // cminus, cminusAsymp) in double via the GBWindow fast variants
+    // instead of long double.  Window structure (delta) and the stream
+    // summaries stay long double, so only the model curves lose bits.
+    bool fastDouble = false;
+
+    // Optional odd-prime bitmap for the popcount pair-counting kernel.
+    const std::uint8_t *bitmap = nullptr;
+    std::uint64_t bitmapBits = 0;
+
+    // Optional sampled pi(x) index (primeindex tool) for O(1) cursor seeding.
+    const PrimeIndex *primeIndex = nullptr;
+
+    // Optional prime-array readahead (--readahead): the row loop keeps a
+    // cheap cursor just past n and periodically asks the owner of the
+    // mapping to make the next readaheadBytes resident before the window
+    // cursors stride into them.  A plain callback keeps GBRange free of
+    // the mmap wrapper type, which lives in gbpairsummary.cpp.
+    typedef void (*PrefetchFn)(void *ctx, const std::uint64_t *cursor, std::size_t bytes);
+    PrefetchFn prefetchFn = nullptr;
+    void *prefetchCtx = nullptr;
+    std::size_t readaheadBytes = 0;
+
+    // --stream gate: blocks until the gbpipeline producer has published
+    // primes covering 2n (with seek slack) and returns the largest n that
+    // may be processed before gating again.  Same callback shape as the
+    // prefetch hook, for the same reason.
+    typedef std::uint64_t (*StreamWaitFn)(void *ctx, std::uint64_t n);
+    StreamWaitFn streamWaitFn = nullptr;
+    void *streamWaitCtx = nullptr;
+
+    // Decade-granular checkpointing.  --checkpoint writes a full engine
+    // snapshot (aggregates, HLCorr calculators, per-window summaries and
+    // Euler product cursors) to checkpointPath at every decade boundary,
+    // atomically via a .tmp rename.  --checkpoint-resume restores one and
+    // continues from its n bit-exactly, so a preempted shard loses at
+    // most the decade in flight.  Pair the resume with --append so the
+    // already-written output rows are kept.
+    const char *checkpointPath = nullptr;
+    const char *checkpointResumePath = nullptr;
+
+    // Optional persistent HLCorr sample cache (--hlcorr-cache): seeds the
+    // pre-scan interpolators from a previous shard's samples and writes any
+    // newly scanned samples back for the next one.
+    HLCorrCache hlcorrCache;
 
     GBDecade decAgg;
     GBPrimorial primAgg;
@@ -56,9 +121,27 @@ public:
         eulerCap = _eulerCap;
 
         product_series_left.init(primeArray,primeArrayEndend);
-        for(auto &w : windows) {
-            bool w_eulerCap = (eulerCap > 0) || (eulerCap < 0 && (compat_ver != CompatVer::V01x || w->alpha > 0.5L));
-            w->init(primeArray,primeArrayEndend,w_eulerCap);
+        hot.alpha.resize(windows.size());
+        hot.alpha_n.resize(windows.size());
+        hot.delta.resize(windows.size());
+        hot.eulerCap.resize(windows.size());
+        hot.pairCount.resize(windows.size());
+        for(std::size_t i = 0; i < windows.size(); ++i) {
+            GBWindow &w = *windows[i];
+            bool w_eulerCap = (eulerCap > 0) || (eulerCap < 0 && (compat_ver != CompatVer::V01x || w.alpha > 0.5L));
+            w.init(primeArray,primeArrayEndend,w_eulerCap);
+            hot.alpha[i] = w.alpha;
+            hot.alpha_n[i] = w.alpha;
+            hot.eulerCap[i] = w_eulerCap ? 1 : 0;
+        }
+        // PSI prefix-sum store: one slot per window, wired before the
+        // first psiReset() so the opening interval samples a zero prefix.
+        // The summaries' running totals are skipped for psi from here on;
+        // calcAverage() reads the prefix differences instead.
+        psiAgg.prefix.assign(windows.size(), GBPSIPrefix());
+        for(std::size_t i = 0; i < windows.size(); ++i) {
+            windows[i]->psi_prefix = &psiAgg.prefix[i];
+            windows[i]->psi.summary.usePrefixTotals = true;
         }
         decReset(decAgg.left);
         primReset(primAgg.left);
@@ -86,7 +169,25 @@ private:
     std::uint64_t* primeArray = nullptr;
     const std::uint64_t* primeArrayEndend  = nullptr;
     std::size_t    primeArrayEndlen  = 0;
+
+    // Hot per-window sweep state hoisted out of GBWindow into parallel
+    // arrays, so the per-n delta pass walks contiguous memory instead of
+    // chasing a unique_ptr per window.  Filled by init() and refreshed
+    // once per n by computeDeltas(); the GBWindow objects keep the cold
+    // output state (FILE*s, summaries), and their alpha_n is synced in
+    // the sweep just before addRow reads it.
+    struct {
+        std::vector<long double> alpha;
+        std::vector<long double> alpha_n;
+        std::vector<std::uint64_t> delta;
+        std::vector<std::uint8_t> eulerCap;
+        std::vector<std::uint64_t> pairCount; // pool count phase: stripe totals
+    } hot;
+    int computeDeltas(std::uint64_t n);
+
     HLCorrState primState, decState, psiState;
+    std::uint64_t instrLeftCalls = 0;
+    std::uint64_t instrLeftNs = 0;
     AvailableDeficit deficitPredictive{2ULL, true, true, 2ULL, true, true, 20, 0ULL};  // residue=2, allow_reductions=true, use_short_interval=true, residue_tail=2, allow_tail_reductions=true, tenting=true, exposure=20
     AvailableDeficit deficitConservativePos{2ULL, true, true, 2ULL, false, false, 20, 1ULL};  // residue=2, allow_reductions=true, use_short_interval=true, residue_tail=1, allow_tail_reductions=false, tenting=false, exposure=20
     AvailableDeficit deficitConservativeNeg{2ULL, true, true, 2ULL, false, false, 20, 1ULL};  // residue=2, allow_reductions=true, use_short_interval=true, residue_tail=1, allow_tail_reductions=false, tenting=false, exposure=20 (for minimas we use residue 2)
@@ -103,12 +204,19 @@ private:
         if(window.is_dec_active() && n >= decAgg.left && n < decAgg.right ) {
             const bool useHLCorr = (n == 4 && compat_ver == CompatVer::V01x);
             window.dec_aggregate(n, delta, cminus, cminusAsymp, useHLCorr);
+            if (instrument) window.instr.decRows++;
         }
         if(window.is_prim_active()&& n >= primAgg.left && n < primAgg.right ) {
             window.prim_aggregate(n, delta, cminus, cminusAsymp);
+            if (instrument) window.instr.primRows++;
         }
         if(window.is_psi_active()&& n >= psiAgg.left && n < psiAgg.right ) {
             window.psi_aggregate(n, delta, cminus, cminusAsymp);
+            // Fold this row into the running prefix; psi passes
+            // useHLCorr=false, so these are exactly the addends the
+            // summary's totals pass would have accumulated.
+            window.psi_prefix->add(window.psi.summary.pairCount, window.psi.summary.c_of_n);
+            if (instrument) window.instr.psiRows++;
         }
     }
 
@@ -118,6 +226,70 @@ private:
     void prim_close();
     void psi_close();
     void summary_close();
+
+    // --rle-eps plumbing: fold one aggregate row into a stream's pending
+    // run (emitting the old run first when the values moved), emit a
+    // pending run as a CSV row with its REPEAT count, and flush both runs
+    // of an interval before its streams close.
+    void rleAdd(GBLongInterval &interval, GBRleRun &run, bool isRaw,
+                std::uint64_t first, std::uint64_t last, const std::string &label,
+                std::uint64_t nA, long double vA, std::uint64_t nB, long double vB,
+                long double n_geom, long double avg);
+    void rleEmitRaw(GBLongInterval &interval);
+    void rleEmitNorm(GBLongInterval &interval);
+    void rleFlush(GBLongInterval &interval);
+
+    // --checkpoint/--checkpoint-resume plumbing; see the public members.
+    int writeCheckpoint(std::uint64_t n);
+    int restoreCheckpoint(std::uint64_t &n);
+
+    // Timed calcCminus wrapper and end-of-run profile dump for --instrument.
+    long double instrCminus(GBWindow &w, std::uint64_t n, std::uint64_t delta, long double logNlogN);
+    void printInstrumentation();
+
+#ifndef HLCORR_USE_EXACT
+    // --hlcorr-cache helpers: drop cache-covered windows from a pre-scan
+    // list, and fold freshly scanned samples back into the cache.
+    void cacheSeedPrescan(std::vector<GBWindow*> &list, char stream);
+    void cacheAbsorbPrescan(const std::vector<GBWindow*> &list, char stream);
+#endif // HLCORR_USE_EXACT
+
+    // --columnar: one buffered binary writer per output FILE*, created on
+    // the first row and flushed before the stream closes.
+    std::map<FILE*, GBColumnarWriter> columnarWriters;
+    GBColumnarWriter* columnarWriter(FILE *out, const char *header, const char *types, const char *const *formats);
+    void columnarFlush(FILE *out);
+    void columnarFlushAll();
+    void outputFullColumnar(GBAggregate &agg, GBLongInterval &interval);
+    void outputRawColumnar(GBAggregate &agg, GBLongInterval &interval);
+    void outputNormColumnar(GBAggregate &agg, GBLongInterval &interval);
+
+    // Per-n window sweeps specialized at compile time on the policy flags
+    // that are fixed for the whole run (model, bitmap kernel, trivial-pair
+    // handling).  The instantiation is selected once before the n loop, so
+    // the hot loop carries no per-iteration dispatch branches.
+    template<Model MODEL, bool BITMAP, bool TRIVIAL>
+    int sweepWindows(std::uint64_t n, long double twoSGB_n, const std::uint64_t *&current);
+    typedef int (GBRange::*SweepFn)(std::uint64_t, long double, const std::uint64_t *&);
+    SweepFn selectSweep() const;
+
+    // Two-phase pool work for one n (empirical model only, numThreads > 1).
+    // Count phase: each worker fills hot.pairCount for its contiguous
+    // window block; blocks after the first seed their cursors at the
+    // previous block's outer boundary and count only their stripe, so the
+    // narrow inner ranges are walked once instead of once per block.  The
+    // main thread then prefix-sums the block bases, and the row phase
+    // turns base+stripe into absolute counts for addRow.
+    friend struct WindowWorkerPool;
+    template<bool BITMAP, bool TRIVIAL>
+    int countWindowBlock(std::size_t wbegin, std::size_t wend, std::uint64_t n,
+        const std::uint64_t *&current, const std::uint64_t *&innerLo,
+        const std::uint64_t *&innerHi, bool &absolute);
+    typedef int (GBRange::*CountFn)(std::size_t, std::size_t, std::uint64_t,
+        const std::uint64_t *&, const std::uint64_t *&, const std::uint64_t *&, bool &);
+    CountFn selectCountFn() const;
+    int rowWindowBlock(std::size_t wbegin, std::size_t wend, std::uint64_t n,
+        long double logN, long double logNlogN, long double twoSGB_n, std::uint64_t base);
 };
 
 #endif // GB_RANGE_HPP
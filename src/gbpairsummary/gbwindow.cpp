@@ -20,9 +20,12 @@
 #include "gbwindow.hpp"
 
 void inline close(FILE *&out) {
-    if(out && out != stdout) {
-        std::fclose(out);
-        out = nullptr;
+    if(out) {
+        gbOutRelease(out); // push any buffered rows before the FILE goes away
+        if(out != stdout) {
+            std::fclose(out);
+            out = nullptr;
+        }
     }
 }
 
@@ -102,3 +105,62 @@ void GBWindow::updateN5percent(std::uint64_t n,std::uint64_t delta,long double l
     }
 }
 
+
+// --checkpoint serialization.  The GBLongInterval FILE*s and active flags
+// are wired from the command line each run, so only the crossing scalars
+// and the summaries round-trip here.
+static int intervalCheckpointWrite(std::FILE *f, GBLongInterval &interval) {
+    int rc = 0;
+    rc |= gbCkPut(f, interval.nstar);
+    rc |= gbCkPut(f, interval.deltaMertens);
+    rc |= gbCkPut(f, interval.nstarAsymp);
+    rc |= gbCkPut(f, interval.deltaMertensAsymp);
+    rc |= interval.summary.checkpointWrite(f);
+    return rc;
+}
+
+static int intervalCheckpointRead(std::FILE *f, GBLongInterval &interval) {
+    int rc = 0;
+    rc |= gbCkGet(f, interval.nstar);
+    rc |= gbCkGet(f, interval.deltaMertens);
+    rc |= gbCkGet(f, interval.nstarAsymp);
+    rc |= gbCkGet(f, interval.deltaMertensAsymp);
+    rc |= interval.summary.checkpointRead(f);
+    return rc;
+}
+
+int GBWindow::checkpointWrite(std::FILE *f) {
+    int rc = 0;
+    rc |= gbCkPut(f, alpha_n);
+    rc |= gbCkPut(f, n_5percent);
+    rc |= gbCkPut(f, nzeroStat);
+    rc |= gbCkPut(f, nzeroStatAsymp);
+    rc |= gbCkPut(f, etaStat);
+    rc |= gbCkPut(f, etaStatAsymp);
+    rc |= gbCkPut(f, hlCorrAvg);
+    rc |= gbCkPut(f, preMertens);
+    rc |= gbCkPut(f, preMertensAsymp);
+    rc |= intervalCheckpointWrite(f, dec);
+    rc |= intervalCheckpointWrite(f, prim);
+    rc |= intervalCheckpointWrite(f, psi);
+    rc |= product_series_right.checkpointWrite(f);
+    return rc;
+}
+
+int GBWindow::checkpointRead(std::FILE *f) {
+    int rc = 0;
+    rc |= gbCkGet(f, alpha_n);
+    rc |= gbCkGet(f, n_5percent);
+    rc |= gbCkGet(f, nzeroStat);
+    rc |= gbCkGet(f, nzeroStatAsymp);
+    rc |= gbCkGet(f, etaStat);
+    rc |= gbCkGet(f, etaStatAsymp);
+    rc |= gbCkGet(f, hlCorrAvg);
+    rc |= gbCkGet(f, preMertens);
+    rc |= gbCkGet(f, preMertensAsymp);
+    rc |= intervalCheckpointRead(f, dec);
+    rc |= intervalCheckpointRead(f, prim);
+    rc |= intervalCheckpointRead(f, psi);
+    rc |= product_series_right.checkpointRead(f);
+    return rc;
+}
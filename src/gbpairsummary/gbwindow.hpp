@@ -25,6 +25,19 @@
 
 enum class CompatVer : int { V01x = 0, Current = 1 };
 
+// Opt-in hot-path counters for --instrument.  Updated from GBRange only when
+// instrumentation is enabled, so the normal path never touches them.  Each
+// window is processed by at most one worker thread, so no locking is needed.
+struct GBWindowInstr {
+    std::uint64_t iterCalls = 0;    // countRangedPairsIter invocations
+    std::uint64_t cursorSteps = 0;  // prime-array elements walked by lo/hi
+    std::uint64_t eulerCalls = 0;   // calcCminus (Euler product advance) calls
+    std::uint64_t eulerNs = 0;      // wall-clock ns spent in calcCminus
+    std::uint64_t decRows = 0;      // rows aggregated into the decade stream
+    std::uint64_t primRows = 0;     // rows aggregated into the primorial stream
+    std::uint64_t psiRows = 0;      // rows aggregated into the psi stream
+};
+
 class GBWindow {
 public:
     const long double alpha;
@@ -40,9 +53,14 @@ public:
     std::uint64_t preMertensAsymp = 0;
 
     bool eulerCap = true;
+    GBWindowInstr instr;
     GBLongInterval dec;
     GBLongInterval prim;
     GBLongInterval psi;
+    // This window's slot in the PSI prefix-sum store (see gbpsi.hpp);
+    // owned by GBPSI and wired by GBRange::init().  Only this window's
+    // sweep touches it, so the pool's rows phase needs no locking.
+    struct GBPSIPrefix *psi_prefix = nullptr;
 
     GBWindow(long double a,EulerProductSeries &productSeries,CompatVer compat_ver);
 
@@ -59,6 +77,13 @@ public:
     std::uint64_t computeDelta(long double n);
     std::uint64_t computeDelta(long double n,long double &eulerCapAlpha);
 
+    // --checkpoint: persist/restore everything per-window that evolves
+    // with n - the crossing scalars, the three interval streams with
+    // their summaries, and the right Euler product cursor.  alpha and
+    // the FILE*s come from the command line and are not serialized.
+    int checkpointWrite(std::FILE *f);
+    int checkpointRead(std::FILE *f);
+
     void closeInterval(GBLongInterval &interval);
 
     bool is_dec_active() {
@@ -81,6 +106,19 @@ public:
         return KPRODKPROD*logN/(logl(1.0L+alpha_n)+logN);
     }
 
+    // --precision=double fast path: the same expressions evaluated in
+    // double, which keeps the per-n math in the SSE unit instead of x87.
+    // Exploratory sweeps only; certified runs keep the 80-bit default.
+    // The Euler product series still accumulates in long double and is
+    // narrowed at the boundary.
+    long double calcCminusFast(std::uint64_t n, std::uint64_t delta, double logNlogN) {
+        return (long double)(logNlogN*(double)product_series_left(n)*(double)product_series_right(n+delta));
+    }
+
+    long double calcCminusAsympFast(double logN) {
+        return (long double)((double)KPRODKPROD*logN/(log(1.0+(double)alpha_n)+logN));
+    }
+
     void checkCrossing(std::uint64_t n,bool leCminus) {
         if(leCminus) {
             preMertens = n;
@@ -0,0 +1,132 @@
+// hlcorrcache - persistent Hardy-Littlewood correction sample cache
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef HLCORR_CACHE_HPP
+#define HLCORR_CACHE_HPP 1
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cinttypes>
+#include <map>
+#include <string>
+#include <tuple>
+
+// Cross-shard cache of exact HLCorr samples, keyed by (alpha, model, compat,
+// stream).  Each Makefile shard re-runs the same pre-scan over overlapping n
+// ranges; persisting the sampled values lets the next shard seed its
+// interpolators from the file and skip the pre-scan entirely.  The file is a
+// plain CSV so it diffs and merges like the rest of the pipeline output:
+//   alpha,model,compat,stream,n,hlCorr
+// with alpha and hlCorr printed at 21 significant digits so long double
+// values round-trip exactly.
+class HLCorrCache {
+private:
+    // stream is 'd' (decade), 'p' (primorial) or 's' (psi).
+    typedef std::tuple<long double, int, int, char, std::uint64_t> Key;
+
+    std::string path_;
+    std::map<Key, long double> entries_;
+    bool dirty_ = false;
+
+public:
+    void setPath(const char *path) {
+        path_ = path;
+    }
+
+    bool enabled() const {
+        return !path_.empty();
+    }
+
+    bool dirty() const {
+        return dirty_;
+    }
+
+    // Load the cache file; a missing file is an empty cache, not an error.
+    int load() {
+        FILE *in = std::fopen(path_.c_str(), "r");
+        if (!in) {
+            return 0;
+        }
+        char line[256];
+        int retval = 0;
+        while (std::fgets(line, sizeof(line), in)) {
+            if (line[0] == '#' || line[0] == '\n') {
+                continue;
+            }
+            char *p = line, *endp = nullptr;
+            const long double alpha = strtold(p, &endp);
+            if (endp == p || *endp != ',') { retval = -1; break; }
+            p = endp + 1;
+            const long model = strtol(p, &endp, 10);
+            if (endp == p || *endp != ',') { retval = -1; break; }
+            p = endp + 1;
+            const long compat = strtol(p, &endp, 10);
+            if (endp == p || *endp != ',') { retval = -1; break; }
+            p = endp + 1;
+            const char stream = *p;
+            if (stream == '\0' || p[1] != ',') { retval = -1; break; }
+            p += 2;
+            const std::uint64_t n = strtoull(p, &endp, 10);
+            if (endp == p || *endp != ',') { retval = -1; break; }
+            p = endp + 1;
+            const long double hlCorr = strtold(p, &endp);
+            if (endp == p) { retval = -1; break; }
+            entries_[Key(alpha, (int)model, (int)compat, stream, n)] = hlCorr;
+        }
+        std::fclose(in);
+        if (retval != 0) {
+            std::fprintf(stderr, "Error: malformed HLCorr cache file %s\n", path_.c_str());
+        }
+        return retval;
+    }
+
+    // Rewrite the cache file with everything loaded plus everything added.
+    int save() const {
+        FILE *out = std::fopen(path_.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "Error: cannot write HLCorr cache file %s\n", path_.c_str());
+            return -1;
+        }
+        std::fprintf(out, "# gbpairsummary hlcorr cache: alpha,model,compat,stream,n,hlCorr\n");
+        for (const auto &e : entries_) {
+            std::fprintf(out, "%.21Lg,%d,%d,%c,%" PRIu64 ",%.21Lg\n",
+                std::get<0>(e.first), std::get<1>(e.first), std::get<2>(e.first),
+                std::get<3>(e.first), std::get<4>(e.first), e.second);
+        }
+        std::fclose(out);
+        return 0;
+    }
+
+    bool get(long double alpha, int model, int compat, char stream, std::uint64_t n, long double &value) const {
+        const auto it = entries_.find(Key(alpha, model, compat, stream, n));
+        if (it == entries_.end()) {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    void put(long double alpha, int model, int compat, char stream, std::uint64_t n, long double value) {
+        if (entries_.emplace(Key(alpha, model, compat, stream, n), value).second) {
+            dirty_ = true;
+        }
+    }
+};
+
+#endif // HLCORR_CACHE_HPP
@@ -20,9 +20,11 @@
 #define HLCORRINTERP_HPP
 
 #include <cstdint>
+#include <cstdio>
 #include <vector>
 #include <cmath>
 #include "hlcorrstate.hpp"
+#include "gbcheckpoint.hpp"
 
 // Inline min/max for uint64_t to avoid template deduction issues
 static inline std::uint64_t min_u64(std::uint64_t a, std::uint64_t b) {
@@ -82,6 +84,41 @@ public:
         //fprintf(stderr, "DEBUG: hlcorrinterp: init(n_start=%llu, n_end=%llu, range_size=%llu, sample_interval=%llu, sample_size=%llu)\n", (unsigned long long)n_start, (unsigned long long)n_end, (unsigned long long)range_size, (unsigned long long)sample_interval, (unsigned long long)sample_size);
     }
     
+    // Samples collected by prescan (or seeded from a cache), for persisting.
+    const std::vector<Sample>& getSamples() const {
+        return samples;
+    }
+
+    // Seed the samples vector from a cache lookup instead of pre-scanning.
+    // lookup(n, value) returns true when the cache holds the exact HLCorr at
+    // n.  Succeeds only when every grid point prescan would sample is
+    // present, so a partial cache falls back to the normal pre-scan.
+    template<typename LookupFunc>
+    bool seedFromCache(LookupFunc lookup) {
+        if (n_end <= n_start || sample_size == 0 || !samples.empty()) {
+            return false;
+        }
+        std::vector<Sample> loaded;
+        std::uint64_t last = 0;
+        for (std::uint64_t n = n_start; n < n_end; n += sample_size) {
+            long double hlCorr;
+            if (!lookup(n, hlCorr)) {
+                return false;
+            }
+            loaded.push_back({n, hlCorr});
+            last = n;
+        }
+        if (last != n_end - 1) {
+            long double hlCorr;
+            if (!lookup(n_end - 1, hlCorr)) {
+                return false;
+            }
+            loaded.push_back({n_end - 1, hlCorr});
+        }
+        samples = std::move(loaded);
+        return true;
+    }
+
     // Pre-scan: sample exact HLCorr at regular intervals
     // Uses the existing hlcorr() function with delta computed by computeDelta callback
     template<typename ComputeDeltaFunc>
@@ -114,6 +151,43 @@ public:
     }
 
     
+    // --checkpoint: the sampled grid is engine state, so it is persisted
+    // verbatim.  The HLCorrState link is not serialized; init() established
+    // it before restore and checkpointRead leaves it alone.
+    int checkpointWrite(std::FILE *f) const {
+        int rc = 0;
+        const std::uint64_t count = samples.size();
+        rc |= gbCkPut(f, count);
+        if (count) {
+            rc |= gbCkWrite(f, samples.data(), count * sizeof(Sample));
+        }
+        rc |= gbCkPut(f, sample_interval);
+        rc |= gbCkPut(f, sample_size);
+        rc |= gbCkPut(f, n_start);
+        rc |= gbCkPut(f, n_end);
+        rc |= gbCkPut(f, range_size);
+        return rc;
+    }
+
+    int checkpointRead(std::FILE *f) {
+        int rc = 0;
+        std::uint64_t count = 0;
+        rc |= gbCkGet(f, count);
+        if (rc) {
+            return rc;
+        }
+        samples.resize(count);
+        if (count) {
+            rc |= gbCkRead(f, samples.data(), count * sizeof(Sample));
+        }
+        rc |= gbCkGet(f, sample_interval);
+        rc |= gbCkGet(f, sample_size);
+        rc |= gbCkGet(f, n_start);
+        rc |= gbCkGet(f, n_end);
+        rc |= gbCkGet(f, range_size);
+        return rc;
+    }
+
     // Interpolate HLCorr for a given n (linear interpolation)
     long double operator()(std::uint64_t n, std::uint64_t delta) {
         if (samples.empty()) {
@@ -0,0 +1,270 @@
+// gbpipeline - streams sieve output to a consumer over shared memory
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// One-shot pipeline driver: runs primesieve_bitmap with its bitmap on a
+// pipe, decodes the bits into a shared-memory prime stream (header page +
+// uint64_t slots in a memfd), and runs the consumer against that mapping
+// concurrently.  Replaces the primesieve_bitmap > file; storeprimes;
+// consumer sequence, so neither the bitmap nor the 8-byte-per-prime raw
+// store ever touches disk.  The consumer must understand the stream
+// header and gate on published coverage (gbpairsummary --stream); the
+// -=PRIMES=- macro in its arguments is replaced with the mapping's
+// /dev/fd path.
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <math.h>
+#include <inttypes.h>
+#include "libprime.h"
+
+#define READ_CHUNK (1u << 20)
+#define PRIMES_MACRO "-=PRIMES=-"
+
+// Upper bound on pi(x) good for all x (Rosser-Schoenfeld 1.25506 x/ln x
+// for x > 1), padded for the prime 2 slot and the partial last segment.
+static uint64_t prime_count_bound(uint64_t x) {
+    if (x < 100) {
+        return 32;
+    }
+    return (uint64_t)(1.2551 * (double)x / log((double)x)) + 16;
+}
+
+// Default the sieve to the sibling primesieve_bitmap in the
+// src/<tool>/<tool> layout, the way gbsched resolves its helper binaries,
+// with a plain PATH lookup as the fallback.
+static const char *sibling_sieve(const char *argv0) {
+    static char candidate[4096];
+    const char *slash = strrchr(argv0, '/');
+    if (slash) {
+        int n = snprintf(candidate, sizeof(candidate),
+                         "%.*s/../primesieve_bitmap/primesieve_bitmap",
+                         (int)(slash - argv0), argv0);
+        if (n > 0 && (size_t)n < sizeof(candidate) &&
+            access(candidate, X_OK) == 0) {
+            return candidate;
+        }
+    }
+    return "primesieve_bitmap";
+}
+
+static pid_t spawn_sieve(const char *sieve, uint64_t limit, int threads, int *out_fd) {
+    int pfd[2];
+    if (pipe(pfd) < 0) {
+        perror("pipe");
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        char limit_str[24], threads_str[16];
+        snprintf(limit_str, sizeof(limit_str), "%" PRIu64, limit);
+        snprintf(threads_str, sizeof(threads_str), "%d", threads);
+        dup2(pfd[1], STDOUT_FILENO);
+        close(pfd[0]);
+        close(pfd[1]);
+        execlp(sieve, sieve, limit_str, threads_str, (char *)NULL);
+        perror("execlp (sieve)");
+        _exit(127);
+    }
+    close(pfd[1]);
+    *out_fd = pfd[0];
+    return pid;
+}
+
+static pid_t spawn_consumer(char **argv, int argc, const char *primes_path) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        // Substitute the macro in a private copy of the argument list.
+        char **args = calloc(argc + 1, sizeof(char *));
+        if (!args) {
+            _exit(127);
+        }
+        for (int i = 0; i < argc; ++i) {
+            const char *at = strstr(argv[i], PRIMES_MACRO);
+            if (at) {
+                size_t pre = (size_t)(at - argv[i]);
+                const char *post = at + strlen(PRIMES_MACRO);
+                char *sub = malloc(strlen(argv[i]) + strlen(primes_path) + 1);
+                if (!sub) {
+                    _exit(127);
+                }
+                memcpy(sub, argv[i], pre);
+                strcpy(sub + pre, primes_path);
+                strcat(sub, post);
+                args[i] = sub;
+            }
+            else {
+                args[i] = argv[i];
+            }
+        }
+        execvp(args[0], args);
+        perror("execvp (consumer)");
+        _exit(127);
+    }
+    return pid;
+}
+
+int main(int argc, char *argv[]) {
+    const char *sieve = sibling_sieve(argv[0]);
+    int threads = 1;
+    int argi = 1;
+    for (; argi < argc; ++argi) {
+        if (!strncmp(argv[argi], "--threads=", 10)) {
+            threads = atoi(argv[argi] + 10);
+            if (threads < 1) {
+                fprintf(stderr, "Threads must be >= 1\n");
+                exit(1);
+            }
+        }
+        else if (!strncmp(argv[argi], "--sieve=", 8)) {
+            sieve = argv[argi] + 8;
+        }
+        else {
+            break;
+        }
+    }
+    if (argc - argi < 3 || strcmp(argv[argi + 1], "--")) {
+        fprintf(stderr,
+            "Usage: %s [--threads=N] [--sieve=PATH] <limit> -- <consumer command...>\n"
+            "  Sieves primes up to <limit> into a shared-memory stream and runs the\n"
+            "  consumer against it concurrently; " PRIMES_MACRO " in the consumer\n"
+            "  arguments is replaced with the stream's path.  The consumer must gate\n"
+            "  on the stream header (e.g. gbpairsummary --stream).\n"
+            "  --sieve=PATH  primesieve_bitmap binary. Default: sibling of this tool\n", argv[0]);
+        exit(1);
+    }
+    const uint64_t limit = strtoull(argv[argi], NULL, 10);
+    if (limit < 3) {
+        fprintf(stderr, "Limit must be >= 3\n");
+        exit(1);
+    }
+    char **consumer_argv = argv + argi + 2;
+    int consumer_argc = argc - argi - 2;
+
+    // The sieve emits whole segments, so bound the count by the bitmap
+    // coverage rather than limit itself.
+    const uint64_t capacity = prime_count_bound(limit + (1u << 16));
+    const size_t total_bytes = GB_PRIME_STREAM_HDR_BYTES + (size_t)capacity * sizeof(uint64_t);
+
+    int shm_fd = memfd_create("gbprimes", 0);
+    if (shm_fd < 0) {
+        perror("memfd_create");
+        exit(1);
+    }
+    if (ftruncate(shm_fd, (off_t)total_bytes) < 0) {
+        perror("ftruncate");
+        exit(1);
+    }
+    void *map = mmap(NULL, total_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        exit(1);
+    }
+    GBPrimeStreamHdr *hdr = (GBPrimeStreamHdr *)map;
+    uint64_t *primes = (uint64_t *)((uint8_t *)map + GB_PRIME_STREAM_HDR_BYTES);
+    hdr->capacity = capacity;
+    hdr->published = 0;
+    hdr->done = 0;
+    __atomic_store_n(&hdr->magic, GB_PRIME_STREAM_MAGIC, __ATOMIC_RELEASE);
+
+    uint64_t count = 0;
+    primes[count++] = 2;
+    gbPrimeStreamPublish(hdr, count);
+
+    int sieve_fd = -1;
+    pid_t sieve_pid = spawn_sieve(sieve, limit, threads, &sieve_fd);
+    if (sieve_pid < 0) {
+        exit(1);
+    }
+
+    char primes_path[32];
+    snprintf(primes_path, sizeof(primes_path), "/dev/fd/%d", shm_fd);
+    pid_t consumer_pid = spawn_consumer(consumer_argv, consumer_argc, primes_path);
+    if (consumer_pid < 0) {
+        exit(1);
+    }
+
+    // Decode the bitmap as it arrives: bit i of the stream <=> 2i+3 prime.
+    uint8_t *chunk = malloc(READ_CHUNK);
+    if (!chunk) {
+        fprintf(stderr, "Failed to allocate read chunk\n");
+        exit(1);
+    }
+    uint64_t bit_base = 0;
+    int exitStatus = 0;
+    for (;;) {
+        ssize_t got = read(sieve_fd, chunk, READ_CHUNK);
+        if (got < 0) {
+            perror("read");
+            exitStatus = 1;
+            break;
+        }
+        if (got == 0) {
+            break;
+        }
+        for (ssize_t b = 0; b < got; ++b) {
+            unsigned bits = chunk[b];
+            while (bits) {
+                const int t = __builtin_ctz(bits);
+                bits &= bits - 1;
+                if (count >= capacity) {
+                    fprintf(stderr, "Prime stream capacity exceeded at %" PRIu64 " primes\n", count);
+                    exitStatus = 1;
+                    goto drain_done;
+                }
+                primes[count++] = ((bit_base + (uint64_t)t) << 1) + 3;
+            }
+            bit_base += 8;
+        }
+        gbPrimeStreamPublish(hdr, count);
+    }
+drain_done:
+    gbPrimeStreamPublish(hdr, count);
+    gbPrimeStreamFinish(hdr);
+    free(chunk);
+    close(sieve_fd);
+
+    int status = 0;
+    if (waitpid(sieve_pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+        fprintf(stderr, "Sieve exited abnormally\n");
+        exitStatus = 1;
+    }
+    if (waitpid(consumer_pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+        fprintf(stderr, "Consumer exited abnormally\n");
+        exitStatus = 1;
+    }
+    fprintf(stderr, "Streamed %" PRIu64 " primes up to %" PRIu64 "\n",
+            count, count ? primes[count - 1] : 0);
+    munmap(map, total_bytes);
+    close(shm_fd);
+    exit(exitStatus);
+}
@@ -0,0 +1,209 @@
+// gbprimehold - shared read-only prime mapping for concurrent shards
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// When many gbpairsummary shards run on one box, each MAP_PRIVATE
+// mapping of the prime store competes for the page cache as the shards'
+// access windows diverge.  gbprimehold loads the store once into a
+// named POSIX shared-memory region using the GBPrimeStreamHdr layout
+// (published = everything, done = 1), so shards attach read-only with
+//
+//   gbpairsummary --stream /dev/shm/<name> ...
+//
+// and one physical copy of the array serves every consumer.  A
+// delta-encoded store (storeprimes --gaps) is decoded while loading, so
+// shards always see the plain uint64_t array.  With --mlock the holder
+// pins the region and stays in the foreground until SIGINT/SIGTERM;
+// without it the region persists on its own (tmpfs pages are not
+// evicted to the page cache's detriment, only to swap).  Remove a
+// region with --remove when the run is over.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "libprime.h"
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+        "Usage: %s [--mlock] <prime_raw_file|prime_gaps_file> <shm_name>\n"
+        "       %s --remove <shm_name>\n"
+        "\n"
+        "Loads a prime store into the named shared-memory region\n"
+        "(/dev/shm/<shm_name>) in gbpipeline stream format, so concurrent\n"
+        "gbpairsummary shards attach one physical copy of the array with\n"
+        "--stream instead of each mapping the file privately.\n"
+        "\n"
+        "  --mlock    pin the region and hold it until SIGINT/SIGTERM\n"
+        "  --remove   unlink the named region and exit\n",
+        prog, prog);
+}
+
+// shm_open wants a leading slash; accept the name with or without one.
+static const char *shm_slash_name(const char *name, char *buf, size_t bufsz) {
+    if (name[0] == '/') {
+        return name;
+    }
+    snprintf(buf, bufsz, "/%s", name);
+    return buf;
+}
+
+int main(int argc, char **argv) {
+    int use_mlock = 0;
+    const char *prog = argv[0];
+
+    if (argc == 3 && strcmp(argv[1], "--remove") == 0) {
+        char namebuf[256];
+        const char *name = shm_slash_name(argv[2], namebuf, sizeof(namebuf));
+        if (shm_unlink(name) != 0) {
+            fprintf(stderr, "%s: shm_unlink %s: %s\n", prog, name, strerror(errno));
+            return 1;
+        }
+        return 0;
+    }
+    while (argc > 1 && strncmp(argv[1], "--", 2) == 0) {
+        if (strcmp(argv[1], "--mlock") == 0) {
+            use_mlock = 1;
+        } else {
+            usage(prog);
+            return 1;
+        }
+        argv++;
+        argc--;
+    }
+    if (argc != 3) {
+        usage(prog);
+        return 1;
+    }
+    const char *prime_file = argv[1];
+    char namebuf[256];
+    const char *name = shm_slash_name(argv[2], namebuf, sizeof(namebuf));
+
+    // Map the source store read-only; decode detection matches the
+    // engine's MMapU64::open_file.
+    int src_fd = open(prime_file, O_RDONLY);
+    if (src_fd < 0) {
+        fprintf(stderr, "%s: open %s: %s\n", prog, prime_file, strerror(errno));
+        return 1;
+    }
+    struct stat st;
+    if (fstat(src_fd, &st) < 0 || st.st_size == 0) {
+        fprintf(stderr, "%s: fstat %s failed or empty file\n", prog, prime_file);
+        close(src_fd);
+        return 1;
+    }
+    const uint8_t *src = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, src_fd, 0);
+    if (src == MAP_FAILED) {
+        fprintf(stderr, "%s: mmap %s: %s\n", prog, prime_file, strerror(errno));
+        close(src_fd);
+        return 1;
+    }
+
+    PrimeGapDecoder dec;
+    int is_gaps = isPrimeGapData(src, (size_t)st.st_size);
+    uint64_t count;
+    if (is_gaps) {
+        if (primeGapDecoderInit(&dec, src, (size_t)st.st_size) != 0) {
+            fprintf(stderr, "%s: bad prime gap header in %s\n", prog, prime_file);
+            return 1;
+        }
+        count = dec.total;
+    } else {
+        count = (uint64_t)st.st_size / sizeof(uint64_t);
+    }
+
+    const size_t bytes = GB_PRIME_STREAM_HDR_BYTES + (size_t)count * sizeof(uint64_t);
+    int shm_fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (shm_fd < 0) {
+        fprintf(stderr, "%s: shm_open %s: %s%s\n", prog, name, strerror(errno),
+                errno == EEXIST ? " (use --remove first)" : "");
+        return 1;
+    }
+    if (ftruncate(shm_fd, (off_t)bytes) < 0) {
+        fprintf(stderr, "%s: ftruncate: %s\n", prog, strerror(errno));
+        shm_unlink(name);
+        return 1;
+    }
+    uint8_t *region = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    if (region == MAP_FAILED) {
+        fprintf(stderr, "%s: mmap shm region: %s\n", prog, strerror(errno));
+        shm_unlink(name);
+        return 1;
+    }
+
+    GBPrimeStreamHdr *hdr = (GBPrimeStreamHdr *)region;
+    uint64_t *slots = (uint64_t *)(region + GB_PRIME_STREAM_HDR_BYTES);
+    hdr->capacity = count;
+    if (is_gaps) {
+        uint64_t produced = 0;
+        size_t got;
+        while ((got = primeGapDecoderNextBlock(&dec, slots + produced, 1u << 16)) > 0) {
+            produced += got;
+        }
+        if (produced != count) {
+            fprintf(stderr, "%s: truncated prime gap stream in %s\n", prog, prime_file);
+            shm_unlink(name);
+            return 1;
+        }
+    } else {
+        memcpy(slots, src, (size_t)st.st_size);
+    }
+    munmap((void *)src, (size_t)st.st_size);
+    close(src_fd);
+
+    // The store is complete before anyone attaches: publish everything,
+    // mark done, then stamp the magic so a half-written region is never
+    // mistaken for a valid one.
+    gbPrimeStreamPublish(hdr, count);
+    gbPrimeStreamFinish(hdr);
+    __atomic_store_n(&hdr->magic, GB_PRIME_STREAM_MAGIC, __ATOMIC_RELEASE);
+
+    fprintf(stderr, "gbprimehold: %" PRIu64 " primes (max %" PRIu64 ") in /dev/shm%s\n",
+            count, count ? slots[count - 1] : 0, name);
+
+    if (use_mlock) {
+        if (mlock(region, bytes) != 0) {
+            perror("mlock"); // keep holding unlocked
+        }
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = on_signal;
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+        fprintf(stderr, "gbprimehold: holding (SIGINT/SIGTERM releases; region stays linked)\n");
+        while (!stop_requested) {
+            pause();
+        }
+    }
+    munmap(region, bytes);
+    close(shm_fd);
+    return 0;
+}
@@ -0,0 +1,394 @@
+// gbsched - dynamic shard scheduler for the gbpairsummary pipeline
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Replaces the top-level Makefile's hand-cut shards (SUFFIX_SMALLA..E and
+// friends under make -j) with fine-grained work units pulled from a shared
+// queue.  Units are cut on equal-cost boundaries (cost of one n grows about
+// linearly in n, so boundaries interpolate n^2) and workers claim the next
+// unit the moment they go idle, so the machine stays busy to the last unit
+// instead of idling behind one fat shard.  Each unit runs the gbpairsummary
+// engine as a child process - the engine's Euler product table and output
+// buffers are process-global single-writer state, so one engine per unit is
+// what keeps the units independent - and the per-unit cps summaries are fed
+// straight into mergecps at the end.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cinttypes>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+
+// Matches fmt_alpha in gbpairsummary.cpp so the scheduler can predict how
+// the engine expands the -=ALPHA=- path macro.
+static std::string fmt_alpha(long double a, int prec = 12) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.*Lg", prec, a);
+    return std::string(buf);
+}
+
+static std::string replace_all(std::string s, const std::string &key, const std::string &rep) {
+    size_t pos = 0;
+    while ((pos = s.find(key, pos)) != std::string::npos) {
+        s.replace(pos, key.size(), rep);
+        pos += rep.size();
+    }
+    return s;
+}
+
+struct Unit {
+    std::uint64_t n_start = 0;
+    std::uint64_t n_end = 0;
+    std::string fullTpl;        // -=ALPHA=- templates handed to the engine
+    std::string summaryTpl;
+};
+
+class GBScheduler {
+public:
+    std::vector<long double> alphas;
+    std::uint64_t n_start = 4;
+    std::uint64_t n_end = 5;
+    unsigned jobs = 0;
+    unsigned nunits = 0;
+    std::string outDir = ".";
+    std::string enginePath;
+    std::string mergecpsPath;
+    std::string compat = "v0.2";
+    std::string piIndexPath;
+    std::string primeFile;
+
+    int run() {
+        if (jobs == 0) {
+            jobs = std::thread::hardware_concurrency();
+            if (jobs == 0) jobs = 1;
+        }
+        if (nunits == 0) {
+            nunits = jobs * 8;
+        }
+        buildUnits();
+        if (units.empty()) {
+            std::fprintf(stderr, "Error: empty range [%" PRIu64 ",%" PRIu64 ")\n", n_start, n_end);
+            return 1;
+        }
+        std::printf("gbsched: %zu units over [%" PRIu64 ",%" PRIu64 ") on %u workers\n",
+            units.size(), n_start, n_end, jobs);
+        std::fflush(stdout);
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < jobs; t++) {
+            workers.emplace_back(&GBScheduler::workerLoop, this);
+        }
+        for (auto &w : workers) {
+            w.join();
+        }
+        if (failed.load()) {
+            std::fprintf(stderr, "Error: %u unit(s) failed; partials left in %s for inspection\n",
+                failed.load(), outDir.c_str());
+            return 1;
+        }
+        return mergeOutputs();
+    }
+
+private:
+    std::vector<Unit> units;
+    std::atomic<unsigned> next{0};
+    std::atomic<unsigned> failed{0};
+    std::mutex logMutex;
+
+    // The decade aggregates close on leading-digit boundaries (d*10^k, the
+    // same grid the hand-cut Makefile shards end on), and a unit only
+    // writes its cps summary row when its last aggregate completes at the
+    // unit's n_end.  Snap interior boundaries to that grid.
+    static std::uint64_t snapDigitBoundary(std::uint64_t x) {
+        if (x < 10) {
+            return x;
+        }
+        std::uint64_t scale = 1;
+        while (x / scale >= 10) {
+            scale *= 10;
+        }
+        return ((x + scale / 2) / scale) * scale;
+    }
+
+    // Equal-cost unit boundaries: the pair count walk for one n costs about
+    // O(n) cursor steps, so integrated cost over a unit goes as the
+    // difference of squares and boundaries interpolate in n^2, then snap to
+    // the aggregate grid.
+    void buildUnits() {
+        if (n_end <= n_start) {
+            return;
+        }
+        const long double s2 = (long double)n_start * (long double)n_start;
+        const long double e2 = (long double)n_end * (long double)n_end;
+        std::uint64_t prev = n_start;
+        for (unsigned k = 1; k <= nunits && prev < n_end; k++) {
+            std::uint64_t bound = (k == nunits)
+                ? n_end
+                : snapDigitBoundary((std::uint64_t)sqrtl(s2 + (e2 - s2) * (long double)k / (long double)nunits));
+            if (bound <= prev) {
+                continue; // tiny range: fewer, never empty, units
+            }
+            if (bound > n_end) {
+                bound = n_end;
+            }
+            Unit u;
+            u.n_start = prev;
+            u.n_end = bound;
+            char tag[32];
+            std::snprintf(tag, sizeof(tag), "unit%04zu", units.size());
+            u.fullTpl = outDir + "/gbsched-" + tag + "-full--=ALPHA=-.partial.csv";
+            u.summaryTpl = outDir + "/gbsched-" + tag + "-cps-summary--=ALPHA=-.partial.csv";
+            units.push_back(u);
+            prev = bound;
+        }
+    }
+
+    void workerLoop() {
+        for (;;) {
+            unsigned i = next.fetch_add(1);
+            if (i >= units.size() || failed.load()) {
+                return;
+            }
+            const Unit &u = units[i];
+            std::vector<std::string> args;
+            args.push_back(enginePath);
+            for (long double a : alphas) {
+                args.push_back("--alpha=" + fmt_alpha(a));
+            }
+            args.push_back("--compat=" + compat);
+            args.push_back("--model=empirical");
+            args.push_back("--trace=none");
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%" PRIu64, u.n_start);
+            args.push_back(std::string("--dec-n-start=") + buf);
+            std::snprintf(buf, sizeof(buf), "%" PRIu64, u.n_end);
+            args.push_back(std::string("--dec-n-end=") + buf);
+            args.push_back("--dec-full=" + u.fullTpl);
+            args.push_back("--dec-cps-summary=" + u.summaryTpl);
+            if (!piIndexPath.empty()) {
+                args.push_back("--pi-index=" + piIndexPath);
+            }
+            args.push_back(primeFile);
+            if (spawn(args) != 0) {
+                failed.fetch_add(1);
+                std::lock_guard<std::mutex> lock(logMutex);
+                std::fprintf(stderr, "Error: unit %u [%" PRIu64 ",%" PRIu64 ") failed\n",
+                    i, u.n_start, u.n_end);
+            }
+        }
+    }
+
+    // Run one child and wait for it; nonzero exit or a signal is a failure.
+    int spawn(const std::vector<std::string> &args) {
+        std::vector<char *> argv;
+        argv.reserve(args.size() + 1);
+        for (const auto &a : args) {
+            argv.push_back(const_cast<char *>(a.c_str()));
+        }
+        argv.push_back(nullptr);
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return -1;
+        }
+        if (pid == 0) {
+            execvp(argv[0], argv.data());
+            perror(argv[0]);
+            _exit(127);
+        }
+        int status = 0;
+        if (waitpid(pid, &status, 0) < 0) {
+            perror("waitpid");
+            return -1;
+        }
+        return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1;
+    }
+
+    // Units are ordered by n, so concatenating the per-unit full partials
+    // (one header, from the first) reproduces the sharded full stream, and
+    // mergecps folds the per-unit cps summaries into one row per alpha.
+    int mergeOutputs() {
+        for (long double a : alphas) {
+            const std::string astr = fmt_alpha(a);
+            const std::string fullOut = outDir + "/gbsched-full-" + astr + ".csv";
+            FILE *out = std::fopen(fullOut.c_str(), "w");
+            if (!out) {
+                std::perror(fullOut.c_str());
+                return 1;
+            }
+            bool first = true;
+            for (const auto &u : units) {
+                if (appendCsv(out, replace_all(u.fullTpl, "-=ALPHA=-", astr), first) != 0) {
+                    std::fclose(out);
+                    return 1;
+                }
+                first = false;
+            }
+            std::fclose(out);
+
+            std::vector<std::string> args;
+            args.push_back(mergecpsPath);
+            for (const auto &u : units) {
+                args.push_back("--input");
+                args.push_back(replace_all(u.summaryTpl, "-=ALPHA=-", astr));
+            }
+            args.push_back("--output");
+            args.push_back(outDir + "/gbsched-cps-summary-" + astr + ".csv");
+            if (spawn(args) != 0) {
+                std::fprintf(stderr, "Error: mergecps failed for alpha=%s\n", astr.c_str());
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    int appendCsv(FILE *out, const std::string &path, bool keepHeader) {
+        FILE *in = std::fopen(path.c_str(), "r");
+        if (!in) {
+            std::perror(path.c_str());
+            return 1;
+        }
+        char line[8192];
+        bool firstLine = true;
+        while (std::fgets(line, sizeof(line), in)) {
+            if (firstLine && !keepHeader) {
+                firstLine = false;
+                continue; // every fresh partial starts with the same header
+            }
+            firstLine = false;
+            std::fputs(line, out);
+        }
+        std::fclose(in);
+        return 0;
+    }
+};
+
+static void print_usage(const char *prog) {
+    std::fprintf(stderr,
+        "Usage: %s [OPTIONS] <prime_raw_file>\n"
+        "\n"
+        "Splits [n-start,n-end) into equal-cost work units, runs one\n"
+        "gbpairsummary engine per unit from a shared pull queue across\n"
+        "--jobs workers, then merges the per-unit cps summaries with\n"
+        "mergecps and concatenates the full partials per alpha.\n"
+        "\n"
+        "Options:\n"
+        "  --alpha=VAL          Window half-width multiplier; may be repeated. Default: 0.5\n"
+        "  --n-start=N          Start n (uint64). Default: 4\n"
+        "  --n-end=N            End n (uint64). Default: 5\n"
+        "  --jobs=N             Worker count. Default: online cores\n"
+        "  --units=N            Work unit count. Default: 8*jobs\n"
+        "  --out-dir=DIR        Output directory for partials and merged files. Default: .\n"
+        "  --engine=PATH        gbpairsummary binary. Default: sibling of this tool\n"
+        "  --mergecps=PATH      mergecps binary. Default: sibling of this tool\n"
+        "  --compat=VERSION     Passed to the engine. Default: v0.2\n"
+        "  --pi-index=FILE      Passed to the engine; seeds each unit's cursors in O(1)\n"
+        "  -h, --help           Show this help and exit\n",
+        prog);
+}
+
+// Default helper binaries to siblings of this tool's own directory tree,
+// matching the src/<tool>/<tool> layout, with PATH as the fallback.
+static std::string sibling(const char *argv0, const char *tool) {
+    std::string s = argv0;
+    size_t slash = s.rfind('/');
+    if (slash != std::string::npos) {
+        std::string candidate = s.substr(0, slash) + "/../" + tool + "/" + tool;
+        if (access(candidate.c_str(), X_OK) == 0) {
+            return candidate;
+        }
+    }
+    return tool;
+}
+
+int main(int argc, char *argv[]) {
+    GBScheduler sched;
+
+    static struct option long_opts[] = {
+        {"alpha",    required_argument, 0,  0 },
+        {"n-start",  required_argument, 0,  0 },
+        {"n-end",    required_argument, 0,  0 },
+        {"jobs",     required_argument, 0,  0 },
+        {"units",    required_argument, 0,  0 },
+        {"out-dir",  required_argument, 0,  0 },
+        {"engine",   required_argument, 0,  0 },
+        {"mergecps", required_argument, 0,  0 },
+        {"compat",   required_argument, 0,  0 },
+        {"pi-index", required_argument, 0,  0 },
+        {"help",     no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt, opt_index;
+    while ((opt = getopt_long(argc, argv, "h", long_opts, &opt_index)) != -1) {
+        if (opt == 'h') {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (opt != 0) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        const char *name = long_opts[opt_index].name;
+        if (!std::strcmp(name, "alpha")) {
+            char *end = nullptr;
+            long double a = strtold(optarg, &end);
+            if (end == optarg || a < 0.0L || a > 1.0L) {
+                std::fprintf(stderr, "Error: invalid --alpha=%s\n", optarg);
+                return 1;
+            }
+            sched.alphas.push_back(a);
+        }
+        else if (!std::strcmp(name, "n-start"))  { sched.n_start = strtoull(optarg, nullptr, 10); }
+        else if (!std::strcmp(name, "n-end"))    { sched.n_end = strtoull(optarg, nullptr, 10); }
+        else if (!std::strcmp(name, "jobs"))     { sched.jobs = (unsigned)strtoul(optarg, nullptr, 10); }
+        else if (!std::strcmp(name, "units"))    { sched.nunits = (unsigned)strtoul(optarg, nullptr, 10); }
+        else if (!std::strcmp(name, "out-dir"))  { sched.outDir = optarg; }
+        else if (!std::strcmp(name, "engine"))   { sched.enginePath = optarg; }
+        else if (!std::strcmp(name, "mergecps")) { sched.mergecpsPath = optarg; }
+        else if (!std::strcmp(name, "compat"))   { sched.compat = optarg; }
+        else if (!std::strcmp(name, "pi-index")) { sched.piIndexPath = optarg; }
+    }
+
+    if (optind + 1 != argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    sched.primeFile = argv[optind];
+    if (sched.alphas.empty()) {
+        sched.alphas.push_back(0.5L);
+    }
+    if (sched.enginePath.empty()) {
+        sched.enginePath = sibling(argv[0], "gbpairsummary");
+    }
+    if (sched.mergecpsPath.empty()) {
+        sched.mergecpsPath = sibling(argv[0], "mergecps");
+    }
+    mkdir(sched.outDir.c_str(), 0777); // fine if it already exists
+
+    return sched.run();
+}
@@ -0,0 +1,529 @@
+// gbstats - native replacements for the bin/ awk and python summarizers
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Subcommands mirror the scripts they replace line for line, including
+// their printf formats and quirks, so output is byte-identical and they
+// can be swapped into existing Makefile recipes:
+//
+//   merge-cps FILE...       bin/mergeCPSLowerBound.awk
+//   lambda-stats FILE       bin/lambdaStats.awk
+//   join-sum-pred F1 F2     bin/joinSumPred.awk (VERSION env var, as before)
+//
+// Inputs are mmap'd and parsed in place instead of streamed through an
+// interpreter, which is where the time went on multi-GB CSVs.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ----- mmap'd line reader -----
+
+class MappedFile {
+public:
+    ~MappedFile() {
+        if (base_) {
+            ::munmap(base_, len_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    bool open(const char* path) {
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) {
+            std::perror(path);
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) < 0) {
+            std::perror("fstat");
+            return false;
+        }
+        len_ = (std::size_t)st.st_size;
+        if (len_ == 0) {
+            return true;
+        }
+        void* p = ::mmap(nullptr, len_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) {
+            std::perror("mmap");
+            return false;
+        }
+        base_ = static_cast<char*>(p);
+        return true;
+    }
+
+    // Next line without its newline; false at end of file.
+    bool nextLine(std::string &out) {
+        if (pos_ >= len_) {
+            return false;
+        }
+        const char* start = base_ + pos_;
+        const char* nl = static_cast<const char*>(memchr(start, '\n', len_ - pos_));
+        const std::size_t n = nl ? (std::size_t)(nl - start) : (len_ - pos_);
+        out.assign(start, n);
+        pos_ += n + (nl ? 1 : 0);
+        return true;
+    }
+
+private:
+    int fd_ = -1;
+    char* base_ = nullptr;
+    std::size_t len_ = 0;
+    std::size_t pos_ = 0;
+};
+
+// awk-compatible helpers: split keeps empty fields, trim strips blanks and
+// CR, numeric conversion is strtod of the leading prefix (0 on garbage).
+
+static std::vector<std::string> splitCSV(const std::string &line) {
+    std::vector<std::string> out;
+    std::size_t start = 0;
+    for (;;) {
+        std::size_t comma = line.find(',', start);
+        if (comma == std::string::npos) {
+            out.push_back(line.substr(start));
+            return out;
+        }
+        out.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+}
+
+static std::string trim(const std::string &s) {
+    std::size_t b = 0, e = s.size();
+    while (b < e && (s[b] == ' ' || s[b] == '\t' || s[b] == '\r')) ++b;
+    while (e > b && (s[e-1] == ' ' || s[e-1] == '\t' || s[e-1] == '\r')) --e;
+    return s.substr(b, e - b);
+}
+
+static double toNum(const std::string &s) {
+    return std::strtod(s.c_str(), nullptr);
+}
+
+static int findColumn(const std::vector<std::string> &cols, const char* name) {
+    for (std::size_t i = 0; i < cols.size(); ++i) {
+        if (cols[i] == name) {
+            return (int)i + 1; // 1-based like awk
+        }
+    }
+    return -1;
+}
+
+// ----- merge-cps: shard merge with blank-value inheritance -----
+// Old-format files (header starts with "Dec") pass through; new-format
+// files inherit blank preMertens/preMertensAsymp (columns 7/8) from the
+// previous row.  Only the first header survives.
+
+static int cmdMergeCps(int argc, char* argv[]) {
+    std::string inherited_preMertens, inherited_preMertensAsymp;
+    bool header_printed = false;
+    bool is_old_format = false;
+    bool first_line = true;
+
+    for (int a = 0; a < argc; ++a) {
+        MappedFile f;
+        if (!f.open(argv[a])) {
+            return 1;
+        }
+        std::string line;
+        while (f.nextLine(line)) {
+            const bool looks_header = line.rfind("Dec", 0) == 0 || line.rfind("n,C(n)", 0) == 0;
+            if (first_line || looks_header) {
+                if (line.rfind("Dec", 0) == 0) {
+                    is_old_format = true;
+                }
+                if (!header_printed) {
+                    std::printf("%s\n", line.c_str());
+                    header_printed = true;
+                }
+                first_line = false;
+                continue;
+            }
+            first_line = false;
+            if (is_old_format) {
+                std::printf("%s\n", line.c_str());
+                continue;
+            }
+            std::vector<std::string> fields = splitCSV(line);
+            const std::string preMertens = fields.size() > 6 ? fields[6] : std::string();
+            const std::string preMertensAsymp = fields.size() > 7 ? fields[7] : std::string();
+            if (preMertens.empty() && !inherited_preMertens.empty()) {
+                if (fields.size() > 6) fields[6] = inherited_preMertens;
+            }
+            else if (!preMertens.empty()) {
+                inherited_preMertens = preMertens;
+            }
+            if (preMertensAsymp.empty() && !inherited_preMertensAsymp.empty()) {
+                if (fields.size() > 7) fields[7] = inherited_preMertensAsymp;
+            }
+            else if (!preMertensAsymp.empty()) {
+                inherited_preMertensAsymp = preMertensAsymp;
+            }
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                std::printf("%s%s", i ? "," : "", fields[i].c_str());
+            }
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
+
+// ----- lambda-stats: per-decade |Lambda| summary -----
+// Values are rounded to 8 decimals before the order statistics, matching
+// the awk script's tempfile round trip.
+
+static int lambdaDecade(double n_geom) {
+    if (n_geom <= 0) return -1;
+    if (n_geom < 10) return 0;
+    if (n_geom < 100) return 1;
+    if (n_geom < 1000) return 2;
+    if (n_geom < 10000) return 3;
+    if (n_geom < 100000) return 4;
+    if (n_geom < 1000000) return 5;
+    if (n_geom < 10000000) return 6;
+    if (n_geom < 100000000) return 7;
+    return 8;
+}
+
+// Type-7 quantile (R's default) over sorted[0..n)
+static double quantile7(const std::vector<double> &sorted, double p) {
+    const std::size_t n = sorted.size();
+    if (p <= 0) return sorted.front();
+    if (p >= 1) return sorted.back();
+    const double h = 1.0 + (double)(n - 1) * p;
+    const std::size_t k = (std::size_t)h;
+    const double frac = h - (double)k;
+    if (k >= n) return sorted.back();
+    return sorted[k-1] + frac * (sorted[k] - sorted[k-1]);
+}
+
+static int cmdLambdaStats(const char* path) {
+    constexpr int WANT_DECADES = 8;
+    MappedFile f;
+    if (!f.open(path)) {
+        return 1;
+    }
+    std::printf("Dec.,max |lambda|,2nd max |lambda|,min |lambda|,2nd min |lambda|,"
+                "median |lambda|,trimmed < |lambda| >,Spread_raw^IQR (of |lambda|),%% positive\n");
+    std::string line;
+    if (!f.nextLine(line)) {
+        return 0;
+    }
+    const bool is_v0_2_0 = line.find("START") != std::string::npos;
+    std::vector<double> lam_abs[WANT_DECADES];
+    std::uint64_t poscnt[WANT_DECADES] = {0};
+    char rounded[64];
+    while (f.nextLine(line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::vector<std::string> fields = splitCSV(line);
+        int dec;
+        if (is_v0_2_0) {
+            dec = lambdaDecade(fields.size() > 1 ? toNum(trim(fields[1])) : 0.0);
+        }
+        else {
+            dec = (int)toNum(trim(fields[0]));
+        }
+        if (dec < 0 || dec >= WANT_DECADES) {
+            continue;
+        }
+        const double lam = toNum(trim(fields.back()));
+        std::snprintf(rounded, sizeof(rounded), "%0.8f", std::fabs(lam));
+        lam_abs[dec].push_back(std::strtod(rounded, nullptr));
+        if (lam > 0) {
+            poscnt[dec]++;
+        }
+    }
+    for (int d = 0; d < WANT_DECADES; ++d) {
+        std::vector<double> &v = lam_abs[d];
+        const std::size_t m = v.size();
+        if (m < 5) {
+            continue;
+        }
+        std::sort(v.begin(), v.end());
+        const double min1 = v.front(), min2 = v[1];
+        const double max1 = v.back(), max2 = v[m-2];
+        const double med_abs = (m % 2) ? v[(m-1)/2] : (v[m/2 - 1] + v[m/2]) / 2.0;
+        double tsum = 0;
+        for (std::size_t i = 1; i + 1 < m; ++i) {
+            tsum += v[i];
+        }
+        const double tmean = tsum / (double)(m - 2);
+        const double iqr = quantile7(v, 0.75) - quantile7(v, 0.25);
+        const double pospct = 100.0 * (double)poscnt[d] / (double)m;
+        std::printf("%d,%.3e,%.3e,%.3e,%.3e,%.3e,%.3e,%.3e,%.1f\n",
+            d, max1, max2, min1, min2, med_abs, tmean, iqr, pospct);
+    }
+    return 0;
+}
+
+// ----- join-sum-pred: join summary and HLA full output for plotting -----
+// Keyed by n_geom (v0.2.x) or label + n_geom (v0.1.x); VERSION comes from
+// the environment exactly as it did for the awk script.
+
+struct SumRow {
+    std::string label, n0, cmin, n1, cmax, ngeom, cavg;
+};
+
+static int cmdJoinSumPred(const char* file1, const char* file2) {
+    const char* version_env = std::getenv("VERSION");
+    const std::string VERSION = version_env ? version_env : "";
+    if (VERSION.empty()) {
+        std::fprintf(stderr, "ERROR: VERSION environment variable not set. Use: VERSION=v0.1.x or VERSION=v0.2.x\n");
+        return 1;
+    }
+    if (VERSION.compare(0, 5, "v0.1.") && VERSION.compare(0, 5, "v0.2.")) {
+        std::fprintf(stderr, "ERROR: Invalid VERSION '%s'. Must be v0.1.x or v0.2.x\n", VERSION.c_str());
+        return 1;
+    }
+    const bool v02 = !VERSION.compare(0, 5, "v0.2.");
+
+    // Pass 1: summary file into the join map.
+    std::unordered_map<std::string, SumRow> rows;
+    {
+        MappedFile f;
+        if (!f.open(file1)) {
+            return 1;
+        }
+        std::string line;
+        int col_label = 0, col_n0 = 0, col_cmin = 0, col_n1 = 0, col_cmax = 0, col_ngeom = 0, col_cavg = 0;
+        bool first = true;
+        while (f.nextLine(line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            std::vector<std::string> fields = splitCSV(line);
+            if (first) {
+                first = false;
+                if (line.find("FIRST") != std::string::npos) {
+                    col_label = findColumn(fields, "START");
+                    col_n0 = findColumn(fields, "n_0");
+                    col_cmin = findColumn(fields, "C_min(n_0)");
+                    col_n1 = findColumn(fields, "n_1");
+                    col_cmax = findColumn(fields, "C_max(n_1)");
+                    col_ngeom = findColumn(fields, "n_geom");
+                    col_cavg = findColumn(fields, "C_avg");
+                }
+                else {
+                    col_label = findColumn(fields, "DECADE");
+                    col_n0 = findColumn(fields, "n_0");
+                    col_cmin = findColumn(fields, "C_min");
+                    col_n1 = findColumn(fields, "n_1");
+                    col_cmax = findColumn(fields, "C_max");
+                    col_ngeom = findColumn(fields, "n_geom");
+                    col_cavg = findColumn(fields, "C_avg");
+                }
+                continue;
+            }
+            auto field = [&fields](int col) {
+                return (col >= 1 && (std::size_t)col <= fields.size()) ? trim(fields[col-1]) : std::string();
+            };
+            SumRow r;
+            r.label = field(col_label);
+            r.n0 = field(col_n0);
+            r.cmin = field(col_cmin);
+            r.n1 = field(col_n1);
+            r.cmax = field(col_cmax);
+            r.ngeom = field(col_ngeom);
+            r.cavg = field(col_cavg);
+            const std::string key = v02 ? r.ngeom : (r.label + '\034' + r.ngeom);
+            rows[key] = r;
+        }
+    }
+
+    // Pass 2: HLA full output, emit the join in file order.
+    MappedFile f;
+    if (!f.open(file2)) {
+        return 1;
+    }
+    std::string line;
+    int col_label2 = 0, col_n0_2 = 0, col_cmin_2 = 0, col_n1_2 = 0, col_cmax_2 = 0, col_ngeom_2 = 0, col_cavg_2 = 0;
+    int col_nalign = 0, col_calign = 0, col_nalignmax = 0, col_calignmax = 0;
+    int col_ncbound = 0, col_ccbound = 0, col_ncboundmax = 0, col_ccboundmax = 0;
+    bool first = true;
+    while (f.nextLine(line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::vector<std::string> fields = splitCSV(line);
+        if (first) {
+            first = false;
+            int missing = 0;
+            auto optional_col = [&fields](const char* name) {
+                const int c = findColumn(fields, name);
+                return c == -1 ? 0 : c;
+            };
+            auto required_col = [&fields, &missing](const char* name, const char* fmt) {
+                const int c = findColumn(fields, name);
+                if (c == -1) {
+                    std::fprintf(stderr, "ERROR: %s column not found for %s\n", name, fmt);
+                    missing++;
+                }
+                return c;
+            };
+            const char* file2_format = "v0.1.5";
+            if (line.find("FIRST") != std::string::npos) {
+                if (line.find("n_0*") != std::string::npos || line.find("Cpred_min") != std::string::npos) {
+                    file2_format = "v0.2.0";
+                    col_label2 = required_col("START", file2_format);
+                    col_n0_2 = required_col("n_0*", file2_format);
+                    col_cmin_2 = required_col("Cpred_min(n_0*)", file2_format);
+                    col_n1_2 = required_col("n_1*", file2_format);
+                    col_cmax_2 = required_col("Cpred_max(n_1*)", file2_format);
+                    col_ngeom_2 = required_col("n_geom", file2_format);
+                    col_cavg_2 = required_col("Cpred_avg", file2_format);
+                    col_nalign = optional_col("n_v");
+                    col_calign = optional_col("Calign_min(n_v)");
+                    col_nalignmax = optional_col("n_u");
+                    col_calignmax = optional_col("Calign_max(n_u)");
+                    col_ncbound = optional_col("n_a");
+                    col_ccbound = optional_col("CboundMin(n_a)");
+                    col_ncboundmax = optional_col("n_b");
+                    col_ccboundmax = optional_col("CboundMax(n_b)");
+                }
+                else {
+                    col_label2 = required_col("START", file2_format);
+                    col_n0_2 = required_col("n_0", file2_format);
+                    col_cmin_2 = required_col("C_min(n_0)", file2_format);
+                    col_n1_2 = required_col("n_1", file2_format);
+                    col_cmax_2 = required_col("C_max(n_1)", file2_format);
+                    col_ngeom_2 = required_col("n_geom", file2_format);
+                    col_cavg_2 = required_col("C_avg", file2_format);
+                }
+                if (missing > 0) {
+                    std::fprintf(stderr, "ERROR: %d required columns missing for %s. Cannot proceed.\n", missing, file2_format);
+                    return 1;
+                }
+            }
+            else {
+                col_label2 = required_col("DECADE", file2_format);
+                col_n0_2 = required_col("n_0", file2_format);
+                col_cmin_2 = required_col("Cpred_min", file2_format);
+                col_n1_2 = required_col("n_1", file2_format);
+                col_cmax_2 = required_col("Cpred_max", file2_format);
+                col_ngeom_2 = required_col("N_geom", file2_format);
+                col_cavg_2 = required_col("Cpred_avg", file2_format);
+                if (missing > 0) {
+                    std::fprintf(stderr, "ERROR: %d required columns missing for v0.1.5. Cannot proceed.\n", missing);
+                    return 1;
+                }
+            }
+            if (VERSION == "v0.2.0") {
+                std::printf("START,n_0,C_min,Npred_0,Cpred_min,n_1,C_max,Npred_1,Cpred_max,"
+                            "n_geom,C_avg,Cpred_avg,n_v,Calign_min,n_u,Calign_max,n_a,Cbound_min,n_b,Cbound_max\n");
+            }
+            else {
+                std::printf("DECADE,n_0,C_min,Npred_0,Cpred_min,n_1,C_max,Npred_1,Cpred_max,"
+                            "n_geom,C_avg,Cpred_avg\n");
+            }
+            continue;
+        }
+        auto field = [&fields](int col) {
+            return (col >= 1 && (std::size_t)col <= fields.size()) ? trim(fields[col-1]) : std::string();
+        };
+        const std::string label = field(col_label2);
+        const std::string n0p = field(col_n0_2);
+        const std::string cpmin = field(col_cmin_2);
+        const std::string n1p = field(col_n1_2);
+        const std::string cpmax = field(col_cmax_2);
+        const std::string ngeomp = field(col_ngeom_2);
+        const std::string cpavg = field(col_cavg_2);
+        const double n_align = col_nalign > 0 ? toNum(field(col_nalign)) : 0;
+        const double c_align = col_calign > 0 ? toNum(field(col_calign)) : 0;
+        const double n_alignmax = col_nalignmax > 0 ? toNum(field(col_nalignmax)) : 0;
+        const double c_alignmax = col_calignmax > 0 ? toNum(field(col_calignmax)) : 0;
+        const double n_cbound = col_ncbound > 0 ? toNum(field(col_ncbound)) : 0;
+        const double c_cbound = col_ccbound > 0 ? toNum(field(col_ccbound)) : 0;
+        const double n_cboundmax = col_ncboundmax > 0 ? toNum(field(col_ncboundmax)) : 0;
+        const double c_cboundmax = col_ccboundmax > 0 ? toNum(field(col_ccboundmax)) : 0;
+
+        const std::string key = v02 ? ngeomp : (label + '\034' + ngeomp);
+        auto it = rows.find(key);
+        if (it == rows.end()) {
+            std::fprintf(stderr, "ERROR: no match for %s=%s n_geom=%s in file1\n",
+                v02 ? "START" : "DECADE", label.c_str(), ngeomp.c_str());
+            std::fprintf(stderr, "ERROR: Processing files: file1='%s' file2='%s'\n", file1, file2);
+            return 1;
+        }
+        const SumRow &r = it->second;
+        if (v02) {
+            std::printf("%s,%lld,%.6f,%lld,%.6f,%lld,%.8f,%lld,%.8f,%.0f,%.9f,%.9f,%lld,%.6f,%lld,%.8f,%lld,%.6f,%lld,%.8f\n",
+                r.label.c_str(), (long long)toNum(r.n0), toNum(r.cmin),
+                (long long)toNum(n0p), toNum(cpmin),
+                (long long)toNum(r.n1), toNum(r.cmax),
+                (long long)toNum(n1p), toNum(cpmax),
+                toNum(r.ngeom), toNum(r.cavg), toNum(cpavg),
+                (long long)n_align, c_align, (long long)n_alignmax, c_alignmax,
+                (long long)n_cbound, c_cbound, (long long)n_cboundmax, c_cboundmax);
+        }
+        else {
+            std::printf("%s,%lld,%.6f,%lld,%.8f,%lld,%.6f,%lld,%.8f,%.0f,%.6f,%.8f\n",
+                r.label.c_str(), (long long)toNum(r.n0), toNum(r.cmin),
+                (long long)toNum(n0p), toNum(cpmin),
+                (long long)toNum(r.n1), toNum(r.cmax),
+                (long long)toNum(n1p), toNum(cpmax),
+                toNum(r.ngeom), toNum(r.cavg), toNum(cpavg));
+        }
+    }
+    return 0;
+}
+
+// ----- entry point -----
+
+static void usage(const char* prog) {
+    std::fprintf(stderr,
+        "Usage: %s <command> [args]\n"
+        "Commands:\n"
+        "  merge-cps FILE...           Merge CPS lower bound shards, inheriting blank\n"
+        "                              preMertens columns (mergeCPSLowerBound.awk)\n"
+        "  lambda-stats FILE           Per-decade |Lambda| order statistics\n"
+        "                              (lambdaStats.awk)\n"
+        "  join-sum-pred FILE1 FILE2   Join summary and HLA full output for plotting;\n"
+        "                              reads VERSION from the environment\n"
+        "                              (joinSumPred.awk)\n", prog);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (!std::strcmp(argv[1], "merge-cps") && argc >= 3) {
+        return cmdMergeCps(argc - 2, argv + 2);
+    }
+    if (!std::strcmp(argv[1], "lambda-stats") && argc == 3) {
+        return cmdLambdaStats(argv[2]);
+    }
+    if (!std::strcmp(argv[1], "join-sum-pred") && argc == 4) {
+        return cmdJoinSumPred(argv[2], argv[3]);
+    }
+    usage(argv[0]);
+    return 1;
+}
@@ -150,3 +150,109 @@ BnormOut calcBnormSymmetric(
     return out;
 }
 
+void calcBnormSymmetricBatch(
+    const uint64_t *ns,
+    size_t count,
+    uint64_t M,
+    const uint64_t *odd_pr_begin,
+    size_t plen,
+    const double *cum,
+    BnormOut *out)
+{
+    if (count == 0U) {
+        return;
+    }
+    if (M == 0ULL || plen == 0U || odd_pr_begin == NULL || cum == NULL) {
+        for (size_t i = 0U; i < count; ++i) {
+            out[i] = calcBnormSymmetric(ns[i], M, odd_pr_begin, plen, cum);
+        }
+        return;
+    }
+    if (*odd_pr_begin == 2ULL) {
+        odd_pr_begin += 1;
+        plen -= 1U;
+    }
+    const uint64_t *odd_pr_end = odd_pr_begin + plen;
+
+    uint64_t lo = ns[0];
+    uint64_t hi = ns[0];
+    for (size_t i = 1U; i < count; ++i) {
+        if (ns[i] < lo) {
+            lo = ns[i];
+        }
+        if (ns[i] > hi) {
+            hi = ns[i];
+        }
+    }
+    hi += M;
+
+    /* The shared sweep costs O(span); per-call costs O(M log plen).  For
+       sparse inputs (or a window past the covered range) the calls win. */
+    const uint64_t t0 = (((lo + 1ULL) & 1ULL) == 1ULL) ? lo + 1ULL : lo + 2ULL;
+    if (t0 > hi || (long double)(hi - lo) > (long double)count * (long double)M) {
+        for (size_t i = 0U; i < count; ++i) {
+            out[i] = calcBnormSymmetric(ns[i], M, odd_pr_begin, plen, cum);
+        }
+        return;
+    }
+
+    const size_t nodd = (size_t)((hi - t0) / 2ULL) + 1U;
+    double *bt = (double *)malloc(nodd * sizeof(double));
+    long double *pre = (long double *)malloc((nodd + 1U) * sizeof(long double));
+    if (bt == NULL || pre == NULL) {
+        free(bt);
+        free(pre);
+        for (size_t i = 0U; i < count; ++i) {
+            out[i] = calcBnormSymmetric(ns[i], M, odd_pr_begin, plen, cum);
+        }
+        return;
+    }
+
+    /* Pass 1: fence y = floor(sqrt(t)) for every odd t covered by any
+       window.  Straight-line loop so the compiler can use SIMD sqrt. */
+    for (size_t j = 0U; j < nodd; ++j) {
+        bt[j] = floor(sqrt((double)(t0 + 2ULL * (uint64_t)j)));
+    }
+
+    /* Pass 2: y -> B_ref, re-searching cumprod only when the fence moves
+       (it moves O(sqrt(span)) times, not once per t). */
+    uint64_t last_y = UINT64_MAX;
+    double last_b = 1.0;
+    for (size_t j = 0U; j < nodd; ++j) {
+        const uint64_t y = (uint64_t)bt[j];
+        if (y != last_y) {
+            last_b = bref_from_y(y, odd_pr_begin, odd_pr_end, cum);
+            last_y = y;
+        }
+        bt[j] = last_b;
+    }
+
+    /* Pass 3: prefix sums in long double, so the per-n window sum is one
+       difference with full double accuracy.  Summation order differs from
+       the per-call API by at most the usual reassociation rounding. */
+    pre[0] = 0.0L;
+    for (size_t j = 0U; j < nodd; ++j) {
+        pre[j + 1U] = pre[j] + (long double)bt[j];
+    }
+
+    for (size_t i = 0U; i < count; ++i) {
+        const uint64_t n = ns[i];
+        BnormOut o;
+        o.bwin    = 0.0;
+        o.bnorm   = 0.0;
+        o.ipar_sz = calcIparSize(n, M);
+        if (o.ipar_sz != 0ULL) {
+            /* odd t in (n, n+M]: count of odd t <= x is (x-t0)/2+1 for x >= t0 */
+            const size_t a = (n >= t0) ? (size_t)((n - t0) / 2ULL) + 1U : 0U;
+            const size_t b = (size_t)((n + M - t0) / 2ULL) + 1U;
+            o.bwin = 2.0 * (double)(pre[b] - pre[a]);
+            const double L = log((double)n);
+            o.bnorm = (L * L) / (4*KAPPA * (double)o.ipar_sz) * o.bwin;
+        }
+        out[i] = o;
+    }
+
+    free(bt);
+    free(pre);
+}
+
@@ -47,5 +47,20 @@ BnormOut calcBnormSymmetric(
     size_t plen,
     const double *cum);
 
+/* Batch form for runs of n sharing one window size M: the B_ref values for
+   every odd t any window touches are computed in one vectorizable sweep and
+   prefix-summed, so each n costs one subtraction instead of an O(M) loop
+   with repeated cumprod searches.  ns need not be sorted; sparse inputs
+   (span larger than count*M) fall back to per-call evaluation.  Results
+   agree with calcBnormSymmetric up to floating-point summation order. */
+void calcBnormSymmetricBatch(
+    const uint64_t *ns,
+    size_t count,
+    uint64_t M,
+    const uint64_t *odd_pr_begin,
+    size_t plen,
+    const double *cum,
+    BnormOut *out);
+
 #endif /* CALC_BNORM_SYMMETRIC_H */
 
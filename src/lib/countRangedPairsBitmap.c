@@ -0,0 +1,101 @@
+// countRangedPairsBitmap - popcount pair counting over the odd-prime bitmap
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdint.h>
+#include <string.h>
+#include "libprime.h"
+
+// Byte bit-reversal table, generated by the classic macro expansion.
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4 ), R4(n + 1*4 ), R4(n + 3*4 )
+static const uint8_t rev8[256] = { R6(0), R6(2), R6(1), R6(3) };
+#undef R2
+#undef R4
+#undef R6
+
+static inline uint64_t rev64(uint64_t x) {
+    uint64_t r = 0;
+    for (int k = 0; k < 8; ++k) {
+        r = (r << 8) | rev8[x & 0xff];
+        x >>= 8;
+    }
+    return r;
+}
+
+// Load 64 bits of the bitmap starting at bit offset `bit`.  The bitmap is
+// LSB-first within each byte, which matches a little-endian 64-bit load.
+// May read one byte past the aligned 8; callers guard the upper bound.
+static inline uint64_t load_bits64(const uint8_t *bm, uint64_t bit) {
+    uint64_t w;
+    memcpy(&w, bm + (bit >> 3), sizeof(w));
+    const unsigned shift = (unsigned)(bit & 7);
+    if (shift) {
+        w = (w >> shift) | ((uint64_t)bm[(bit >> 3) + 8] << (64 - shift));
+    }
+    return w;
+}
+
+// Count ordered Goldbach pairs p+q=2n with p>n_min directly on the odd-prime
+// bitmap from primesieve_bitmap (bit i <=> 2i+3 is prime).  A pair exists
+// exactly when bit(i) AND bit(m-i) with m = n-3, so the count is a popcount
+// of the lower-side words ANDed with the bit-reversed upper-side words.
+// Matches countRangedPairs: excludes the diagonal (n,n), counts each
+// unordered pair twice, and returns ~0ULL when the bitmap is too small to
+// cover the upper side of the window.
+uint64_t countRangedPairsBitmap(
+    const uint64_t n,
+    const uint64_t n_min,
+    const uint8_t *bitmap,
+    const uint64_t bitmap_bits
+) {
+    if (n < 4) {
+        return 0;
+    }
+    const uint64_t m = n - 3;                              // j = m - i pairs 2i+3 with 2n-(2i+3)
+    uint64_t i = (n_min >= 3) ? ((n_min - 3) >> 1) + 1 : 0; // first odd p > n_min
+    const uint64_t i_end = (n - 4) >> 1;                   // last odd p < n
+    if (i > i_end) {
+        return 0;
+    }
+    if (m - i >= bitmap_bits) { // out of primes to the right
+        return ~0ULL;
+    }
+    const uint64_t bytes = (bitmap_bits + 7) >> 3;
+    uint64_t count = 0;
+    // Word kernel: bits [i, i+63] of the lower side ANDed with the
+    // bit-reversed window [j-63, j] of the upper side, j = m - i.
+    while (i + 63 <= i_end) {
+        const uint64_t j = m - i;
+        if (j < 63 || ((i + 63) >> 3) + 9 > bytes || ((j - 63) >> 3) + 9 > bytes) {
+            break;
+        }
+        const uint64_t a = load_bits64(bitmap, i);
+        const uint64_t b = rev64(load_bits64(bitmap, j - 63));
+        count += (uint64_t)__builtin_popcountll(a & b);
+        i += 64;
+    }
+    // Scalar tail
+    for (; i <= i_end; ++i) {
+        const uint64_t j = m - i;
+        if ((bitmap[i >> 3] & (1u << (i & 7))) && (bitmap[j >> 3] & (1u << (j & 7)))) {
+            count++;
+        }
+    }
+    return count << 1;
+}
@@ -0,0 +1,104 @@
+// findPairBitmap - find the lowest m of Goldbach pairs on the odd-prime bitmap
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdint.h>
+#include <string.h>
+#include "libprime.h"
+
+// Byte bit-reversal table, generated by the classic macro expansion.
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4 ), R4(n + 1*4 ), R4(n + 3*4 )
+static const uint8_t rev8[256] = { R6(0), R6(2), R6(1), R6(3) };
+#undef R2
+#undef R4
+#undef R6
+
+static inline uint64_t rev64(uint64_t x) {
+    uint64_t r = 0;
+    for (int k = 0; k < 8; ++k) {
+        r = (r << 8) | rev8[x & 0xff];
+        x >>= 8;
+    }
+    return r;
+}
+
+// Load 64 bits of the bitmap starting at bit offset `bit`.  The bitmap is
+// LSB-first within each byte, which matches a little-endian 64-bit load.
+// May read one byte past the aligned 8; callers guard the upper bound.
+static inline uint64_t load_bits64(const uint8_t *bm, uint64_t bit) {
+    uint64_t w;
+    memcpy(&w, bm + (bit >> 3), sizeof(w));
+    const unsigned shift = (unsigned)(bit & 7);
+    if (shift) {
+        w = (w >> shift) | ((uint64_t)bm[(bit >> 3) + 8] << (64 - shift));
+    }
+    return w;
+}
+
+// Find the minimum m > 0 value for Q_m (n-m)(n+m) for Goldbach pairs p+q=2n
+// directly on the odd-prime bitmap (bit i <=> 2i+3 is prime).  The lower
+// side is walked downward from n a word at a time: the bit-reversed window
+// [i-63, i] ANDed with the upper-side window [M-i, M-i+63] (M = n-3) has a
+// set bit exactly where both n-m and n+m are prime, and the lowest set bit
+// is the smallest m.  Matches findPair(): p=2 never pairs, the diagonal
+// (n,n) is only reported when nothing else pairs, and -1 means the bitmap
+// ends before the upper side of a candidate pair.
+int findPairBitmap(
+    const uint64_t n,
+    const uint8_t *bitmap,
+    const uint64_t bitmap_bits
+) {
+    if (n < 4) {
+        return -1;
+    }
+    const uint64_t M = n - 3;            // i + j = M pairs 2i+3 with 2n-(2i+3)
+    uint64_t i = (n - 3) >> 1;           // largest i with 2i+3 <= n
+    if ((n & 1) && i) {
+        --i;                             // skip the diagonal p = q = n
+    }
+    const uint64_t bytes = (bitmap_bits + 7) >> 3;
+    // Word kernel while both windows fit inside the bitmap.
+    while (i >= 63) {
+        const uint64_t j = M - i;
+        if (j + 63 >= bitmap_bits || (j >> 3) + 9 > bytes || ((i - 63) >> 3) + 9 > bytes) {
+            break;
+        }
+        const uint64_t hit = rev64(load_bits64(bitmap, i - 63)) & load_bits64(bitmap, j);
+        if (hit) {
+            const uint64_t ip = i - (uint64_t)__builtin_ctzll(hit);
+            return (int)(n - (2*ip + 3));
+        }
+        i -= 64;
+    }
+    // Scalar tail down to p = 3.
+    for (;; --i) {
+        const uint64_t j = M - i;
+        if (j >= bitmap_bits) {          // out of primes to the right
+            return -1;
+        }
+        if ((bitmap[i >> 3] & (1u << (i & 7))) && (bitmap[j >> 3] & (1u << (j & 7)))) {
+            return (int)(n - (2*i + 3));
+        }
+        if (i == 0) {
+            break;
+        }
+    }
+    // No pair with m > 0: report the diagonal when n itself is an odd prime.
+    return ((n & 1) && ((n - 3) >> 1) < bitmap_bits && is_odd_prime_fast(n, bitmap)) ? 0 : -1;
+}
@@ -0,0 +1,295 @@
+// gbColumnar - binary columnar writer/reader for interval summary rows
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Format: 8-byte magic "GBCOL001", uint32 column count, uint32 header
+// length, uint64 row count, the CSV header line, then per column a type
+// tag byte ('u' uint64, 'f' long double, 's' string), a format length
+// byte and the printf format the equivalent CSV stream uses.  Column data
+// follows as one packed section per column in declaration order; string
+// sections are a uint64 blob length, one uint64 offset per row, then the
+// NUL-terminated strings.  Like the raw prime files everything is stored
+// native-endian, and long doubles are the platform representation, so the
+// converter reproduces the CSV byte for byte on the machine that wrote it.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "libprime.h"
+
+static const char GBCOL_MAGIC[8] = "GBCOL001";
+
+static size_t col_elem_size(char type) {
+    return (type == 'f') ? sizeof(long double) : sizeof(uint64_t);
+}
+
+int gbColumnarWriterInit(GBColumnarWriter *w, FILE *out, const char *headerLine, const char *types, const char *const *formats) {
+    memset(w, 0, sizeof(*w));
+    const size_t ncols = strlen(types);
+    if (!out || ncols == 0 || ncols > GBCOL_MAX_COLS) {
+        return -1;
+    }
+    for (size_t i = 0; i < ncols; i++) {
+        if (types[i] != 'u' && types[i] != 'f' && types[i] != 's') {
+            return -1;
+        }
+        if (!formats[i] || strlen(formats[i]) > 255) {
+            return -1;
+        }
+        w->formats[i] = strdup(formats[i]);
+        if (!w->formats[i]) {
+            return -1;
+        }
+    }
+    w->out = out;
+    w->ncols = (uint32_t)ncols;
+    memcpy(w->types, types, ncols + 1);
+    w->header = strdup(headerLine ? headerLine : "");
+    return w->header ? 0 : -1;
+}
+
+int gbColumnarWriterAppend(GBColumnarWriter *w, const GBColValue *row) {
+    if (w->nrows == w->cap) {
+        const uint64_t cap = w->cap ? w->cap * 2 : 256;
+        for (uint32_t i = 0; i < w->ncols; i++) {
+            void *p = realloc(w->cols[i], (size_t)cap * col_elem_size(w->types[i]));
+            if (!p) {
+                return -1;
+            }
+            w->cols[i] = p;
+        }
+        w->cap = cap;
+    }
+    for (uint32_t i = 0; i < w->ncols; i++) {
+        switch (w->types[i]) {
+        case 'u':
+            ((uint64_t *)w->cols[i])[w->nrows] = row[i].u;
+            break;
+        case 'f':
+            ((long double *)w->cols[i])[w->nrows] = row[i].f;
+            break;
+        default: {
+            const char *s = row[i].s ? row[i].s : "";
+            const size_t len = strlen(s) + 1;
+            if (w->sblob_len + len > w->sblob_cap) {
+                const uint64_t cap = (w->sblob_cap ? w->sblob_cap * 2 : 4096) + len;
+                char *p = realloc(w->sblob, (size_t)cap);
+                if (!p) {
+                    return -1;
+                }
+                w->sblob = p;
+                w->sblob_cap = cap;
+            }
+            ((uint64_t *)w->cols[i])[w->nrows] = w->sblob_len;
+            memcpy(w->sblob + w->sblob_len, s, len);
+            w->sblob_len += len;
+            break;
+        }
+        }
+    }
+    w->nrows++;
+    return 0;
+}
+
+int gbColumnarWriterClose(GBColumnarWriter *w) {
+    int retval = 0;
+    FILE *out = w->out;
+    if (out) {
+        const uint32_t header_len = (uint32_t)strlen(w->header);
+        if (fwrite(GBCOL_MAGIC, 1, sizeof(GBCOL_MAGIC), out) != sizeof(GBCOL_MAGIC)
+            || fwrite(&w->ncols, sizeof(w->ncols), 1, out) != 1
+            || fwrite(&header_len, sizeof(header_len), 1, out) != 1
+            || fwrite(&w->nrows, sizeof(w->nrows), 1, out) != 1
+            || (header_len && fwrite(w->header, 1, header_len, out) != header_len)) {
+            retval = -1;
+        }
+        for (uint32_t i = 0; retval == 0 && i < w->ncols; i++) {
+            const uint8_t type = (uint8_t)w->types[i];
+            const uint8_t fmt_len = (uint8_t)strlen(w->formats[i]);
+            if (fwrite(&type, 1, 1, out) != 1
+                || fwrite(&fmt_len, 1, 1, out) != 1
+                || fwrite(w->formats[i], 1, fmt_len, out) != fmt_len) {
+                retval = -1;
+            }
+        }
+        for (uint32_t i = 0; retval == 0 && i < w->ncols; i++) {
+            const size_t elem = col_elem_size(w->types[i]);
+            if (w->types[i] == 's'
+                && fwrite(&w->sblob_len, sizeof(w->sblob_len), 1, out) != 1) {
+                retval = -1;
+                break;
+            }
+            if (w->nrows && fwrite(w->cols[i], elem, w->nrows, out) != w->nrows) {
+                retval = -1;
+                break;
+            }
+            if (w->types[i] == 's' && w->sblob_len
+                && fwrite(w->sblob, 1, w->sblob_len, out) != w->sblob_len) {
+                retval = -1;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < w->ncols; i++) {
+        free(w->cols[i]);
+        free(w->formats[i]);
+    }
+    free(w->sblob);
+    free(w->header);
+    memset(w, 0, sizeof(*w));
+    return retval;
+}
+
+int isGBColumnarData(const uint8_t *data, size_t len) {
+    return len >= sizeof(GBCOL_MAGIC) && memcmp(data, GBCOL_MAGIC, sizeof(GBCOL_MAGIC)) == 0;
+}
+
+// A stored format must be a single plain conversion so formatRow cannot be
+// steered by a crafted file (no %n, no extra conversions).
+static int format_ok(const char *fmt, size_t len) {
+    size_t conversions = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (fmt[i] == '%') {
+            conversions++;
+        }
+        if (fmt[i] == 'n') {
+            return 0;
+        }
+    }
+    return conversions == 1;
+}
+
+int gbColumnarReaderInit(GBColumnarReader *r, const uint8_t *data, size_t len) {
+    memset(r, 0, sizeof(*r));
+    if (!isGBColumnarData(data, len) || len < 24) {
+        return -1;
+    }
+    memcpy(&r->ncols, data + 8, sizeof(r->ncols));
+    memcpy(&r->header_len, data + 12, sizeof(r->header_len));
+    memcpy(&r->nrows, data + 16, sizeof(r->nrows));
+    if (r->ncols == 0 || r->ncols > GBCOL_MAX_COLS) {
+        return -1;
+    }
+    size_t pos = 24;
+    if (pos + r->header_len > len) {
+        return -1;
+    }
+    r->header = (const char *)(data + pos);
+    pos += r->header_len;
+    for (uint32_t i = 0; i < r->ncols; i++) {
+        if (pos + 2 > len) {
+            return -1;
+        }
+        const char type = (char)data[pos];
+        const uint8_t fmt_len = data[pos + 1];
+        pos += 2;
+        if ((type != 'u' && type != 'f' && type != 's')
+            || pos + fmt_len + 1 > len
+            || !format_ok((const char *)(data + pos), fmt_len)) {
+            return -1;
+        }
+        r->types[i] = type;
+        r->formats[i] = (const char *)(data + pos);
+        pos += fmt_len;
+    }
+    // The format strings are not NUL-terminated in the file; they are only
+    // consumed through formatRow, which copies them out bounded by the
+    // stored length, so keep per-column lengths recoverable from layout.
+    for (uint32_t i = 0; i < r->ncols; i++) {
+        r->coldata[i] = data + pos;
+        if (r->types[i] == 's') {
+            if (pos + 8 > len) {
+                return -1;
+            }
+            uint64_t blob_len;
+            memcpy(&blob_len, data + pos, sizeof(blob_len));
+            pos += 8 + (size_t)r->nrows * 8 + (size_t)blob_len;
+        }
+        else {
+            pos += (size_t)r->nrows * col_elem_size(r->types[i]);
+        }
+        if (pos > len) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+uint64_t gbColumnarU64(const GBColumnarReader *r, uint32_t col, uint64_t row) {
+    uint64_t v;
+    memcpy(&v, r->coldata[col] + row * sizeof(v), sizeof(v));
+    return v;
+}
+
+long double gbColumnarF(const GBColumnarReader *r, uint32_t col, uint64_t row) {
+    long double v;
+    memcpy(&v, r->coldata[col] + row * sizeof(v), sizeof(v));
+    return v;
+}
+
+const char *gbColumnarStr(const GBColumnarReader *r, uint32_t col, uint64_t row) {
+    uint64_t blob_len, offset;
+    memcpy(&blob_len, r->coldata[col], sizeof(blob_len));
+    memcpy(&offset, r->coldata[col] + 8 + row * 8, sizeof(offset));
+    if (offset >= blob_len) {
+        return "";
+    }
+    return (const char *)(r->coldata[col] + 8 + r->nrows * 8 + offset);
+}
+
+int gbColumnarFormatRow(const GBColumnarReader *r, uint64_t row, char *buf, size_t buflen) {
+    size_t pos = 0;
+    const uint8_t *fmt_cursor;
+    for (uint32_t i = 0; i < r->ncols; i++) {
+        char fmt[260];
+        // Recover the stored format length from the adjacent field layout.
+        fmt_cursor = (const uint8_t *)r->formats[i];
+        const size_t fmt_len = (i + 1 < r->ncols)
+            ? (size_t)((const uint8_t *)r->formats[i + 1] - 2 - fmt_cursor)
+            : (size_t)(r->coldata[0] - fmt_cursor);
+        if (fmt_len >= sizeof(fmt) - 1) {
+            return -1;
+        }
+        memcpy(fmt, fmt_cursor, fmt_len);
+        fmt[fmt_len] = '\0';
+        if (pos + 2 >= buflen) {
+            return -1;
+        }
+        if (i > 0) {
+            buf[pos++] = ',';
+        }
+        int written;
+        switch (r->types[i]) {
+        case 'u':
+            written = snprintf(buf + pos, buflen - pos, fmt, gbColumnarU64(r, i, row));
+            break;
+        case 'f':
+            written = snprintf(buf + pos, buflen - pos, fmt, gbColumnarF(r, i, row));
+            break;
+        default:
+            written = snprintf(buf + pos, buflen - pos, fmt, gbColumnarStr(r, i, row));
+            break;
+        }
+        if (written < 0 || pos + (size_t)written + 2 > buflen) {
+            return -1;
+        }
+        pos += (size_t)written;
+    }
+    buf[pos++] = '\n';
+    buf[pos] = '\0';
+    return (int)pos;
+}
@@ -0,0 +1,214 @@
+// gbCsv - zero-copy CSV scanning shared by the CSV-reading tools
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Header-only and C++ only (the validators and mergecps are the
+// consumers); the C library proper stays in libprime.h.  The file is
+// mapped read-only in one piece, lines and fields are borrowed views
+// split with memchr, and numbers convert with std::from_chars straight
+// from the mapping - no per-line allocation and no NUL termination
+// needed, so a run over a multi-GB summary touches each byte once.
+
+#ifndef GBCSV_HPP
+#define GBCSV_HPP 1
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A borrowed, whitespace-trimmed view of one field.  Valid only while
+// the backing buffer (usually a GBCsvFile mapping) stays alive.
+struct GBCsvField {
+    const char *p = nullptr;
+    std::size_t len = 0;
+
+    bool empty() const { return len == 0; }
+
+    bool equals(const char *s) const {
+        return std::strlen(s) == len && (len == 0 || std::memcmp(p, s, len) == 0);
+    }
+
+    std::string str() const { return std::string(p, len); }
+};
+
+// Split [begin,end) on commas into at most max field views, trimming
+// the whitespace around each field like the strtoull-based parsers the
+// tools used before.  Returns the number of fields present on the line,
+// which may exceed max; only the first max are stored.
+static inline std::size_t gbCsvSplit(const char *begin, const char *end,
+                                     GBCsvField *fields, std::size_t max)
+{
+    std::size_t count = 0;
+    const char *p = begin;
+    for (;;) {
+        const char *comma = (const char *)memchr(p, ',', (std::size_t)(end - p));
+        const char *a = p;
+        const char *b = comma ? comma : end;
+        while (a < b && isspace((unsigned char)*a)) ++a;
+        while (b > a && isspace((unsigned char)b[-1])) --b;
+        if (count < max) {
+            fields[count].p = a;
+            fields[count].len = (std::size_t)(b - a);
+        }
+        ++count;
+        if (!comma) {
+            break;
+        }
+        p = comma + 1;
+    }
+    return count;
+}
+
+// Whole-field numeric conversions; reject trailing junk like the
+// strtoull/strtold end-pointer checks they replace.
+static inline bool gbCsvU64(const GBCsvField &f, std::uint64_t &out)
+{
+    if (!f.len) {
+        return false;
+    }
+    auto r = std::from_chars(f.p, f.p + f.len, out, 10);
+    return r.ec == std::errc() && r.ptr == f.p + f.len;
+}
+
+static inline bool gbCsvLd(const GBCsvField &f, long double &out)
+{
+    if (!f.len) {
+        return false;
+    }
+    auto r = std::from_chars(f.p, f.p + f.len, out);
+    return r.ec == std::errc() && r.ptr == f.p + f.len;
+}
+
+// Sequential line scanner over an in-memory buffer.  Lines are returned
+// as [begin,end) views with the trailing CR of CRLF files stripped and
+// the UTF-8 BOM removed from the first line; empty lines are returned
+// too so callers keep their own skip/line-count policy.
+class GBCsvLines {
+public:
+    const char *begin = nullptr;  // current line
+    const char *end = nullptr;
+    std::size_t lineNum = 0;      // 1-based, counts every line returned
+
+    void init(const void *data, std::size_t len) {
+        cursor_ = (const char *)data;
+        limit_ = cursor_ + len;
+        lineNum = 0;
+        firstLine_ = true;
+    }
+
+    bool next() {
+        if (cursor_ >= limit_) {
+            return false;
+        }
+        const char *nl = (const char *)memchr(cursor_, '\n', (std::size_t)(limit_ - cursor_));
+        begin = cursor_;
+        end = nl ? nl : limit_;
+        cursor_ = nl ? nl + 1 : limit_;
+        ++lineNum;
+        if (end > begin && end[-1] == '\r') {
+            --end;
+        }
+        if (firstLine_) {
+            firstLine_ = false;
+            if (end - begin >= 3 &&
+                (unsigned char)begin[0] == 0xEF &&
+                (unsigned char)begin[1] == 0xBB &&
+                (unsigned char)begin[2] == 0xBF) {
+                begin += 3;
+            }
+        }
+        return true;
+    }
+
+    bool emptyLine() const { return begin == end; }
+
+private:
+    const char *cursor_ = nullptr;
+    const char *limit_ = nullptr;
+    bool firstLine_ = true;
+};
+
+// Read-only mapping of a whole CSV file with a line scanner over it.
+// open() returns 0 on success and -1 with errno set, so each tool keeps
+// its own error reporting.  An empty file maps to an empty scan.
+class GBCsvFile {
+public:
+    GBCsvLines lines;
+
+    int open(const char *path) {
+        close();
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) {
+            return -1;
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd_);
+            fd_ = -1;
+            return -1;
+        }
+        len_ = (std::size_t)st.st_size;
+        if (len_) {
+            void *addr = ::mmap(nullptr, len_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd_);
+                fd_ = -1;
+                len_ = 0;
+                return -1;
+            }
+            p_ = (const char *)addr;
+#if defined(MADV_SEQUENTIAL)
+            (void)::madvise((void *)p_, len_, MADV_SEQUENTIAL);
+#endif
+        }
+        lines.init(p_, len_);
+        return 0;
+    }
+
+    void close() {
+        if (p_ && len_) {
+            ::munmap((void *)p_, len_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+        len_ = 0;
+        p_ = nullptr;
+        lines.init(nullptr, 0);
+    }
+
+    const char *data() const { return p_; }
+    std::size_t size() const { return len_; }
+
+    ~GBCsvFile() { close(); }
+
+private:
+    int fd_ = -1;
+    std::size_t len_ = 0;
+    const char *p_ = nullptr;
+};
+
+#endif // GBCSV_HPP
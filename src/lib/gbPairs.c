@@ -1,11 +1,11 @@
-// openPipe - opens a pipe (used in earlier versions)
+// gbPairs - binary gbpairs file helpers
 // Copyright (C) 2025 Bill C. Riemers
-// 
+//
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
 // the Free Software Foundation, either version 3 of the License, or
 // (at your option) any later version.
-// 
+//
 // This program is distributed in the hope that it will be useful,
 // but WITHOUT ANY WARRANTY; without even the implied warranty of
 // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
@@ -16,20 +16,12 @@
 
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <string.h>
-#include <stdlib.h>
 #include "libprime.h"
 
-FILE* pipeOpen(const char *cmdf,const char *filename,const char *opts) {
-    if(! cmdf || ! filename || ! opts) {
-       return NULL;
-    }
-    int cmdlen = strlen(cmdf)+strlen(filename);
-    char *cmd = (char *)calloc(cmdlen,sizeof(char));
-    snprintf(cmd, cmdlen, cmdf, filename);
-    FILE* fp = popen(cmd, opts);
-    free(cmd);
-    return fp;
+int isGBPairsData(const uint8_t *data, size_t len) {
+    return len >= GB_PAIRS_HDR_BYTES &&
+           memcmp(data, GB_PAIRS_MAGIC, GB_PAIRS_HDR_BYTES) == 0;
 }
-
@@ -0,0 +1,130 @@
+// gbSha256 - SHA-256 for content-addressed stage caching
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Straightforward FIPS 180-4 implementation; streaming interface so
+// multi-GB inputs hash without being held in memory.
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include "libprime.h"
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR(x,n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_block(GBSha256 *s, const uint8_t *p) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = ((uint32_t)p[4*i] << 24) | ((uint32_t)p[4*i+1] << 16)
+             | ((uint32_t)p[4*i+2] << 8) | (uint32_t)p[4*i+3];
+    }
+    for (int i = 16; i < 64; ++i) {
+        const uint32_t s0 = ROTR(w[i-15], 7) ^ ROTR(w[i-15], 18) ^ (w[i-15] >> 3);
+        const uint32_t s1 = ROTR(w[i-2], 17) ^ ROTR(w[i-2], 19) ^ (w[i-2] >> 10);
+        w[i] = w[i-16] + s0 + w[i-7] + s1;
+    }
+    uint32_t a = s->h[0], b = s->h[1], c = s->h[2], d = s->h[3];
+    uint32_t e = s->h[4], f = s->h[5], g = s->h[6], h = s->h[7];
+    for (int i = 0; i < 64; ++i) {
+        const uint32_t S1 = ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25);
+        const uint32_t ch = (e & f) ^ (~e & g);
+        const uint32_t t1 = h + S1 + ch + K[i] + w[i];
+        const uint32_t S0 = ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22);
+        const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t t2 = S0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    s->h[0] += a; s->h[1] += b; s->h[2] += c; s->h[3] += d;
+    s->h[4] += e; s->h[5] += f; s->h[6] += g; s->h[7] += h;
+}
+
+void gbSha256Init(GBSha256 *s) {
+    s->h[0] = 0x6a09e667; s->h[1] = 0xbb67ae85;
+    s->h[2] = 0x3c6ef372; s->h[3] = 0xa54ff53a;
+    s->h[4] = 0x510e527f; s->h[5] = 0x9b05688c;
+    s->h[6] = 0x1f83d9ab; s->h[7] = 0x5be0cd19;
+    s->len = 0;
+    s->buflen = 0;
+}
+
+void gbSha256Update(GBSha256 *s, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    s->len += len;
+    if (s->buflen) {
+        while (len && s->buflen < 64) {
+            s->buf[s->buflen++] = *p++;
+            len--;
+        }
+        if (s->buflen == 64) {
+            sha256_block(s, s->buf);
+            s->buflen = 0;
+        }
+    }
+    while (len >= 64) {
+        sha256_block(s, p);
+        p += 64;
+        len -= 64;
+    }
+    while (len--) {
+        s->buf[s->buflen++] = *p++;
+    }
+}
+
+void gbSha256Final(GBSha256 *s, uint8_t digest[32]) {
+    const uint64_t bits = s->len << 3;
+    uint8_t pad = 0x80;
+    gbSha256Update(s, &pad, 1);
+    pad = 0;
+    while (s->buflen != 56) {
+        gbSha256Update(s, &pad, 1);
+    }
+    uint8_t lenb[8];
+    for (int i = 0; i < 8; ++i) {
+        lenb[i] = (uint8_t)(bits >> (56 - 8*i));
+    }
+    gbSha256Update(s, lenb, 8);
+    for (int i = 0; i < 8; ++i) {
+        digest[4*i]   = (uint8_t)(s->h[i] >> 24);
+        digest[4*i+1] = (uint8_t)(s->h[i] >> 16);
+        digest[4*i+2] = (uint8_t)(s->h[i] >> 8);
+        digest[4*i+3] = (uint8_t)(s->h[i]);
+    }
+}
+
+void gbSha256Hex(const uint8_t digest[32], char hex[65]) {
+    static const char d[] = "0123456789abcdef";
+    for (int i = 0; i < 32; ++i) {
+        hex[2*i]   = d[digest[i] >> 4];
+        hex[2*i+1] = d[digest[i] & 0xf];
+    }
+    hex[64] = '\0';
+}
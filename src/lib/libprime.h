@@ -26,8 +26,6 @@
 extern "C" {
 #endif
 
-extern FILE* pipeOpen(const char *cmdf,const char *filename,const char *opts);
-
 static inline int is_odd_prime_fast(uint64_t n, const uint8_t* bitmap) {
     const uint64_t i = (n - 3) >> 1; // start at 3, only odds
     return bitmap[i >> 3] & (1 << (i & 7));
@@ -39,6 +37,34 @@ static inline int is_odd_prime(uint64_t n, const uint8_t* bitmap) {
     return bitmap[i >> 3] & (1 << (i & 7));
 }
 
+// ----- Wheel-30 bitmap format (gbWheel30.c) -----
+// One byte per 30 integers: bit j of payload byte b is the primality of
+// 30*b + gbWheel30Residues[j].  Numbers sharing a factor with 30 have no
+// bit; 2, 3 and 5 are the callers' special case.  Files carry an 8-byte
+// magic so readers can tell the format from the odd-only bitmap.
+#define GB_WHEEL30_MAGIC "GBWHEEL0"
+#define GB_WHEEL30_HDR_BYTES 8
+
+extern const uint8_t gbWheel30Residues[8];  /* {1,7,11,13,17,19,23,29} */
+extern const uint8_t gbWheel30Index[30];    /* residue -> bit, 0xFF = no bit */
+
+// Nonzero when data starts with the wheel-30 magic.
+extern int isWheel30Bitmap(const uint8_t *data, size_t len);
+
+// bm points past the header; payload_bytes is the payload size, covering
+// primality for n < 30*payload_bytes.
+static inline int is_prime_wheel30(uint64_t n, const uint8_t *bm, uint64_t payload_bytes) {
+    if (n < 7) {
+        return (n == 2 || n == 3 || n == 5);
+    }
+    const uint8_t r = gbWheel30Index[n % 30];
+    if (r == 0xFF) {
+        return 0;
+    }
+    const uint64_t b = n / 30;
+    return (b < payload_bytes) && ((bm[b] >> r) & 1);
+}
+
 // Count the number of Goldbach pairs for p+q=2n in the range [2,2n)
 // Assumes: *current points to first prime > n, or a lower prime value in sorted buffer of primes.
 // lowest: start of prime buffer
@@ -61,10 +87,214 @@ extern uint64_t countRangedPairs(const uint64_t n, const uint64_t n_min,const ui
 // hi: Pointer to the next hi prime to check
 extern uint64_t countRangedPairsIter(const uint64_t n, const uint64_t n_min,const uint64_t **current, const uint64_t *lowest, const uint64_t *highest,const uint64_t **lo,const uint64_t **hi);
 
-// Find the minimum m > 0 value for Q_m (n-m)(n+m) for Goldbach pairs p+q=2n 
+// Count the number of Goldbach pairs for p+q=2n in the range (n_min,2n-n_min) excluding 0,
+// directly on the odd-prime bitmap from primesieve_bitmap (bit i <=> 2i+3 is prime).
+// bitmap_bits: number of valid bits in the bitmap.
+// Same conventions as countRangedPairs; returns ~0ULL when the bitmap is too small.
+extern uint64_t countRangedPairsBitmap(const uint64_t n, const uint64_t n_min, const uint8_t *bitmap, const uint64_t bitmap_bits);
+
+// Find the minimum m > 0 value for Q_m (n-m)(n+m) for Goldbach pairs p+q=2n
 // primes: ascending array in [lowest, highest); *current is a moving cursor.
 extern int findPair( uint64_t n, uint64_t **current, uint64_t *lowest, uint64_t *highest);
 
+// Same minimum-m search directly on the odd-prime bitmap from primesieve_bitmap
+// (bit i <=> 2i+3 is prime), a word at a time; no raw prime store is needed.
+// Returns m, 0 when only the diagonal p=q=n pairs, or -1 when the bitmap ends
+// before the upper side of a candidate pair.
+extern int findPairBitmap(const uint64_t n, const uint8_t *bitmap, const uint64_t bitmap_bits);
+
+// ----- Binary gbpairs file (findgbpairs --binary) -----
+// An 8-byte magic followed by fixed-width native-endian records, one per n,
+// so downstream tools can mmap the file as an array instead of re-parsing
+// the CSV.  m is the minimum offset with n-m and n+m both prime (0 for the
+// diagonal pairs 2+2 and 3+3); the CSV columns are all derivable from it.
+#define GB_PAIRS_MAGIC "GBPAIRS0"
+#define GB_PAIRS_HDR_BYTES 8
+
+typedef struct {
+    uint64_t n;
+    uint64_t m;
+} GBPairRecord;
+
+// Nonzero when data starts with the binary gbpairs magic.
+extern int isGBPairsData(const uint8_t *data, size_t len);
+
+// ----- Delta-encoded compact prime store (primeGaps.c) -----
+// ~1 byte per prime versus 8 in the raw store; see primeGaps.c for the layout.
+
+typedef struct {
+    FILE *out;
+    uint64_t prev;
+    uint64_t count;
+} PrimeGapWriter;
+
+typedef struct {
+    const uint8_t *ptr;
+    const uint8_t *end;
+    uint64_t prev;
+    uint64_t total;
+    uint64_t remaining;
+} PrimeGapDecoder;
+
+// Writer: init writes the header, put appends one ascending prime,
+// finish patches the prime count.  All return 0 on success.
+extern int primeGapWriterInit(PrimeGapWriter *w, FILE *out);
+extern int primeGapWriterPut(PrimeGapWriter *w, uint64_t p);
+extern int primeGapWriterFinish(PrimeGapWriter *w);
+
+// Decoder: init validates the header over an in-memory (e.g. mmap'd) file;
+// nextBlock streams up to max primes per call, returning 0 at end of stream.
+extern int isPrimeGapData(const uint8_t *data, size_t len);
+extern int primeGapDecoderInit(PrimeGapDecoder *d, const uint8_t *data, size_t len);
+extern size_t primeGapDecoderNextBlock(PrimeGapDecoder *d, uint64_t *out, size_t max);
+
+// ----- Sampled pi(x) index (primeIndex.c) -----
+// Array offset of the first prime >= k*step for every k, built by the
+// primeindex tool; gives O(1) rank/select into the raw prime array.
+
+typedef struct {
+    const uint64_t *samples;
+    uint64_t step;
+    uint64_t prime_count;
+    uint64_t nsamples;
+} PrimeIndex;
+
+// Write the index for an ascending prime array; step is the sampling interval.
+extern int primeIndexWrite(FILE *out, const uint64_t *primes, uint64_t count, uint64_t step);
+
+// Reader over an in-memory (e.g. mmap'd) index file; init returns 0 on success.
+extern int isPrimeIndexData(const uint8_t *data, size_t len);
+extern int primeIndexInit(PrimeIndex *idx, const uint8_t *data, size_t len);
+
+// rank: number of primes <= x.  seekGT: first prime > x, or highest when
+// out of primes.  primes must be the array the index was built from.
+extern uint64_t primeIndexRank(const PrimeIndex *idx, const uint64_t *primes, uint64_t x);
+extern const uint64_t *primeIndexSeekGT(const PrimeIndex *idx, const uint64_t *primes, const uint64_t *highest, uint64_t x);
+
+// ----- Shared-memory prime stream (gbpipeline) -----
+// One header page followed by capacity uint64_t prime slots, held in a
+// memfd shared between the gbpipeline driver and its consumer.  The driver
+// appends primes as the sieve produces them and bumps published with a
+// release store; a consumer loads it with acquire and may read exactly the
+// first published slots.  done is set (after the final publish) when the
+// sieve has finished, so a consumer waiting for coverage that never comes
+// can fail instead of spinning.
+
+#define GB_PRIME_STREAM_MAGIC 0x53454d4952504247ULL  /* "GBPRIMES" */
+#define GB_PRIME_STREAM_HDR_BYTES 4096
+
+typedef struct {
+    uint64_t magic;
+    uint64_t capacity;            // uint64_t slots after the header page
+    volatile uint64_t published;  // prime slots visible to consumers
+    volatile uint64_t done;       // producer finished; published is final
+} GBPrimeStreamHdr;
+
+static inline uint64_t gbPrimeStreamPublished(const GBPrimeStreamHdr *hdr) {
+    return __atomic_load_n(&hdr->published, __ATOMIC_ACQUIRE);
+}
+
+static inline void gbPrimeStreamPublish(GBPrimeStreamHdr *hdr, uint64_t count) {
+    __atomic_store_n(&hdr->published, count, __ATOMIC_RELEASE);
+}
+
+static inline int gbPrimeStreamDone(const GBPrimeStreamHdr *hdr) {
+    return (int)__atomic_load_n(&hdr->done, __ATOMIC_ACQUIRE);
+}
+
+static inline void gbPrimeStreamFinish(GBPrimeStreamHdr *hdr) {
+    __atomic_store_n(&hdr->done, (uint64_t)1, __ATOMIC_RELEASE);
+}
+
+// ----- SHA-256 (gbSha256.c) -----
+// Streaming FIPS 180-4 digest, used by gbcache to fingerprint stage
+// inputs and parameters for the content-addressed store.
+
+typedef struct {
+    uint32_t h[8];
+    uint64_t len;
+    uint8_t buf[64];
+    size_t buflen;
+} GBSha256;
+
+extern void gbSha256Init(GBSha256 *s);
+extern void gbSha256Update(GBSha256 *s, const void *data, size_t len);
+extern void gbSha256Final(GBSha256 *s, uint8_t digest[32]);
+extern void gbSha256Hex(const uint8_t digest[32], char hex[65]);
+
+// ----- Binary columnar interval output (gbColumnar.c) -----
+// Compact alternative to the aggregate CSV streams: magic "GBCOL001", a
+// stored CSV header line and per-column printf formats, then one packed
+// section per column ('u' uint64, 'f' native long double, 's' strings).
+// Values buffer in memory and the sections are written on close, so rows
+// can be appended one interval at a time like the CSV writers do.
+
+#define GBCOL_MAX_COLS 32
+
+typedef union {
+    uint64_t u;
+    long double f;
+    const char *s;
+} GBColValue;
+
+typedef struct {
+    FILE *out;
+    char *header;
+    char types[GBCOL_MAX_COLS + 1];
+    char *formats[GBCOL_MAX_COLS];
+    uint32_t ncols;
+    uint64_t nrows;
+    uint64_t cap;
+    void *cols[GBCOL_MAX_COLS];     // uint64_t[] / long double[] / uint64_t[] offsets
+    char *sblob;                     // concatenated NUL-terminated strings
+    uint64_t sblob_len, sblob_cap;
+} GBColumnarWriter;
+
+// types is a string of 'u'/'f'/'s' column tags; formats holds one printf
+// format per column (matching the CSV the stream would have produced).
+extern int gbColumnarWriterInit(GBColumnarWriter *w, FILE *out, const char *headerLine, const char *types, const char *const *formats);
+extern int gbColumnarWriterAppend(GBColumnarWriter *w, const GBColValue *row);
+extern int gbColumnarWriterClose(GBColumnarWriter *w);
+
+typedef struct {
+    const char *header;
+    uint32_t header_len;
+    uint32_t ncols;
+    uint64_t nrows;
+    char types[GBCOL_MAX_COLS + 1];
+    const char *formats[GBCOL_MAX_COLS];
+    const uint8_t *coldata[GBCOL_MAX_COLS];
+} GBColumnarReader;
+
+// Reader over an in-memory (e.g. mmap'd) columnar file; init returns 0 on
+// success.  formatRow reconstructs the exact CSV line (with newline) the
+// equivalent text stream would have written; returns its length or -1.
+extern int isGBColumnarData(const uint8_t *data, size_t len);
+extern int gbColumnarReaderInit(GBColumnarReader *r, const uint8_t *data, size_t len);
+extern uint64_t gbColumnarU64(const GBColumnarReader *r, uint32_t col, uint64_t row);
+extern long double gbColumnarF(const GBColumnarReader *r, uint32_t col, uint64_t row);
+extern const char *gbColumnarStr(const GBColumnarReader *r, uint32_t col, uint64_t row);
+extern int gbColumnarFormatRow(const GBColumnarReader *r, uint64_t row, char *buf, size_t buflen);
+
+// ----- Buffered bulk CSV emission (gbOutBuf.c) -----
+// Drop-in row output: gbOutPrintf/gbOutWrite append to a large per-FILE
+// buffer that is flushed to stdio in one call per megabyte instead of one
+// locked fprintf per row.  Buffers are keyed by FILE* so every emitter of
+// a stream shares one FIFO; single writer thread only.  Call gbOutRelease
+// before fclose()ing a buffered FILE (or gbOutFlushAll at shutdown).
+extern void gbOutWrite(FILE *out, const char *data, size_t len);
+extern int gbOutPrintf(FILE *out, const char *fmt, ...);
+extern void gbOutFlushFILE(FILE *out);
+extern void gbOutFlushAll(void);
+extern void gbOutRelease(FILE *out);
+
+// Fast formatters for the hot row paths; both return the byte count
+// written (no NUL).  gbFmtU64 needs 20 bytes.  gbFmtFixedLd matches
+// printf "%.<prec>Lf" byte for byte, handing values too close to a
+// rounding boundary (or too large for the scaled fast path) to snprintf.
+extern int gbFmtU64(char *dst, uint64_t v);
+extern int gbFmtFixedLd(char *dst, size_t cap, long double x, int prec);
+
 #include "twoSGB.h"
 #include "calcBnormSymmetric.h"
 #include "chineseRemainderTheorem.h"
@@ -0,0 +1,157 @@
+// primeGaps - delta-encoded compact prime store
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Format: 8-byte magic "GBPGAPS1", uint64 prime count (little endian),
+// the first prime as a LEB128 varint, then one record per following prime.
+// A record is the half-gap (p - prev)/2 as a single byte, with 0 meaning
+// the odd 2->3 gap and 0xFF escaping to a LEB128 varint for rare wide gaps.
+// Prime gaps below 2^64 fit a byte after halving almost always, so the
+// stream is ~1 byte per prime versus 8 in the raw store.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "libprime.h"
+
+static const char PRIME_GAP_MAGIC[8] = "GBPGAPS1";
+
+static int put_varint(FILE *out, uint64_t v) {
+    do {
+        uint8_t b = (uint8_t)(v & 0x7f);
+        v >>= 7;
+        if (v) {
+            b |= 0x80;
+        }
+        if (fputc(b, out) == EOF) {
+            return -1;
+        }
+    } while (v);
+    return 0;
+}
+
+static int get_varint(const uint8_t **ptr, const uint8_t *end, uint64_t *v) {
+    uint64_t result = 0;
+    unsigned shift = 0;
+    while (*ptr < end) {
+        uint8_t b = *(*ptr)++;
+        result |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) {
+            *v = result;
+            return 0;
+        }
+        shift += 7;
+        if (shift >= 64) {
+            break;
+        }
+    }
+    return -1;
+}
+
+int primeGapWriterInit(PrimeGapWriter *w, FILE *out) {
+    memset(w, 0, sizeof(*w));
+    w->out = out;
+    if (fwrite(PRIME_GAP_MAGIC, 1, sizeof(PRIME_GAP_MAGIC), out) != sizeof(PRIME_GAP_MAGIC)) {
+        return -1;
+    }
+    // Count placeholder, patched by primeGapWriterFinish.
+    uint64_t count = 0;
+    if (fwrite(&count, sizeof(count), 1, out) != 1) {
+        return -1;
+    }
+    return 0;
+}
+
+int primeGapWriterPut(PrimeGapWriter *w, uint64_t p) {
+    if (w->count == 0) {
+        if (put_varint(w->out, p) != 0) {
+            return -1;
+        }
+    }
+    else {
+        if (p <= w->prev) {
+            return -1;
+        }
+        const uint64_t halfgap = (p - w->prev) >> 1; // 0 encodes the odd 2->3 gap
+        if (halfgap < 0xff) {
+            if (fputc((int)halfgap, w->out) == EOF) {
+                return -1;
+            }
+        }
+        else {
+            if (fputc(0xff, w->out) == EOF || put_varint(w->out, halfgap) != 0) {
+                return -1;
+            }
+        }
+    }
+    w->prev = p;
+    w->count++;
+    return 0;
+}
+
+int primeGapWriterFinish(PrimeGapWriter *w) {
+    if (fseek(w->out, (long)sizeof(PRIME_GAP_MAGIC), SEEK_SET) != 0) {
+        return -1;
+    }
+    if (fwrite(&w->count, sizeof(w->count), 1, w->out) != 1) {
+        return -1;
+    }
+    return fflush(w->out);
+}
+
+int isPrimeGapData(const uint8_t *data, size_t len) {
+    return len >= sizeof(PRIME_GAP_MAGIC) + sizeof(uint64_t)
+        && memcmp(data, PRIME_GAP_MAGIC, sizeof(PRIME_GAP_MAGIC)) == 0;
+}
+
+int primeGapDecoderInit(PrimeGapDecoder *d, const uint8_t *data, size_t len) {
+    memset(d, 0, sizeof(*d));
+    if (!isPrimeGapData(data, len)) {
+        return -1;
+    }
+    memcpy(&d->total, data + sizeof(PRIME_GAP_MAGIC), sizeof(d->total));
+    d->ptr = data + sizeof(PRIME_GAP_MAGIC) + sizeof(uint64_t);
+    d->end = data + len;
+    d->remaining = d->total;
+    return 0;
+}
+
+// Decode up to max primes into out; returns the number decoded, 0 at end
+// of stream.  The caller loops until 0 for streaming block consumption.
+size_t primeGapDecoderNextBlock(PrimeGapDecoder *d, uint64_t *out, size_t max) {
+    size_t produced = 0;
+    while (produced < max && d->remaining > 0) {
+        if (d->prev == 0) { // first prime is a varint
+            if (get_varint(&d->ptr, d->end, &d->prev) != 0) {
+                return produced;
+            }
+        }
+        else {
+            if (d->ptr >= d->end) {
+                return produced;
+            }
+            uint64_t halfgap = *d->ptr++;
+            if (halfgap == 0xff && get_varint(&d->ptr, d->end, &halfgap) != 0) {
+                return produced;
+            }
+            d->prev += halfgap ? (halfgap << 1) : 1;
+        }
+        out[produced++] = d->prev;
+        d->remaining--;
+    }
+    return produced;
+}
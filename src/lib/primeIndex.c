@@ -0,0 +1,110 @@
+// primeIndex - sampled pi(x) index for O(1) rank/select into a prime array
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Format: 8-byte magic "GBPIDX01", then uint64 step, prime count and
+// sample count (all little endian), followed by the samples.  Sample k
+// is the array offset of the first prime >= k*step, i.e. pi(k*step - 1).
+// With the default step of 2^16 a lookup binary-searches one bucket of
+// at most a few thousand primes, so rank and seek are effectively O(1)
+// regardless of where in the array the query lands.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "libprime.h"
+
+static const char PRIME_INDEX_MAGIC[8] = "GBPIDX01";
+
+int primeIndexWrite(FILE *out, const uint64_t *primes, uint64_t count, uint64_t step) {
+    if (step == 0 || count == 0) {
+        return -1;
+    }
+    const uint64_t nsamples = primes[count - 1] / step + 2;
+    if (fwrite(PRIME_INDEX_MAGIC, 1, sizeof(PRIME_INDEX_MAGIC), out) != sizeof(PRIME_INDEX_MAGIC)
+        || fwrite(&step, sizeof(step), 1, out) != 1
+        || fwrite(&count, sizeof(count), 1, out) != 1
+        || fwrite(&nsamples, sizeof(nsamples), 1, out) != 1) {
+        return -1;
+    }
+    uint64_t rank = 0;
+    for (uint64_t k = 0; k < nsamples; k++) {
+        const uint64_t threshold = k * step;
+        while (rank < count && primes[rank] < threshold) {
+            rank++;
+        }
+        if (fwrite(&rank, sizeof(rank), 1, out) != 1) {
+            return -1;
+        }
+    }
+    return fflush(out);
+}
+
+int isPrimeIndexData(const uint8_t *data, size_t len) {
+    return len >= sizeof(PRIME_INDEX_MAGIC) + 3 * sizeof(uint64_t)
+        && memcmp(data, PRIME_INDEX_MAGIC, sizeof(PRIME_INDEX_MAGIC)) == 0;
+}
+
+int primeIndexInit(PrimeIndex *idx, const uint8_t *data, size_t len) {
+    memset(idx, 0, sizeof(*idx));
+    if (!isPrimeIndexData(data, len)) {
+        return -1;
+    }
+    const uint8_t *p = data + sizeof(PRIME_INDEX_MAGIC);
+    memcpy(&idx->step, p, sizeof(uint64_t));
+    memcpy(&idx->prime_count, p + sizeof(uint64_t), sizeof(uint64_t));
+    memcpy(&idx->nsamples, p + 2 * sizeof(uint64_t), sizeof(uint64_t));
+    if (idx->step == 0
+        || len < sizeof(PRIME_INDEX_MAGIC) + (3 + idx->nsamples) * sizeof(uint64_t)) {
+        return -1;
+    }
+    idx->samples = (const uint64_t *)(p + 3 * sizeof(uint64_t));
+    return 0;
+}
+
+// Number of primes <= x in the indexed array.
+uint64_t primeIndexRank(const PrimeIndex *idx, const uint64_t *primes, uint64_t x) {
+    const uint64_t k = x / idx->step;
+    if (k + 1 >= idx->nsamples) {
+        return idx->prime_count;
+    }
+    // Binary search within the bucket [samples[k], samples[k+1]).
+    uint64_t lo = idx->samples[k];
+    uint64_t hi = idx->samples[k + 1];
+    while (lo < hi) {
+        const uint64_t mid = lo + ((hi - lo) >> 1);
+        if (primes[mid] <= x) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// First prime > x, or highest (past-the-end) when none exists.
+const uint64_t *primeIndexSeekGT(
+    const PrimeIndex *idx,
+    const uint64_t *primes,
+    const uint64_t *highest,
+    uint64_t x
+) {
+    const uint64_t rank = primeIndexRank(idx, primes, x);
+    const uint64_t *cur = primes + rank;
+    return cur < highest ? cur : highest;
+}
@@ -16,19 +16,46 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+// The merge streams a k-way heap over the sorted inputs instead of loading
+// every row: memory is O(number of files + number of alphas), so thousands
+// of shard summaries merge in a few MB of RSS.  Two streaming passes are
+// needed because the nstar/eta selection depends on the preMertens crossing
+// of the whole continuous group; pass 1 resolves the per-group crossings
+// with O(1) accumulators and pass 2 replays the rows against them.
+//
+// --store adds an incremental mode for the nightly re-merge: the shard rows
+// are kept in a sorted binary row store (raw native CPSRow records in the
+// heap's (n_start, alpha) order, with a sampled n_start index in a trailer).
+// New shards merge-join against the mapped store; because new data sorts
+// after history, the common case appends at the tail and only the trailer
+// and header are rewritten, so the update cost tracks the size of the new
+// shards rather than the size of history.  The merged CSV view is generated
+// on demand by replaying the two passes over the mapped rows, with no CSV
+// parsing of historical shards.  The store is derived data and can always
+// be rebuilt from the shard files.
+
 #include <cstdint>
 #include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <cerrno>
 #include <cmath>
 #include <string>
 #include <vector>
 #include <map>
+#include <queue>
 #include <algorithm>
 #include <stdexcept>
 #include <getopt.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gbCsv.hpp"
+
 struct CPSRow {
     std::uint64_t n_start;
     std::uint64_t n_end;
@@ -44,359 +71,686 @@ struct CPSRow {
     long double deltaMertensAsymp;
     std::uint64_t nzeroStatAsymp;
     long double etaStatAsymp;
-    
-    std::string source_file;
-    
-    CPSRow() = default;
-    
-    CPSRow( std::uint64_t ns, std::uint64_t ne, long double a, std::uint64_t pm,
-            std::uint64_t ns_val, long double dm, std::uint64_t n5p,
-            std::uint64_t nzs, long double es, std::uint64_t pma, std::uint64_t nsa,
-            long double dma, std::uint64_t nzsa, long double esa,
-            const std::string& src = "")
-        : n_start(ns), n_end(ne), alpha(a), preMertens(pm), nstar(ns_val),
-            deltaMertens(dm), n_5percent(n5p), nzeroStat(nzs), etaStat(es),
-            preMertensAsymp(pma), nstarAsymp(nsa), deltaMertensAsymp(dma), nzeroStatAsymp(nzsa),
-            etaStatAsymp(esa), source_file(src) {}
 };
 
-struct OverlapInfo {
-    std::uint64_t start_n, end_n;
-    long double alpha;
-    std::vector<std::string> conflicting_files;
-    std::vector<CPSRow> conflicting_rows;
-};
+// Store order is the heap's global order: (n_start, alpha).  New shards
+// carry higher n than history, so their rows sort after everything already
+// stored and the merge-join degenerates to an append.
+static int cpsKeyCmp(const CPSRow& a, const CPSRow& b) {
+    if (a.n_start != b.n_start) return a.n_start < b.n_start ? -1 : 1;
+    if (a.alpha != b.alpha) return a.alpha < b.alpha ? -1 : 1;
+    return 0;
+}
 
-struct GapInfo {
-    std::uint64_t start_n, end_n;
-    long double alpha;
+// Field-wise (never memcmp: CPSRow has long double padding bytes the
+// parser leaves indeterminate).
+static bool cpsRowEqual(const CPSRow& a, const CPSRow& b) {
+    return a.n_start == b.n_start && a.n_end == b.n_end && a.alpha == b.alpha &&
+        a.preMertens == b.preMertens && a.nstar == b.nstar &&
+        a.deltaMertens == b.deltaMertens && a.n_5percent == b.n_5percent &&
+        a.nzeroStat == b.nzeroStat && a.etaStat == b.etaStat &&
+        a.preMertensAsymp == b.preMertensAsymp && a.nstarAsymp == b.nstarAsymp &&
+        a.deltaMertensAsymp == b.deltaMertensAsymp &&
+        a.nzeroStatAsymp == b.nzeroStatAsymp && a.etaStatAsymp == b.etaStatAsymp;
+}
+
+// --store: sorted binary row store.  Raw native CPSRow records (same
+// architecture-locked contract as the engine checkpoints) behind a fixed
+// header, followed by a sampled n_start index as a trailer:
+//
+//   CPSStoreHeader | rows * CPSRow | ceil(rows/index_every) * uint64
+//
+// where index sample i is rows[i * index_every].n_start.  A pure append
+// updates in place: the new rows and trailer land past the live data and
+// the header's row count is written last, so an interrupted update leaves
+// the previous row count visible with at worst a stale trailer, which
+// load() detects and ignores.  Anything else (first write, backfill,
+// duplicate re-add) rewrites the whole store to a tmp file and renames it
+// into place, the same atomic idiom as the engine checkpoints.
+struct CPSStoreHeader {
+    char magic[8];
+    std::uint64_t rows;
+    std::uint64_t index_every;
+    std::uint64_t reserved;
 };
 
-class CPSMerger {
-private:
-    std::vector<CPSRow> all_rows;
-    std::map<long double, std::vector<CPSRow>> alpha_groups;
-    
+// The rows are read in place from the mapping, so the header must pad the
+// row array out to CPSRow's (long double) alignment.
+static_assert(sizeof(CPSStoreHeader) % alignof(CPSRow) == 0,
+    "CPSStoreHeader must preserve CPSRow alignment in the mapping");
+
+#define CPS_STORE_MAGIC "GBCPSST0"
+static constexpr std::uint64_t CPS_STORE_INDEX_EVERY = 1024;
+
+class CPSStore {
 public:
-    
-    void loadCPSFile(const std::string& filename) {
-        FILE* file = std::fopen(filename.c_str(), "r");
-        if (!file) {
-            throw std::runtime_error("Cannot open file: " + filename);
+    ~CPSStore() {
+        if (map_ && mapLen_) {
+            ::munmap(map_, mapLen_);
         }
-        
-        char line[1024];
-        int lineNum = 0;
-        
-        // Skip header line if it exists
-        if (std::fgets(line, sizeof(line), file)) {
-            lineNum++;
-            // Check if this looks like a header (contains "FIRST" or "Alpha")
-            if (strstr(line, "FIRST") || strstr(line, "Alpha")) {
-                // This is a header, continue to next line
-            } else {
-                // This is data, rewind to beginning
-                std::rewind(file);
-                lineNum = 0;
+    }
+
+    // Maps the store read-only; an absent file loads as an empty store.
+    void load(const std::string& path) {
+        filename = path;
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            if (errno == ENOENT) {
+                return; // first run: empty store
             }
+            throw std::runtime_error("Cannot open store: " + path);
         }
-        
-        while (std::fgets(line, sizeof(line), file)) {
-            lineNum++;
-            
-            // Skip empty lines
-            if (line[0] == '\n' || line[0] == '\r') {
-                continue;
+        exists_ = true;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat store: " + path);
+        }
+        if ((std::size_t)st.st_size < sizeof(CPSStoreHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Store too short (rebuild it from the shard files): " + path);
+        }
+        mapLen_ = (std::size_t)st.st_size;
+        void* addr = ::mmap(nullptr, mapLen_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            mapLen_ = 0;
+            throw std::runtime_error("Cannot map store: " + path);
+        }
+        map_ = addr;
+        const CPSStoreHeader* hdr = (const CPSStoreHeader*)map_;
+        if (std::memcmp(hdr->magic, CPS_STORE_MAGIC, sizeof(hdr->magic)) != 0) {
+            throw std::runtime_error("Not a cps store (rebuild it from the shard files): " + path);
+        }
+        if (sizeof(CPSStoreHeader) + hdr->rows * sizeof(CPSRow) > mapLen_) {
+            throw std::runtime_error("Store row count exceeds file size (rebuild it from the shard files): " + path);
+        }
+        count_ = (std::size_t)hdr->rows;
+        rows_ = (const CPSRow*)((const char*)map_ + sizeof(CPSStoreHeader));
+        indexEvery_ = hdr->index_every ? (std::size_t)hdr->index_every : (std::size_t)CPS_STORE_INDEX_EVERY;
+        // Trailer index: adopt it when present and consistent, otherwise
+        // fall back to the rows (stale after an interrupted update).
+        const std::size_t nidx = (count_ + indexEvery_ - 1) / indexEvery_;
+        const std::size_t trailerEnd = sizeof(CPSStoreHeader) + count_ * sizeof(CPSRow) + nidx * sizeof(std::uint64_t);
+        if (trailerEnd <= mapLen_) {
+            const std::uint64_t* samples = (const std::uint64_t*)((const char*)map_ + trailerEnd - nidx * sizeof(std::uint64_t));
+            bool ok = true;
+            for (std::size_t i = 0; i < nidx; i++) {
+                if (samples[i] != rows_[i * indexEvery_].n_start) {
+                    ok = false;
+                    break;
+                }
             }
-            
-            // Parse the line
-            std::uint64_t n_start, n_end, preMertens, nstar, n_5percent, nzeroStat, preMertensAsymp, nstarAsymp, nzeroStatAsymp;
-            long double alpha, deltaMertens, etaStat, deltaMertensAsymp, etaStatAsymp;
-            
-            int parsed = std::sscanf(line, "%" SCNu64 ",%" SCNu64 ",%Lf,%" SCNu64 ",%" SCNu64 ",%Lf,%" SCNu64 ",%" SCNu64 ",%Lf,%" SCNu64 ",%" SCNu64 ",%Lf,%" SCNu64 ",%Lf",
-                &n_start, &n_end, &alpha, &preMertens,
-                &nstar, &deltaMertens, &n_5percent, &nzeroStat, &etaStat,
-                &preMertensAsymp, &nstarAsymp, &deltaMertensAsymp, &nzeroStatAsymp, &etaStatAsymp
-            );
-            
-            if (parsed != 14) {
-                std::fprintf(stderr, "ERROR: Malformed line %d in %s - expected 14 fields, got %d\n", lineNum, filename.c_str(), parsed);
-                std::fclose(file);
-                throw std::runtime_error("Malformed input data detected");
+            if (ok) {
+                index_.assign(samples, samples + nidx);
+            }
+        }
+        if (index_.empty() && count_) {
+            std::fprintf(stderr, "WARNING: %s: stale or missing index trailer, indexing from rows\n", path.c_str());
+            index_.reserve(nidx);
+            for (std::size_t i = 0; i < nidx; i++) {
+                index_.push_back(rows_[i * indexEvery_].n_start);
             }
-            
-            all_rows.emplace_back(n_start, n_end, alpha, preMertens, nstar, deltaMertens,
-                                n_5percent, nzeroStat, etaStat, preMertensAsymp, nstarAsymp, deltaMertensAsymp,
-                                nzeroStatAsymp, etaStatAsymp, filename);
-        }
-        
-        std::fclose(file);
-        std::printf("Loaded %zu rows from %s\n", all_rows.size(), filename.c_str());
-    }
-    
-    void groupByAlpha() {
-        for (const auto& row : all_rows) {
-            alpha_groups[row.alpha].push_back(row);
-        }
-        
-        // Sort each alpha group by n_start
-        for (auto& [alpha, rows] : alpha_groups) {
-            std::sort(rows.begin(), rows.end(), 
-                [](const CPSRow& a, const CPSRow& b) {
-                        return a.n_start < b.n_start;
-                });
         }
     }
-    
-    std::vector<OverlapInfo> detectOverlaps() {
-        std::vector<OverlapInfo> overlaps;
-        
-        for (auto& [alpha, rows] : alpha_groups) {
-            for (size_t i = 0; i < rows.size(); i++) {
-                for (size_t j = i + 1; j < rows.size(); j++) {
-                    const auto& row1 = rows[i];
-                    const auto& row2 = rows[j];
-                    
-                    // Check for overlap
-                    if (row1.n_end > row2.n_start) {
-                        OverlapInfo overlap;
-                        overlap.alpha = alpha;
-                        overlap.start_n = std::max(row1.n_start, row2.n_start);
-                        overlap.end_n = std::min(row1.n_end, row2.n_end);
-                        overlap.conflicting_files = {row1.source_file, row2.source_file};
-                        overlap.conflicting_rows = {row1, row2};
-                        overlaps.push_back(overlap);
-                    }
+
+    const CPSRow* rows() const { return rows_; }
+    std::size_t count() const { return count_; }
+    bool exists() const { return exists_; }
+
+    // First stored row with key >= row, seated by the sampled index.
+    std::size_t lowerBound(const CPSRow& row) const {
+        std::size_t lo = 0, hi = count_;
+        if (!index_.empty()) {
+            std::size_t blk = (std::size_t)(std::upper_bound(index_.begin(), index_.end(), row.n_start) - index_.begin());
+            if (blk > 0) {
+                lo = (blk - 1) * indexEvery_;
+            }
+            if (blk * indexEvery_ < hi) {
+                hi = blk * indexEvery_ + indexEvery_;
+                if (hi > count_) {
+                    hi = count_;
                 }
             }
         }
-        
-        return overlaps;
+        const CPSRow* p = std::lower_bound(rows_ + lo, rows_ + hi, row,
+            [](const CPSRow& a, const CPSRow& b) { return cpsKeyCmp(a, b) < 0; });
+        return (std::size_t)(p - rows_);
     }
-    
-    std::vector<GapInfo> detectGaps() {
-        std::vector<GapInfo> gaps;
-        
-        for (auto& [alpha, rows] : alpha_groups) {
-            if (rows.empty()) continue;
-            
-            for (size_t i = 0; i < rows.size() - 1; i++) {
-                const auto& current = rows[i];
-                const auto& next = rows[i + 1];
-                
-                if (current.n_end < next.n_start) {
-                    GapInfo gap;
-                    gap.alpha = alpha;
-                    gap.start_n = current.n_end;
-                    gap.end_n = next.n_start;
-                    gaps.push_back(gap);
+
+    std::string filename;
+
+private:
+    void* map_ = nullptr;
+    std::size_t mapLen_ = 0;
+    const CPSRow* rows_ = nullptr;
+    std::size_t count_ = 0;
+    std::size_t indexEvery_ = (std::size_t)CPS_STORE_INDEX_EVERY;
+    std::vector<std::uint64_t> index_;
+    bool exists_ = false;
+};
+
+// Merge-joins sorted newRows into the store at path.  Rows already stored
+// are skipped; a stored row with the same (n_start, alpha) but different
+// content is a conflict, mirroring the overlap error of the CSV merge.
+// Only the tail from the join point is rewritten - the append-only common
+// case costs O(new rows) regardless of history size.
+static void storeUpdate(const std::string& path, const std::vector<CPSRow>& newRows) {
+    if (newRows.empty()) {
+        return;
+    }
+    CPSStore old;
+    old.load(path);
+    const CPSRow* orows = old.rows();
+    const std::size_t ocount = old.count();
+
+    const std::size_t split = old.lowerBound(newRows.front());
+    std::vector<CPSRow> tail;
+    tail.reserve((ocount - split) + newRows.size());
+    std::size_t i = split, j = 0, added = 0, dups = 0;
+    while (j < newRows.size()) {
+        // Duplicate keys inside the new batch itself (same shard given twice)
+        if (j + 1 < newRows.size() && cpsKeyCmp(newRows[j], newRows[j + 1]) == 0) {
+            if (!cpsRowEqual(newRows[j], newRows[j + 1])) {
+                std::fprintf(stderr, "ERROR: conflicting input rows for n_start=%" PRIu64 " alpha=%.12Lg\n",
+                    newRows[j].n_start, newRows[j].alpha);
+                throw std::runtime_error("Store conflict detected. Please resolve manually.");
+            }
+            j++;
+            dups++;
+            continue;
+        }
+        if (i < ocount) {
+            const int c = cpsKeyCmp(orows[i], newRows[j]);
+            if (c < 0) {
+                tail.push_back(orows[i++]);
+                continue;
+            }
+            if (c == 0) {
+                if (!cpsRowEqual(orows[i], newRows[j])) {
+                    std::fprintf(stderr, "ERROR: store %s already holds a different row for n_start=%" PRIu64 " alpha=%.12Lg\n",
+                        path.c_str(), newRows[j].n_start, newRows[j].alpha);
+                    throw std::runtime_error("Store conflict detected. Rebuild the store from the shard files.");
                 }
+                tail.push_back(orows[i++]);
+                j++;
+                dups++;
+                continue;
             }
         }
-        
-        return gaps;
+        tail.push_back(newRows[j++]);
+        added++;
     }
-    
-    
-    void mergeAlphaGroup(const std::vector<CPSRow>& rows, FILE* output) {
-        if (rows.empty()) return;
-        
-        // Group continuous intervals for merging
-        std::vector<std::vector<CPSRow>> continuous_groups;
-        std::vector<CPSRow> current_group;
-        
-        for (size_t i = 0; i < rows.size(); i++) {
-            const auto& row = rows[i];
-            
-            if (current_group.empty()) {
-                // First row
-                current_group.push_back(row);
-            } else {
-                const auto& prev_row = current_group.back();
-                
-                // Check if this row is continuous with the previous one
-                if (prev_row.n_end == row.n_start) {
-                    // Continuous - add to current group
-                    current_group.push_back(row);
-                } else {
-                    // Gap detected - finish current group and start new one
-                    continuous_groups.push_back(current_group);
-                    current_group.clear();
-                    current_group.push_back(row);
-                }
+    while (i < ocount) {
+        tail.push_back(orows[i++]);
+    }
+
+    const std::size_t total = split + tail.size();
+    CPSStoreHeader hdr;
+    std::memcpy(hdr.magic, CPS_STORE_MAGIC, sizeof(hdr.magic));
+    hdr.rows = (std::uint64_t)total;
+    hdr.index_every = CPS_STORE_INDEX_EVERY;
+    hdr.reserved = 0;
+    // Trailer: samples before the join point come from the map, the rest
+    // from the rewritten tail.
+    std::vector<std::uint64_t> samples;
+    const std::size_t nidx = (total + CPS_STORE_INDEX_EVERY - 1) / CPS_STORE_INDEX_EVERY;
+    samples.reserve(nidx);
+    for (std::size_t k = 0; k < nidx; k++) {
+        const std::size_t r = k * (std::size_t)CPS_STORE_INDEX_EVERY;
+        samples.push_back(r < split ? orows[r].n_start : tail[r - split].n_start);
+    }
+    int rc = 0;
+    if (old.exists() && split == ocount) {
+        // Pure append: the new rows and trailer only land past the live
+        // data, so writing them first and the header row count last keeps
+        // the previous store readable through a crash.
+        FILE* f = std::fopen(path.c_str(), "r+b");
+        if (!f) {
+            throw std::runtime_error("Cannot open store for update: " + path);
+        }
+        rc |= std::fseek(f, (long)(sizeof(CPSStoreHeader) + split * sizeof(CPSRow)), SEEK_SET);
+        if (!tail.empty()) {
+            rc |= std::fwrite(tail.data(), sizeof(CPSRow), tail.size(), f) == tail.size() ? 0 : -1;
+        }
+        if (!samples.empty()) {
+            rc |= std::fwrite(samples.data(), sizeof(std::uint64_t), samples.size(), f) == samples.size() ? 0 : -1;
+        }
+        rc |= std::fflush(f);
+        // Row count last: a crash before this point leaves the old header.
+        rc |= std::fseek(f, 0, SEEK_SET);
+        rc |= std::fwrite(&hdr, sizeof(hdr), 1, f) == 1 ? 0 : -1;
+        if (std::fclose(f) != 0) {
+            rc = -1;
+        }
+        if (rc != 0) {
+            throw std::runtime_error("Cannot write store: " + path);
+        }
+    }
+    else {
+        // First write, backfill or duplicate re-add: an in-place shifted
+        // tail would overwrite live rows before the header could disown
+        // them, so rewrite the whole store to a tmp file and rename it
+        // into place like the engine checkpoints do.
+        const std::string tmp_path = path + ".tmp";
+        FILE* f = std::fopen(tmp_path.c_str(), "wb");
+        if (!f) {
+            throw std::runtime_error("Cannot open store for update: " + tmp_path);
+        }
+        rc |= std::fwrite(&hdr, sizeof(hdr), 1, f) == 1 ? 0 : -1;
+        if (split) {
+            rc |= std::fwrite(orows, sizeof(CPSRow), split, f) == split ? 0 : -1;
+        }
+        if (!tail.empty()) {
+            rc |= std::fwrite(tail.data(), sizeof(CPSRow), tail.size(), f) == tail.size() ? 0 : -1;
+        }
+        if (!samples.empty()) {
+            rc |= std::fwrite(samples.data(), sizeof(std::uint64_t), samples.size(), f) == samples.size() ? 0 : -1;
+        }
+        rc |= std::fflush(f);
+        if (std::fclose(f) != 0) {
+            rc = -1;
+        }
+        if (rc == 0 && std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+            rc = -1;
+        }
+        if (rc != 0) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("Cannot write store: " + path);
+        }
+    }
+    std::printf("Store %s: %zu rows (%zu added, %zu duplicate)\n", path.c_str(), total, added, dups);
+}
+
+// Sequential reader over one cps summary file; rows within a file are
+// expected in ascending n_start order (gbpairsummary appends as n grows).
+class CPSFileReader {
+public:
+    std::string filename;
+    std::size_t rowCount = 0;
+
+    explicit CPSFileReader(const std::string& fn) : filename(fn) {}
+
+    void open() {
+        if (file_.open(filename.c_str()) != 0) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        rowCount = 0;
+        lastNStart_ = 0;
+
+        // Skip header line if it exists: peek the first line and check
+        // whether it looks like one (contains "FIRST" or "Alpha").
+        pending_ = false;
+        if (file_.lines.next()) {
+            std::string first(file_.lines.begin, file_.lines.end);
+            if (first.find("FIRST") == std::string::npos &&
+                first.find("Alpha") == std::string::npos) {
+                // This is data, hand it back from the first next() call
+                pending_ = true;
             }
         }
-        
-        // Don't forget the last group
-        if (!current_group.empty()) {
-            continuous_groups.push_back(current_group);
-        }
-        
-        // Merge each continuous group
-        for (const auto& group : continuous_groups) {
-            if (group.empty()) continue;
-            
-            const auto& first_row = group[0];
-            const auto& last_row = group.back();
-            
-            // Handle preMertens inheritance
-            std::uint64_t effective_preMertens = first_row.n_start - 1;
-            for (const auto& row : group) {
-                if (row.preMertens >= row.n_start || ! row.preMertens) {
-                    effective_preMertens = row.preMertens;
-                }
+    }
+
+    void close() {
+        file_.close();
+    }
+
+    bool next(CPSRow& row) {
+        while (pending_ || file_.lines.next()) {
+            pending_ = false;
+
+            // Skip empty lines
+            if (file_.lines.emptyLine()) {
+                continue;
             }
 
-            // Handle preMertensAsymp inheritance
-            std::uint64_t effective_preMertensAsymp = first_row.n_start - 1;
-            for (const auto& row : group) {
-                if (row.preMertensAsymp >= row.n_start || ! row.preMertensAsymp) {
-                    effective_preMertensAsymp = row.preMertensAsymp;
-                }
+            // Like the sscanf it replaces: extra trailing fields are
+            // ignored, and the error reports how many fields converted
+            // before the first bad one.
+            GBCsvField f[14];
+            std::size_t nf = gbCsvSplit(file_.lines.begin, file_.lines.end, f, 14);
+            if (nf > 14) {
+                nf = 14;
             }
+            int parsed = 0;
+            auto u = [&](std::uint64_t& v){ return (std::size_t)parsed < nf && gbCsvU64(f[parsed], v) && ++parsed; };
+            auto d = [&](long double& v){ return (std::size_t)parsed < nf && gbCsvLd(f[parsed], v) && ++parsed; };
+            bool ok = u(row.n_start) && u(row.n_end) && d(row.alpha) && u(row.preMertens) &&
+                u(row.nstar) && d(row.deltaMertens) && u(row.n_5percent) && u(row.nzeroStat) &&
+                d(row.etaStat) && u(row.preMertensAsymp) && u(row.nstarAsymp) &&
+                d(row.deltaMertensAsymp) && u(row.nzeroStatAsymp) && d(row.etaStatAsymp);
 
-            // Find n_5percent: first row with non-zero value
-            std::uint64_t merged_n_5percent = 0;
-            for (const auto& row : group) {
-                if (row.n_5percent > 0) {
-                    merged_n_5percent = row.n_5percent;
-                    break;
-                }
+            if (!ok) {
+                std::fprintf(stderr, "ERROR: Malformed line %zu in %s - expected 14 fields, got %d\n", file_.lines.lineNum, filename.c_str(), parsed);
+                throw std::runtime_error("Malformed input data detected");
+            }
+            if (row.n_start < lastNStart_) {
+                std::fprintf(stderr, "ERROR: %s is not sorted by n_start at line %zu\n", filename.c_str(), file_.lines.lineNum);
+                throw std::runtime_error("Unsorted input data detected");
+            }
+            lastNStart_ = row.n_start;
+            rowCount++;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    GBCsvFile file_;
+    bool pending_ = false;
+    std::uint64_t lastNStart_ = 0;
+};
+
+class CPSMerger {
+private:
+    // Per-group crossing state resolved in pass 1 and replayed in pass 2.
+    struct GroupScan {
+        std::uint64_t first_n_start = 0;
+        std::uint64_t last_n_end = 0;
+        std::uint64_t effective_preMertens = 0;
+        std::uint64_t effective_preMertensAsymp = 0;
+        std::uint64_t n_5percent = 0;
+    };
+
+    struct AlphaScan {
+        bool open = false;
+        GroupScan group;
+        std::string lastFile;          // for overlap reporting
+        std::vector<GroupScan> groups; // completed groups in n order
+    };
+
+    std::vector<CPSFileReader> readers_;
+    std::map<long double, AlphaScan> alphas_;
+    std::size_t overlapCount_ = 0;
+    std::size_t gapCount_ = 0;
+    std::size_t totalRows_ = 0;
+
+    // Drive the k-way heap: calls visit(row, file_index) for every row in
+    // global (n_start, alpha) order.
+    template<typename Visit>
+    void streamRows(Visit visit) {
+        struct HeapEntry {
+            CPSRow row;
+            std::size_t file;
+        };
+        auto later = [](const HeapEntry& a, const HeapEntry& b) {
+            if (a.row.n_start != b.row.n_start) return a.row.n_start > b.row.n_start;
+            if (a.row.alpha != b.row.alpha) return a.row.alpha > b.row.alpha;
+            return a.file > b.file;
+        };
+        std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(later)> heap(later);
+
+        for (std::size_t i = 0; i < readers_.size(); i++) {
+            readers_[i].open();
+            HeapEntry e;
+            e.file = i;
+            if (readers_[i].next(e.row)) {
+                heap.push(e);
+            }
+        }
+        while (!heap.empty()) {
+            HeapEntry e = heap.top();
+            heap.pop();
+            visit(e.row, e.file);
+            if (readers_[e.file].next(e.row)) {
+                heap.push(e);
             }
+        }
+        for (auto& r : readers_) {
+            r.close();
+        }
+    }
 
-            std::uint64_t merged_nstar = 0;
-            long double merged_deltaMertens = 0.0L;
-            std::uint64_t merged_nstarAsymp = 0;
-            long double merged_deltaMertensAsymp = 0.0L;
-            long double merged_etaStat = 0.0L;
-            std::uint64_t merged_nzeroStat = 0;
-            long double merged_etaStatAsymp = 0.0L;
-            std::uint64_t merged_nzeroStatAsymp = 0;
-            if(effective_preMertens >= first_row.n_start) {
-                // Find nstar: lowest value above effective_preMertens
-                for (const auto& row : group) {
-                    if (row.nstar > effective_preMertens && ! merged_nstar) {
-                        merged_nstar = row.nstar;
-                        merged_deltaMertens = row.deltaMertens;
-                        break;
-                    }
-                }
-                // Find nstarAsymp: lowest value above effective_preMertensAsymp
-                for (const auto& row : group) {
-                    if (row.nstarAsymp > effective_preMertensAsymp && ! merged_nstarAsymp) {
-                        merged_nstarAsymp = row.nstarAsymp;
-                        merged_deltaMertensAsymp = row.deltaMertensAsymp;
-                        break;
-                    }
+    // src names where the row came from (an input file, or the store when
+    // replaying --store rows) for the overlap report.
+    void scanRow(const CPSRow& row, const std::string& src) {
+        AlphaScan& a = alphas_[row.alpha];
+        if (a.open && row.n_start < a.group.last_n_end) {
+            std::fprintf(stderr, "ERROR: Alpha %.12Lg: n=%" PRIu64 "-%" PRIu64 " conflicts between files: %s\n",
+                row.alpha, row.n_start, std::min(a.group.last_n_end, row.n_end),
+                a.lastFile.c_str());
+            std::fprintf(stderr, "    and %s\n", src.c_str());
+            overlapCount_++;
+            return;
+        }
+        if (a.open && row.n_start > a.group.last_n_end) {
+            // Gap detected - finish current group and start a new one
+            std::fprintf(stderr, "WARNING: Alpha %.12Lg: gap at n=%" PRIu64 "-%" PRIu64 " - merge will produce multiple rows\n",
+                row.alpha, a.group.last_n_end, row.n_start);
+            gapCount_++;
+            a.groups.push_back(a.group);
+            a.open = false;
+        }
+        if (!a.open) {
+            a.group = GroupScan();
+            a.group.first_n_start = row.n_start;
+            a.group.effective_preMertens = row.n_start - 1;
+            a.group.effective_preMertensAsymp = row.n_start - 1;
+            a.open = true;
+        }
+        // Handle preMertens inheritance
+        if (row.preMertens >= row.n_start || ! row.preMertens) {
+            a.group.effective_preMertens = row.preMertens;
+        }
+        if (row.preMertensAsymp >= row.n_start || ! row.preMertensAsymp) {
+            a.group.effective_preMertensAsymp = row.preMertensAsymp;
+        }
+        // n_5percent: first row with non-zero value
+        if (!a.group.n_5percent && row.n_5percent > 0) {
+            a.group.n_5percent = row.n_5percent;
+        }
+        a.group.last_n_end = row.n_end;
+        a.lastFile = src;
+        totalRows_++;
+    }
+
+    // Pass-1 tail: close the still-open group of every alpha, then fail on
+    // overlaps (gaps only warn; the merge emits one row per group).
+    void finishScan() {
+        for (auto& [alpha, a] : alphas_) {
+            if (a.open) {
+                a.groups.push_back(a.group);
+                a.open = false;
+            }
+        }
+        if (overlapCount_) {
+            std::fprintf(stderr, "ERROR: Found %zu overlapping ranges\n", overlapCount_);
+            throw std::runtime_error("Overlapping ranges detected. Please resolve manually.");
+        }
+        if (gapCount_) {
+            std::fprintf(stderr, "WARNING: Found %zu gaps - merge will produce multiple rows\n", gapCount_);
+        }
+    }
+
+    // Pass-2 accumulator for the fields that depend on the group crossings.
+    struct GroupMerge {
+        std::size_t index = 0;          // which GroupScan this replays
+        std::uint64_t nstar = 0;
+        long double deltaMertens = 0.0L;
+        std::uint64_t nstarAsymp = 0;
+        long double deltaMertensAsymp = 0.0L;
+        long double etaStat = INFINITY;
+        std::uint64_t nzeroStat = 0;
+        long double etaStatAsymp = INFINITY;
+        std::uint64_t nzeroStatAsymp = 0;
+    };
+
+    struct MergedRow {
+        long double alpha;
+        GroupScan scan;
+        GroupMerge merge;
+    };
+
+    std::map<long double, GroupMerge> merges_;
+    std::vector<MergedRow> output_;
+
+    void finishGroup(long double alpha, GroupMerge& m) {
+        MergedRow out;
+        out.alpha = alpha;
+        out.scan = alphas_[alpha].groups[m.index];
+        out.merge = m;
+        output_.push_back(out);
+        std::size_t index = m.index + 1;
+        m = GroupMerge();
+        m.index = index;
+    }
+
+    void mergeRow(const CPSRow& row, std::size_t) {
+        GroupMerge& m = merges_[row.alpha];
+        const GroupScan& g = alphas_[row.alpha].groups[m.index];
+        if (row.n_start > g.last_n_end || row.n_start < g.first_n_start) {
+            finishGroup(row.alpha, m);
+        }
+        const GroupScan& scan = alphas_[row.alpha].groups[m.index];
+        if (scan.effective_preMertens >= scan.first_n_start) {
+            // nstar: lowest value above the group's preMertens crossing
+            if (!m.nstar && row.nstar > scan.effective_preMertens) {
+                m.nstar = row.nstar;
+                m.deltaMertens = row.deltaMertens;
+            }
+            if (!m.nstarAsymp && row.nstarAsymp > scan.effective_preMertensAsymp) {
+                m.nstarAsymp = row.nstarAsymp;
+                m.deltaMertensAsymp = row.deltaMertensAsymp;
+            }
+            if (scan.n_5percent >= scan.first_n_start) {
+                // etaStat: algebraically smallest value past n_5percent and preMertens
+                if (row.nzeroStat > scan.n_5percent && row.nzeroStat > scan.effective_preMertens && row.etaStat < m.etaStat) {
+                    m.etaStat = row.etaStat;
+                    m.nzeroStat = row.nzeroStat;
                 }
-            
-                if(merged_n_5percent >= first_row.n_start) {
-                    // Initialize to INFINITY so first valid value will be smaller
-                    merged_etaStat = INFINITY;
-                    merged_etaStatAsymp = INFINITY;
-                    
-                    for (const auto& row : group) {
-                        // Find etaStat: algebraically smallest value where nzeroStat > n_5percent and > preMertens
-                        if (row.nzeroStat > merged_n_5percent && row.nzeroStat > effective_preMertens && row.etaStat < merged_etaStat)  {
-                            merged_etaStat = row.etaStat;
-                            merged_nzeroStat = row.nzeroStat;
-                        }
-                        // Find etaStatAsymp: algebraically smallest value where nzeroStatAsymp > n_5percent and > preMertensAsymp
-                        if (row.nzeroStatAsymp > merged_n_5percent && row.nzeroStatAsymp > effective_preMertensAsymp && row.etaStatAsymp < merged_etaStatAsymp) {
-                            merged_etaStatAsymp = row.etaStatAsymp;
-                            merged_nzeroStatAsymp = row.nzeroStatAsymp;
-                        }
-                    }
-                    
-                    // Reset to 0 if no valid value was found
-                    if (merged_etaStat == INFINITY) {
-                        merged_etaStat = 0.0L;
-                        merged_nzeroStat = 0;
-                    }
-                    if (merged_etaStatAsymp == INFINITY) {
-                        merged_etaStatAsymp = 0.0L;
-                        merged_nzeroStatAsymp = 0;
-                    }
+                if (row.nzeroStatAsymp > scan.n_5percent && row.nzeroStatAsymp > scan.effective_preMertensAsymp && row.etaStatAsymp < m.etaStatAsymp) {
+                    m.etaStatAsymp = row.etaStatAsymp;
+                    m.nzeroStatAsymp = row.nzeroStatAsymp;
                 }
             }
-            
-            // Write merged row
-            std::fprintf(output, "%" PRIu64 ",%" PRIu64 ",%.12Lg,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%.6Lf\n",
-                first_row.n_start, last_row.n_end, first_row.alpha, effective_preMertens,
-                merged_nstar, merged_deltaMertens, merged_n_5percent, merged_nzeroStat, merged_etaStat,
-                effective_preMertensAsymp, merged_nstarAsymp, merged_deltaMertensAsymp, merged_nzeroStatAsymp, merged_etaStatAsymp);
         }
     }
-    
+
+public:
+
+    void addCPSFile(const std::string& filename) {
+        readers_.emplace_back(filename);
+    }
+
     void merge(const std::string& outputFile) {
-        groupByAlpha();
-        
-        // Detect overlaps and gaps
-        auto overlaps = detectOverlaps();
-        auto gaps = detectGaps();
-        
-        // Report overlaps (throw error)
-        if (!overlaps.empty()) {
-            std::fprintf(stderr, "ERROR: Found %zu overlapping ranges:\n", overlaps.size());
-            for (const auto& overlap : overlaps) {
-                std::fprintf(stderr, "  Alpha %.12Lg: n=%" PRIu64 "-%" PRIu64 " conflicts between files: %s\n",
-                    overlap.alpha, overlap.start_n, overlap.end_n,
-                    overlap.conflicting_files[0].c_str());
-                for (size_t i = 1; i < overlap.conflicting_files.size(); i++) {
-                    std::fprintf(stderr, "    and %s\n", overlap.conflicting_files[i].c_str());
-                }
-            }
-            throw std::runtime_error("Overlapping ranges detected. Please resolve manually.");
+        // Pass 1: resolve groups, crossings, overlaps and gaps.
+        streamRows([this](const CPSRow& row, std::size_t file) { scanRow(row, readers_[file].filename); });
+        for (auto& r : readers_) {
+            std::printf("Loaded %zu rows from %s\n", r.rowCount, r.filename.c_str());
+        }
+        finishScan();
+
+        // Pass 2: replay the rows against the resolved crossings.
+        streamRows([this](const CPSRow& row, std::size_t file) { mergeRow(row, file); });
+        for (auto& [alpha, m] : merges_) {
+            finishGroup(alpha, m);
         }
-        
-        // Report gaps as warnings (merge will proceed with multiple rows)
-        if (!gaps.empty()) {
-            std::fprintf(stderr, "WARNING: Found %zu gaps - merge will produce multiple rows:\n", gaps.size());
-            for (const auto& gap : gaps) {
-                std::fprintf(stderr, "  Alpha %.12Lg: gap at n=%" PRIu64 "-%" PRIu64 "\n",
-                    gap.alpha, gap.start_n, gap.end_n);
+
+        writeOutput(outputFile);
+        std::printf("Merged %zu rows into %s\n", totalRows_, outputFile.c_str());
+    }
+
+    // --store: drain the input heap into a sorted row vector for storeUpdate.
+    // Same heap, same order, no group state touched.
+    void collectRows(std::vector<CPSRow>& rows) {
+        streamRows([&rows](const CPSRow& row, std::size_t) { rows.push_back(row); });
+        for (auto& r : readers_) {
+            std::printf("Loaded %zu rows from %s\n", r.rowCount, r.filename.c_str());
+        }
+    }
+
+    // --store with --output: the two passes of merge() replayed over the
+    // mapped store rows, which are already in the heap's global order, so
+    // the CSV view is identical to merging the original shard files.
+    void mergeFromStore(const CPSStore& store, const std::string& outputFile) {
+        const CPSRow* rows = store.rows();
+        const std::size_t count = store.count();
+        for (std::size_t i = 0; i < count; i++) {
+            if (i && cpsKeyCmp(rows[i - 1], rows[i]) > 0) {
+                std::fprintf(stderr, "ERROR: %s is not sorted at row %zu\n", store.filename.c_str(), i + 1);
+                throw std::runtime_error("Corrupt store (rebuild it from the shard files): " + store.filename);
             }
+            scanRow(rows[i], store.filename);
         }
-        
-        // Merge and write output
+        finishScan();
+        for (std::size_t i = 0; i < count; i++) {
+            mergeRow(rows[i], 0);
+        }
+        for (auto& [alpha, m] : merges_) {
+            finishGroup(alpha, m);
+        }
+        writeOutput(outputFile);
+        std::printf("Merged %zu rows from %s into %s\n", totalRows_, store.filename.c_str(), outputFile.c_str());
+    }
+
+private:
+
+    void writeOutput(const std::string& outputFile) {
+        // Emit by (alpha, n_start), matching the order of the in-memory merge.
+        std::sort(output_.begin(), output_.end(),
+            [](const MergedRow& a, const MergedRow& b) {
+                if (a.alpha != b.alpha) return a.alpha < b.alpha;
+                return a.scan.first_n_start < b.scan.first_n_start;
+            });
+
         FILE* output = std::fopen(outputFile.c_str(), "w");
         if (!output) {
             throw std::runtime_error("Cannot open output file: " + outputFile);
         }
-        
+
         // Write header
         std::fprintf(output, "FIRST,LAST,Alpha,PreMertens,Mertens,DeltaMertens,n_5precent,NzeroStat,EtaStat,PreMertensAsymp,MertensAsymp,DeltaMertensAsymp,NzeroStatAsymp,EtaStatAsymp\n");
-        
-        // Merge each alpha group
-        for (auto& [alpha, rows] : alpha_groups) {
-            mergeAlphaGroup(rows, output);
+
+        for (const auto& out : output_) {
+            long double etaStat = out.merge.etaStat;
+            std::uint64_t nzeroStat = out.merge.nzeroStat;
+            long double etaStatAsymp = out.merge.etaStatAsymp;
+            std::uint64_t nzeroStatAsymp = out.merge.nzeroStatAsymp;
+            // Reset to 0 if no valid value was found
+            if (etaStat == INFINITY) {
+                etaStat = 0.0L;
+                nzeroStat = 0;
+            }
+            if (etaStatAsymp == INFINITY) {
+                etaStatAsymp = 0.0L;
+                nzeroStatAsymp = 0;
+            }
+            std::fprintf(output, "%" PRIu64 ",%" PRIu64 ",%.12Lg,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%" PRIu64 ",%.6Lf,%" PRIu64 ",%.6Lf\n",
+                out.scan.first_n_start, out.scan.last_n_end, out.alpha, out.scan.effective_preMertens,
+                out.merge.nstar, out.merge.deltaMertens, out.scan.n_5percent, nzeroStat, etaStat,
+                out.scan.effective_preMertensAsymp, out.merge.nstarAsymp, out.merge.deltaMertensAsymp, nzeroStatAsymp, etaStatAsymp);
         }
-        
+
         std::fclose(output);
-        std::printf("Merged %zu rows into %s\n", all_rows.size(), outputFile.c_str());
     }
 };
 
 void printUsage(const char* program) {
     std::fprintf(stderr, "Usage: %s [OPTIONS] --input FILE1 [FILE2 ...] --output FILE\n", program);
+    std::fprintf(stderr, "       %s --store FILE [--input FILE ...] [--output FILE]\n", program);
     std::fprintf(stderr, "  --input FILE     Input CPS summary file (can be specified multiple times)\n");
     std::fprintf(stderr, "  --output FILE    Output merged CPS summary file\n");
+    std::fprintf(stderr, "  --store FILE     Incremental binary row store: --input files are merged\n");
+    std::fprintf(stderr, "                   into the store, --output writes the merged CSV view of\n");
+    std::fprintf(stderr, "                   the whole store\n");
     std::fprintf(stderr, "  --help           Show this help message\n");
 }
 
 int main(int argc, char* argv[]) {
     std::vector<std::string> inputFiles;
     std::string outputFile;
-    
+    std::string storeFile;
+
     static struct option long_opts[] = {
         {"input",   required_argument, 0, 'i'},
         {"output",  required_argument, 0, 'o'},
+        {"store",   required_argument, 0, 's'},
         {"help",    no_argument,       0, 'h'},
         {0, 0, 0, 0}
     };
-    
+
     int opt, opt_index;
-    while ((opt = getopt_long(argc, argv, "i:o:h", long_opts, &opt_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "i:o:s:h", long_opts, &opt_index)) != -1) {
         switch (opt) {
             case 'i':
                 inputFiles.push_back(optarg);
@@ -404,6 +758,9 @@ int main(int argc, char* argv[]) {
             case 'o':
                 outputFile = optarg;
                 break;
+            case 's':
+                storeFile = optarg;
+                break;
             case 'h':
                 printUsage(argv[0]);
                 return 0;
@@ -412,24 +769,45 @@ int main(int argc, char* argv[]) {
                 return 1;
         }
     }
-    
-    if (inputFiles.empty() || outputFile.empty()) {
-        std::fprintf(stderr, "Error: Both --input and --output are required\n");
+
+    if (storeFile.empty() ? (inputFiles.empty() || outputFile.empty())
+                          : (inputFiles.empty() && outputFile.empty())) {
+        std::fprintf(stderr, storeFile.empty()
+            ? "Error: Both --input and --output are required\n"
+            : "Error: --store needs --input files to add and/or an --output view\n");
         printUsage(argv[0]);
         return 1;
     }
-    
+
     try {
+        if (!storeFile.empty()) {
+            if (!inputFiles.empty()) {
+                CPSMerger collector;
+                for (const auto& file : inputFiles) {
+                    collector.addCPSFile(file);
+                }
+                std::vector<CPSRow> rows;
+                collector.collectRows(rows);
+                storeUpdate(storeFile, rows);
+            }
+            if (!outputFile.empty()) {
+                CPSStore store;
+                store.load(storeFile);
+                CPSMerger merger;
+                merger.mergeFromStore(store, outputFile);
+            }
+            return 0;
+        }
+
         CPSMerger merger;
-        
-        // Load all input files
+
         for (const auto& file : inputFiles) {
-            merger.loadCPSFile(file);
+            merger.addCPSFile(file);
         }
-        
+
         // Merge and write output
         merger.merge(outputFile);
-        
+
         return 0;
     } catch (const std::exception& e) {
         std::fprintf(stderr, "Error: %s\n", e.what());
@@ -0,0 +1,98 @@
+// primeIndex - builds a sampled pi(x) index for a raw primes uint64_t file
+// Copyright (C) 2025 Bill C. Riemers
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "libprime.h"
+
+#define DEFAULT_STEP (1ULL<<16)
+
+int main(int argc, char* argv[]) {
+    uint64_t step = DEFAULT_STEP;
+    if (argc == 4) {
+        step = strtoull(argv[3],NULL,10);
+    }
+    if ((argc != 3 && argc != 4) || step == 0) {
+        fprintf(stderr,"Usage: %s <prime_raw_file> <index_file> [step]\n",argv[0]);
+        fprintf(stderr,"  step: sampling interval in integers (default %llu)\n",
+                (unsigned long long)DEFAULT_STEP);
+        exit(1);
+    }
+
+    const char *prime_raw_file = argv[1];
+    const char *index_file = argv[2];
+
+    // Open and mmap prime file
+    int fd = open(prime_raw_file, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        exit(1);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror("fstat");
+        close(fd);
+        exit(1);
+    }
+    const uint64_t count = ((uint64_t)st.st_size)/sizeof(uint64_t);
+    if (!count) {
+        fprintf(stderr,"Error: %s contains no primes\n",prime_raw_file);
+        close(fd);
+        exit(1);
+    }
+
+    uint64_t* primes = (uint64_t*)(
+        mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
+    );
+    if (primes == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        exit(1);
+    }
+
+    FILE* out = fopen(index_file,"w");
+    if (!out) {
+        perror("fopen");
+        munmap(primes, st.st_size);
+        close(fd);
+        exit(1);
+    }
+
+    if (primeIndexWrite(out, primes, count, step) != 0) {
+        perror("primeIndexWrite");
+        fclose(out);
+        munmap(primes, st.st_size);
+        close(fd);
+        exit(1);
+    }
+    printf("Indexed %" PRIu64 " primes up to %" PRIu64 " (step %" PRIu64 ")\n",
+           count, primes[count-1], step);
+
+    fclose(out);
+    munmap(primes, st.st_size);
+    close(fd);
+    exit(0);
+}
@@ -1,11 +1,11 @@
 // primesieve_bitmap - creates a bitmap of odd primes
 // Copyright (C) 2025 Bill C. Riemers
-// 
+//
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
 // the Free Software Foundation, either version 3 of the License, or
 // (at your option) any later version.
-// 
+//
 // This program is distributed in the hope that it will be useful,
 // but WITHOUT ANY WARRANTY; without even the implied warranty of
 // MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
@@ -21,6 +21,8 @@
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
+#include "libprime.h"
 
 #define SEGMENT_SIZE 32768  // ~32 KB
 
@@ -29,9 +31,246 @@ void write_bitmap(uint8_t *flags, size_t count_bits, FILE *out) {
     fwrite(flags, 1, count_bytes, out);
 }
 
+// --- wheel-30 output (--wheel30) -----------------------------------------
+// One byte per 30 integers, bit j <-> 30b + gbWheel30Residues[j].  Wheel
+// bytes straddle segment boundaries, so the writer carries the partial
+// byte between segments and only emits bytes whose full 30-number range
+// has been sieved (the finish call truncates at the last covered odd).
+typedef struct {
+    FILE *out;
+    uint64_t next_byte;   // payload index of the byte being collected
+    uint8_t cur;
+} Wheel30Writer;
+
+static void wheel30_feed(Wheel30Writer *w, uint64_t low,
+                         const uint8_t *flags, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!(flags[i >> 3] & (1 << (i & 7)))) {
+            continue;
+        }
+        const uint64_t v = low + 2 * (uint64_t)i;
+        const uint8_t r = gbWheel30Index[v % 30];
+        if (r == 0xFF) {
+            continue;   // 3 and 5 have no wheel bit; readers special-case them
+        }
+        const uint64_t b = v / 30;
+        while (w->next_byte < b) {
+            fputc(w->cur, w->out);
+            w->cur = 0;
+            w->next_byte++;
+        }
+        w->cur |= (uint8_t)(1 << r);
+    }
+}
+
+static void wheel30_finish(Wheel30Writer *w, uint64_t covered_max) {
+    const uint64_t full = (covered_max + 1) / 30;
+    while (w->next_byte < full) {
+        fputc(w->cur, w->out);
+        w->cur = 0;
+        w->next_byte++;
+    }
+}
+
+// Sieve one segment of SEGMENT_SIZE odd candidates starting at odd value low.
+// flags is (SEGMENT_SIZE+7)/8 bytes; on return 1 = prime (already inverted).
+static void sieve_segment(uint64_t low, const uint8_t *base_primes,
+                          uint8_t *flags) {
+    uint64_t high = low + 2 * SEGMENT_SIZE - 1;
+    uint64_t segment_len = (high - low) / 2 + 1;
+
+    memset(flags, 0, (segment_len + 7)/8);
+
+    for (uint64_t i = 0; (2*i+3)*(2*i+3) <= high; ++i) {
+        if (!(base_primes[i >> 3] & (1 << (i & 7)))) {
+            uint64_t p = (i<<1) + 3;
+            if(p&0xffffffff00000000ULL) {
+                break;
+            }
+            uint64_t j = p * p;
+
+            if (j < low) {
+                j = ((low + p - 1) / p) * p;
+                if ((j & 1) == 0) j += p;
+            }
+
+            for (uint64_t jstep=(p<<1); j <= high; j += jstep) {
+                uint64_t idx = (j - low) >> 1;
+                flags[idx >> 3] |= (1 << (idx & 7));
+            }
+        }
+    }
+
+    // Invert: 1 = prime
+    for (size_t i = 0; i < (segment_len + 7)/8; ++i) {
+        flags[i] = ~flags[i];
+    }
+}
+
+// --- parallel mode -------------------------------------------------------
+// Workers claim segment indices from a shared counter, sieve into a ring of
+// per-segment buffers, and the main thread drains the ring in order so the
+// byte stream on stdout is identical to the sequential mode.
+
+typedef struct {
+    const uint8_t *base_primes;
+    uint8_t **slots;          // ring of segment buffers
+    int *slot_ready;          // 1 when slots[s % ring_size] holds segment s
+    size_t ring_size;
+    uint64_t total_segments;
+    uint64_t next_segment;    // next index a worker may claim
+    uint64_t next_written;    // next index the writer will emit
+    pthread_mutex_t lock;
+    pthread_cond_t slot_free;
+    pthread_cond_t slot_filled;
+} SieveQueue;
+
+static void *sieve_worker(void *arg) {
+    SieveQueue *q = (SieveQueue *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&q->lock);
+        uint64_t seg = q->next_segment;
+        if (seg >= q->total_segments) {
+            pthread_mutex_unlock(&q->lock);
+            break;
+        }
+        q->next_segment = seg + 1;
+        // Wait until the slot for this segment has been drained by the writer.
+        while (seg >= q->next_written + q->ring_size) {
+            pthread_cond_wait(&q->slot_free, &q->lock);
+        }
+        pthread_mutex_unlock(&q->lock);
+
+        uint64_t low = 3 + seg * (2 * (uint64_t)SEGMENT_SIZE);
+        sieve_segment(low, q->base_primes, q->slots[seg % q->ring_size]);
+
+        pthread_mutex_lock(&q->lock);
+        q->slot_ready[seg % q->ring_size] = 1;
+        pthread_cond_broadcast(&q->slot_filled);
+        pthread_mutex_unlock(&q->lock);
+    }
+    return NULL;
+}
+
+static int sieve_parallel(uint64_t limit, uint64_t first_segment,
+                          const uint8_t *base_primes,
+                          int num_threads, int wheel30, FILE *out) {
+    SieveQueue q;
+    memset(&q, 0, sizeof(q));
+    q.base_primes = base_primes;
+    q.total_segments = (limit - 3) / (2 * (uint64_t)SEGMENT_SIZE) + 1;
+    q.next_segment = first_segment;
+    q.next_written = first_segment;
+    q.ring_size = (size_t)num_threads * 2;
+    if (q.ring_size > q.total_segments - first_segment) {
+        q.ring_size = q.total_segments - first_segment;
+    }
+
+    q.slots = calloc(q.ring_size, sizeof(uint8_t *));
+    q.slot_ready = calloc(q.ring_size, sizeof(int));
+    if (!q.slots || !q.slot_ready) {
+        fprintf(stderr, "Failed to allocate segment ring\n");
+        return 1;
+    }
+    for (size_t s = 0; s < q.ring_size; ++s) {
+        q.slots[s] = calloc((SEGMENT_SIZE + 7) / 8, sizeof(uint8_t));
+        if (!q.slots[s]) {
+            fprintf(stderr, "Failed to allocate segment buffer\n");
+            return 1;
+        }
+    }
+    pthread_mutex_init(&q.lock, NULL);
+    pthread_cond_init(&q.slot_free, NULL);
+    pthread_cond_init(&q.slot_filled, NULL);
+
+    pthread_t *threads = calloc(num_threads, sizeof(pthread_t));
+    if (!threads) {
+        fprintf(stderr, "Failed to allocate threads\n");
+        return 1;
+    }
+    for (int t = 0; t < num_threads; ++t) {
+        if (pthread_create(&threads[t], NULL, sieve_worker, &q)) {
+            fprintf(stderr, "Failed to create worker thread\n");
+            return 1;
+        }
+    }
+
+    // Ordered writer: emit segments strictly in sequence.
+    Wheel30Writer ww = {out, 0, 0};
+    while (q.next_written < q.total_segments) {
+        uint64_t seg = q.next_written;
+        size_t slot = seg % q.ring_size;
+
+        pthread_mutex_lock(&q.lock);
+        while (!q.slot_ready[slot]) {
+            pthread_cond_wait(&q.slot_filled, &q.lock);
+        }
+        pthread_mutex_unlock(&q.lock);
+
+        if (wheel30) {
+            wheel30_feed(&ww, 3 + seg * (2 * (uint64_t)SEGMENT_SIZE),
+                         q.slots[slot], SEGMENT_SIZE);
+        }
+        else {
+            write_bitmap(q.slots[slot], SEGMENT_SIZE, out);
+        }
+
+        pthread_mutex_lock(&q.lock);
+        q.slot_ready[slot] = 0;
+        q.next_written = seg + 1;
+        pthread_cond_broadcast(&q.slot_free);
+        pthread_mutex_unlock(&q.lock);
+    }
+
+    if (wheel30) {
+        const uint64_t last_low = 3 + (q.total_segments - 1) * (2 * (uint64_t)SEGMENT_SIZE);
+        wheel30_finish(&ww, last_low + 2 * ((uint64_t)SEGMENT_SIZE - 1));
+    }
+
+    for (int t = 0; t < num_threads; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    for (size_t s = 0; s < q.ring_size; ++s) {
+        free(q.slots[s]);
+    }
+    free(q.slots);
+    free(q.slot_ready);
+    pthread_mutex_destroy(&q.lock);
+    pthread_cond_destroy(&q.slot_free);
+    pthread_cond_destroy(&q.slot_filled);
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s <limit>\n", argv[0]);
+    const char *extend_file = NULL;
+    int wheel30 = 0;
+    while (argc >= 2 && !strncmp(argv[1], "--", 2)) {
+        if (argc >= 3 && !strcmp(argv[1], "--extend")) {
+            extend_file = argv[2];
+            argv += 2;
+            argc -= 2;
+        }
+        else if (!strcmp(argv[1], "--wheel30")) {
+            wheel30 = 1;
+            argv += 1;
+            argc -= 1;
+        }
+        else {
+            break;
+        }
+    }
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s [--wheel30] [--extend <bitmap_file>] <limit> [threads]\n", argv[0]);
+        fprintf(stderr, "  --wheel30: emit the wheel-30 format (one byte per 30 integers,\n"
+                        "             ~47%% smaller; 8-byte GBWHEEL0 header)\n"
+                        "  --extend: append segments for (old_limit, limit] to an existing\n"
+                        "            bitmap file instead of resieving from 3 to stdout\n");
+        return 1;
+    }
+    if (wheel30 && extend_file) {
+        fprintf(stderr, "Error: --wheel30 cannot be combined with --extend\n");
         return 1;
     }
 
@@ -40,6 +279,25 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "Limit must be >= 2\n");
         return 1;
     }
+    if (wheel30) {
+        // The writer truncates the final partial wheel byte, so sieve a
+        // little past the request to keep the emitted coverage >= limit.
+        limit += 60;
+    }
+    if (limit < 3) {
+        // The sieve stream starts at 3, so there is nothing to emit - and
+        // (limit - 3) in the segment count would wrap in the parallel and
+        // --extend paths.
+        return 0;
+    }
+    int num_threads = 1;
+    if (argc == 3) {
+        num_threads = atoi(argv[2]);
+        if (num_threads < 1) {
+            fprintf(stderr, "Threads must be >= 1\n");
+            return 1;
+        }
+    }
     uint64_t sqrt_limit = (uint64_t)sqrt((double)limit) + 1;
     uint8_t *base_primes = calloc((sqrt_limit + 1) >> 1, sizeof(uint8_t));
     if (!base_primes) {
@@ -47,62 +305,119 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    // Sieve small primes up to sqrt(limit)
-    for (uint64_t i = 0; (2*i+3)*(2*i+3) <= sqrt_limit; ++i) {
-        if (!(base_primes[i >> 3] & (1 << (i & 7)))) {
-            uint64_t p = (i << 1) + 3;
-            uint64_t jmax = (sqrt_limit - 1) >> 1;
-            for (uint64_t j = (p * p - 3) >> 1; j < jmax; j += p) {
-                base_primes[j >> 3] |= (1 << (j & 7));  // <<< FIXED
+    FILE *out = stdout;
+    uint64_t first_segment = 0;
+
+    if (extend_file) {
+        // Re-derive base primes from the existing bitmap and resume at the
+        // first segment past its end.  Segments are written whole, so the
+        // file length must be a multiple of the segment byte size.
+        out = fopen(extend_file, "rb+");
+        if (!out) {
+            perror("fopen");
+            free(base_primes);
+            return 1;
+        }
+        if (fseek(out, 0, SEEK_END) != 0) {
+            perror("fseek");
+            fclose(out);
+            free(base_primes);
+            return 1;
+        }
+        const uint64_t old_bytes = (uint64_t)ftell(out);
+        const uint64_t seg_bytes = (SEGMENT_SIZE + 7) / 8;
+        if (old_bytes == 0 || old_bytes % seg_bytes != 0) {
+            fprintf(stderr, "Error: %s is not a whole number of %u-bit segments\n",
+                    extend_file, (unsigned)SEGMENT_SIZE);
+            fclose(out);
+            free(base_primes);
+            return 1;
+        }
+        const uint64_t need_bytes = (((sqrt_limit + 1) >> 1) + 7) / 8;
+        if (old_bytes < need_bytes) {
+            fprintf(stderr, "Error: %s covers less than sqrt(%llu); cannot derive base primes\n",
+                    extend_file, (unsigned long long)limit);
+            fclose(out);
+            free(base_primes);
+            return 1;
+        }
+        rewind(out);
+        if (fread(base_primes, 1, need_bytes, out) != need_bytes) {
+            perror("fread");
+            fclose(out);
+            free(base_primes);
+            return 1;
+        }
+        // File bits are inverted (1 = prime); the sieve expects 0 = prime.
+        for (uint64_t i = 0; i < need_bytes; ++i) {
+            base_primes[i] = (uint8_t)~base_primes[i];
+        }
+        if (fseek(out, 0, SEEK_END) != 0) {
+            perror("fseek");
+            fclose(out);
+            free(base_primes);
+            return 1;
+        }
+        first_segment = old_bytes / seg_bytes;
+        const uint64_t total_segments = (limit - 3) / (2 * (uint64_t)SEGMENT_SIZE) + 1;
+        if (first_segment >= total_segments) {
+            fprintf(stderr, "%s already covers %llu; nothing to extend\n",
+                    extend_file, (unsigned long long)limit);
+            fclose(out);
+            free(base_primes);
+            return 0;
+        }
+    }
+    else {
+        // Sieve small primes up to sqrt(limit)
+        for (uint64_t i = 0; (2*i+3)*(2*i+3) <= sqrt_limit; ++i) {
+            if (!(base_primes[i >> 3] & (1 << (i & 7)))) {
+                uint64_t p = (i << 1) + 3;
+                uint64_t jmax = (sqrt_limit - 1) >> 1;
+                for (uint64_t j = (p * p - 3) >> 1; j < jmax; j += p) {
+                    base_primes[j >> 3] |= (1 << (j & 7));  // <<< FIXED
+                }
             }
         }
     }
 
-    uint8_t *flags = calloc((SEGMENT_SIZE + 7) / 8, sizeof(uint8_t));
-    if (!flags) {
-        fprintf(stderr, "Failed to allocate flags\n");
-        free(base_primes);
-        return 1;
+    int rc = 0;
+    if (wheel30) {
+        fwrite(GB_WHEEL30_MAGIC, 1, GB_WHEEL30_HDR_BYTES, out);
     }
-
-    FILE *out = stdout;
-
-    for (uint64_t low = 3; low <= limit; low += 2 * SEGMENT_SIZE) {
-        uint64_t high = low + 2 * SEGMENT_SIZE - 1;
-        uint64_t segment_len = (high - low) / 2 + 1;
-
-        memset(flags, 0, (segment_len + 7)/8);
-
-        for (uint64_t i = 0; (2*i+3)*(2*i+3) <= high; ++i) {
-            if (!(base_primes[i >> 3] & (1 << (i & 7)))) {
-                uint64_t p = (i<<1) + 3;
-		if(p&0xffffffff00000000ULL) {
-		    break;
-		}
-                uint64_t j = p * p;
-
-                if (j < low) {
-                    j = ((low + p - 1) / p) * p;
-                    if ((j & 1) == 0) j += p;
+    if (num_threads > 1) {
+        rc = sieve_parallel(limit, first_segment, base_primes, num_threads, wheel30, out);
+    }
+    else {
+        uint8_t *flags = calloc((SEGMENT_SIZE + 7) / 8, sizeof(uint8_t));
+        if (!flags) {
+            fprintf(stderr, "Failed to allocate flags\n");
+            rc = 1;
+        }
+        else {
+            Wheel30Writer ww = {out, 0, 0};
+            uint64_t last_low = 0;
+            for (uint64_t low = 3 + first_segment * (2 * (uint64_t)SEGMENT_SIZE);
+                 low <= limit; low += 2 * SEGMENT_SIZE) {
+                sieve_segment(low, base_primes, flags);
+                if (wheel30) {
+                    wheel30_feed(&ww, low, flags, SEGMENT_SIZE);
                 }
-
-                for (uint64_t jstep=(p<<1); j <= high; j += jstep) {
-                    uint64_t idx = (j - low) >> 1;
-                    flags[idx >> 3] |= (1 << (idx & 7));
+                else {
+                    write_bitmap(flags, SEGMENT_SIZE, out);
                 }
+                last_low = low;
             }
+            if (wheel30) {
+                wheel30_finish(&ww, last_low + 2 * ((uint64_t)SEGMENT_SIZE - 1));
+            }
+            free(flags);
         }
-
-        // Invert: 1 = prime
-        for (size_t i = 0; i < (segment_len + 7)/8; ++i) {
-            flags[i] = ~flags[i];
-	}
-
-        write_bitmap(flags, segment_len, out);
     }
 
-    free(flags);
+    if (extend_file) {
+        fclose(out);
+    }
     free(base_primes);
-    return 0;
+    return rc;
 }
-
@@ -64,11 +64,18 @@ int main(int argc, char* argv[]) {
         exit(1);
     }
 
+    // Buffered bulk emission: format each prime with the fast integer
+    // formatter and flush about once per megabyte instead of one locked
+    // printf per line.
+    char line[24];
     for (uint64_t N = (start_N < 3)?3:start_N; N <= end_N;N++) {
         if((N&1)&&is_odd_prime_fast(N,prime_bitmap)) {
-            printf("%" PRIu64 "\n",N);
+            int len = gbFmtU64(line, N);
+            line[len++] = '\n';
+            gbOutWrite(stdout, line, (size_t)len);
         }
     }
+    gbOutFlushAll();
 
     munmap(prime_bitmap, st.st_size);
     close(fd);
@@ -30,8 +30,12 @@
 #include "libprime.h"
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        fprintf(stderr,"Usage: %s <prime_bitmap_file> <prime_bitmap_file>\n",argv[0]);
+    int use_gaps = 0;
+    if (argc == 4 && !strcmp(argv[3],"--gaps")) {
+        use_gaps = 1;
+    }
+    else if (argc != 3) {
+        fprintf(stderr,"Usage: %s <prime_bitmap_file> <output_file> [--gaps]\n",argv[0]);
         exit(1);
     }
 
@@ -51,13 +55,20 @@ int main(int argc, char* argv[]) {
         close(fd);
         exit(1);
     }
-    const uint64_t end_N = (((uint64_t)st.st_size)<<4)+3;
-
     uint8_t* prime_bitmap = (uint8_t*)(
         mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
     );
 
-    // Construct zstd command
+    // Both bitmap formats are accepted: wheel-30 (GBWHEEL0 header, one byte
+    // per 30 integers) and the odd-only layout (bit k -> 3+2k).
+    const int wheel30 = isWheel30Bitmap(prime_bitmap, (size_t)st.st_size);
+    const uint64_t wheel_bytes = wheel30
+        ? (uint64_t)st.st_size - GB_WHEEL30_HDR_BYTES : 0;
+    const uint8_t *wheel_payload = wheel30
+        ? prime_bitmap + GB_WHEEL30_HDR_BYTES : NULL;
+    const uint64_t end_N = wheel30
+        ? 30ULL * wheel_bytes : (((uint64_t)st.st_size)<<4)+3;
+
     FILE* out = fopen(output_file,"w+");
     if (!out) {
         perror("fopen");
@@ -65,18 +76,44 @@ int main(int argc, char* argv[]) {
         close(fd);
         exit(1);
     }
+    PrimeGapWriter gaps;
+    if (use_gaps && primeGapWriterInit(&gaps,out) != 0) {
+        perror("primeGapWriterInit");
+        fclose(out);
+        munmap(prime_bitmap, st.st_size);
+        close(fd);
+        exit(1);
+    }
     uint64_t N = 2;
-    fwrite(&N,sizeof(uint64_t),1,out);
-    
+    if (use_gaps) {
+        primeGapWriterPut(&gaps,N);
+    }
+    else {
+        fwrite(&N,sizeof(uint64_t),1,out);
+    }
+
     while(++N < end_N) {
-        if((N&1)&&is_odd_prime_fast(N,prime_bitmap)) {
-            fwrite(&N,sizeof(uint64_t),1,out);
+        if(wheel30 ? is_prime_wheel30(N,wheel_payload,wheel_bytes)
+                   : ((N&1)&&is_odd_prime_fast(N,prime_bitmap))) {
+            if (use_gaps) {
+                primeGapWriterPut(&gaps,N);
+            }
+            else {
+                fwrite(&N,sizeof(uint64_t),1,out);
+            }
         }
 	if(!(N&0xfffff)) {
 	    printf("Output %" PRIu64 " out of %" PRIu64 "\n",N,end_N);
         }
     }
 
+    if (use_gaps && primeGapWriterFinish(&gaps) != 0) {
+        perror("primeGapWriterFinish");
+        fclose(out);
+        munmap(prime_bitmap, st.st_size);
+        close(fd);
+        exit(1);
+    }
     fclose(out);
     munmap(prime_bitmap, st.st_size);
     close(fd);
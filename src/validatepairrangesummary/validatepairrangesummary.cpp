@@ -22,6 +22,11 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+extern "C" {
+#include "libprime.h"
+}
+#include "gbCsv.hpp"
+
 using u64 = uint64_t;
 
 /*** tiny utils ***/
@@ -34,9 +39,6 @@ static bool is_tainted(){
     std::cerr << "ERROR: " << s << "\n"; std::exit(1);
 }
 
-static void warn(const std::string& s){
-    std::cerr << "WARNING: " << s << "\n";
-}
 static inline void rstrip_cr(std::string& s){ if(!s.empty() && s.back()=='\r') s.pop_back(); }
 
 /*** exact 6-decimal helpers (to mirror %.6f output) ***/
@@ -77,6 +79,7 @@ struct Args {
     double tolerance = 0.10;   // 10% tolerance for hl-a validation
     double alpha = 0.5;        // alpha parameter for normalization
     bool include_trivial = false; // whether to include trivial pairs
+    int threads = 1;           // worker threads over line-aligned CSV chunks
 };
 static Args parse_args(int argc, char** argv){
     Args a;
@@ -129,7 +132,16 @@ static Args parse_args(int argc, char** argv){
         else if(s=="--include-trivial") {
             a.include_trivial = true;
         }
-        else die("Unknown arg: "+s+"  (use --file <csv> [--bitmap <bmp>] [--raw <bin>] [--compat <version>] [--model <type>] [--tolerance <val>] [--alpha <val>] [--include-trivial])");
+        else if(s=="--threads") {
+            std::string thr_str = need(i+1<argc);
+            char* endp = nullptr;
+            long thr = std::strtol(thr_str.c_str(), &endp, 10);
+            if(!endp || *endp != '\0' || thr < 1) {
+                die("Threads must be an integer >= 1");
+            }
+            a.threads = (int)thr;
+        }
+        else die("Unknown arg: "+s+"  (use --file <csv> [--bitmap <bmp>] [--raw <bin>] [--compat <version>] [--model <type>] [--tolerance <val>] [--alpha <val>] [--include-trivial] [--threads <n>])");
     }
     if(a.csv_path.empty()) die("Provide --file <pairrangesummary.csv>");
     if(!a.bitmap_path.empty() ^ !a.raw_path.empty())
@@ -163,19 +175,30 @@ struct Mmap {
     ~Mmap(){ close_unmap(); }
 };
 
-/*** odd-only bitmap oracle: bit k ↔ 3+2k, 1 = prime ***/
+/*** bitmap oracle: odd-only (bit k ↔ 3+2k) or wheel-30 (GBWHEEL0 header,
+ *** bit j of payload byte b ↔ 30b + gbWheel30Residues[j]), 1 = prime ***/
 struct PrimeBitmap {
     Mmap m; u64 max_n=1;
+    bool wheel30=false;
+    const uint8_t* payload=nullptr; u64 payload_bytes=0;
     void load(const std::string& path){
         m.open_ro(path);
+        if(isWheel30Bitmap(m.p, m.len)){
+            wheel30 = true;
+            payload = m.p + GB_WHEEL30_HDR_BYTES;
+            payload_bytes = (u64)m.len - GB_WHEEL30_HDR_BYTES;
+            max_n = (payload_bytes==0? 1ull : 30ull*payload_bytes - 1ull);
+            return;
+        }
         u64 bits = (u64)m.len * 8ull;
         max_n = (bits==0? 1ull : (3ull + 2ull*(bits-1ull)));
     }
     bool covers(u64 n) const { return n <= max_n; }
     bool isPrime(u64 n) const {
+        if(!covers(n)) die("bitmap does not cover n="+std::to_string(n));
+        if(wheel30) return is_prime_wheel30(n, payload, payload_bytes) != 0;
         if(n==2) return true;
         if(n<2 || (n&1ull)==0ull) return false;
-        if(!covers(n)) die("bitmap does not cover n="+std::to_string(n));
         u64 k = (n-3ull)>>1;
         size_t byte = (size_t)(k>>3);
         unsigned sh = (unsigned)(k & 7ull);
@@ -262,28 +285,17 @@ static u64 goldbach_pairs_count_2n_ranged(u64 n, u64 delta, const RawPrimes& rp,
     return c;  // Don't multiply by 2 - we're counting unordered pairs
 }
 
-/*** CSV helpers ***/
-static std::vector<std::string> split_csv_simple(const std::string& s){
-    std::vector<std::string> out;
-    std::string cur; cur.reserve(64);
-    for(size_t i=0;i<=s.size();++i){
-        char ch = (i==s.size()? ',' : s[i]);
-        if(ch==','){
-            size_t a=0,b=cur.size();
-            while(a<b && isspace((unsigned char)cur[a])) ++a;
-            while(b>a && isspace((unsigned char)cur[b-1])) --b;
-            out.emplace_back(cur.substr(a,b-a));
-            cur.clear();
-        }else cur.push_back(ch);
-    }
-    return out;
-}
+/*** CSV helpers (zero-copy splitting and conversion via gbCsv) ***/
+static constexpr size_t MAX_COLS = 32;
 
 struct ColIdx {
     // we only REQUIRE these:
     int n0=-1, cmin=-1, n1=-1, cmax=-1, cavg=-1;
     // rich raw extrema (optional; parsed but UNUSED in checks per your note)
     int min_at=-1, MINv=-1, max_at=-1, MAXv=-1;
+    // run-length encoded files (--rle-eps): each row stands for REPEAT
+    // consecutive aggregate rows sharing its representative values
+    int repeat=-1;
 };
 
 static int get_col_idx(std::unordered_map<std::string,int>& idx, const char * names[], size_t n) {
@@ -294,23 +306,14 @@ static int get_col_idx(std::unordered_map<std::string,int>& idx, const char * na
     return -1;
 };
 
-static ColIdx parse_header_and_get_indices(std::istream& in, size_t& header_ln, bool /*compat_v01x*/, bool& detected_v015){
-    std::string line; header_ln = 0;
-    while(std::getline(in,line)){
-        ++header_ln; rstrip_cr(line);
-        if(line.empty()) continue;
-        if(line.size()>=3 &&
-           (unsigned char)line[0]==0xEF && (unsigned char)line[1]==0xBB && (unsigned char)line[2]==0xBF)
-            line.erase(0,3);
-        break;
-    }
-    if(line.empty()) die("CSV appears empty (no header)");
-
-    auto H = split_csv_simple(line);
-    if(H.empty()) die("Empty header line");
+static ColIdx parse_header_cols(const std::string& line, bool& detected_v015){
+    GBCsvField H[MAX_COLS];
+    size_t nH = gbCsvSplit(line.data(), line.data()+line.size(), H, MAX_COLS);
+    if(nH > MAX_COLS) nH = MAX_COLS;
+    if(nH == 0 || (nH == 1 && H[0].empty())) die("Empty header line");
 
     std::unordered_map<std::string,int> idx;
-    for(int i=0;i<(int)H.size();++i) idx[H[i]] = i;
+    for(int i=0;i<(int)nH;++i) idx[H[i].str()] = i;
 
 
     ColIdx ci;
@@ -337,66 +340,64 @@ static ColIdx parse_header_and_get_indices(std::istream& in, size_t& header_ln,
     ci.cavg = get_col_idx(idx,cavg_names,sizeof(cavg_names)/sizeof(cavg_names[0]));
     ci.MINv = get_col_idx(idx,min_names,sizeof(min_names)/sizeof(min_names[0]));
     ci.MAXv = get_col_idx(idx,max_names,sizeof(max_names)/sizeof(max_names[0]));
+    const char * repeat_names[] = {"REPEAT"};
+    ci.repeat = get_col_idx(idx,repeat_names,sizeof(repeat_names)/sizeof(repeat_names[0]));
     return ci;
 }
 
-static bool parse_row_fields(const std::string& s, const ColIdx& ci,
+static bool parse_row_fields(const char* begin, const char* end, const ColIdx& ci,
                              u64& n0, long double& Cmin, u64& minAt,long double& MINv,
                              u64& n1, long double& Cmax, u64& maxAt,long double& MAXv,
-                             long double& Cavg)
+                             long double& Cavg, u64& repeat)
 {
-    auto V = split_csv_simple(s);
+    GBCsvField V[MAX_COLS];
+    size_t nV = gbCsvSplit(begin, end, V, MAX_COLS);
+    if(nV > MAX_COLS) nV = MAX_COLS;
     auto get_u64 = [&](int k, u64& out)->bool{
-        if(k<0 || k>=(int)V.size()) return false;
-        char* e=nullptr; unsigned long long u = strtoull(V[k].c_str(), &e, 10);
-        if(e!=V[k].c_str()+V[k].size()) return false;
-        out = (u64)u; return true;
+        if(k<0 || k>=(int)nV) return false;
+        return gbCsvU64(V[k], out);
     };
     auto get_ld = [&](int k, long double& out)->bool{
-        if(k<0 || k>=(int)V.size()) return false;
-        char* e=nullptr; long double d = strtold(V[k].c_str(), &e);
-        if(e!=V[k].c_str()+V[k].size()) return false;
-        out = d; return true;
+        if(k<0 || k>=(int)nV) return false;
+        return gbCsvLd(V[k], out);
     };
 
+    repeat = 1;
+    if(ci.repeat >= 0 && (!get_u64(ci.repeat, repeat) || repeat == 0))
+        return false;
     return get_u64(ci.n0, n0) && get_ld(ci.cmin, Cmin) &&
            get_u64(ci.n1, n1) &&   get_ld(ci.cmax, Cmax) && get_u64(ci.min_at, minAt) && get_ld(ci.MINv, MINv) && get_u64(ci.max_at, maxAt) && get_ld(ci.MAXv, MAXv) &&
            get_ld(ci.cavg, Cavg);
 }
 
-/*** main ***/
-int main(int argc, char** argv){
-    std::ios::sync_with_stdio(false);
-    Args a = parse_args(argc, argv);
-
-    bool do_endpoints = (!a.bitmap_path.empty());
-    PrimeBitmap pb; RawPrimes rp;
-    if(do_endpoints){
-        pb.load(a.bitmap_path);
-        rp.load(a.raw_path);
-    }
-
-    std::ifstream in(a.csv_path);
-    if(!in) die("Failed to open CSV: "+a.csv_path);
-
-    size_t header_ln=0;
-    bool detected_v015;
-    ColIdx ci = parse_header_and_get_indices(in, header_ln, a.compat_v01x, detected_v015);
-
-    std::string line; size_t ln = header_ln;
+/*** per-chunk validation ***/
+// Each worker accumulates its own stats and diagnostics; chunks are combined
+// in file order afterwards so output matches the sequential run.
+struct RowStats {
     size_t rows = 0, checked = 0;
+    std::vector<std::pair<size_t,std::string>> warnings; // (line, full stderr text)
+    size_t error_ln = 0;
+    std::string error;          // stderr context + ERROR text; empty = chunk passed
+};
 
-    while(std::getline(in, line)){
-        ++ln; rstrip_cr(line);
-        if(line.empty()) continue;
-
+// Validate one data row; returns false on a fatal mismatch (recorded in st).
+static bool validate_row(const char* begin, const char* end, size_t ln, const Args& a,
+                         const ColIdx& ci, bool detected_v015, bool do_endpoints,
+                         const RawPrimes& rp, const PrimeBitmap& pb, RowStats& st)
+{
         u64 n0=0, n1=0;
         long double Cmin=0, Cmax=0, Cavg=0;
         long double MINv=0, MAXv=0;
         u64 minAt=0, maxAt=0;
-        if(!parse_row_fields(line, ci, n0, Cmin, minAt, MINv,n1, Cmax, maxAt, MAXv, Cavg))
-            die("Bad CSV row at line "+std::to_string(ln)+": "+line);
-        ++rows;
+        u64 repeat=1;
+        if(!parse_row_fields(begin, end, ci, n0, Cmin, minAt, MINv,n1, Cmax, maxAt, MAXv, Cavg, repeat)){
+            st.error_ln = ln;
+            st.error = "ERROR: Bad CSV row at line "+std::to_string(ln)+": "+std::string(begin, end)+"\n";
+            return false;
+        }
+        // RLE expansion: the representative values are validated once and
+        // stand for `repeat` collapsed rows in the accounting.
+        st.rows += repeat;
 
         // Sanity: C_min <= C_avg <= C_max at 6dp
         // Skip this check for line 2 in v0.1.x mode due to known issue
@@ -404,9 +405,11 @@ int main(int argc, char** argv){
             if(to_micro6(Cavg) < to_micro6(std::min(Cmin, Cmax)) ||
                to_micro6(Cavg) > to_micro6(std::max(Cmin, Cmax))){
                 if(is_tainted()){
-                    warn("line "+std::to_string(ln)+": C_avg not within [C_min, C_max] at 6dp");
+                    st.warnings.emplace_back(ln, "WARNING: line "+std::to_string(ln)+": C_avg not within [C_min, C_max] at 6dp\n");
                 } else {
-                    die("line "+std::to_string(ln)+": C_avg not within [C_min, C_max] at 6dp");
+                    st.error_ln = ln;
+                    st.error = "ERROR: line "+std::to_string(ln)+": C_avg not within [C_min, C_max] at 6dp\n";
+                    return false;
                 }
             }
         }
@@ -509,42 +512,189 @@ int main(int argc, char** argv){
             }
             
             if(!cmin_valid){
-                fprintf(stderr,"GminAt=%" PRIu64 ", MINv=%Lf\n", GminAt, MINv);
                 std::ostringstream oss;
-                oss << "line " << ln << ": C_min mismatch (endpoint n_0). "
+                oss << "GminAt=" << GminAt << ", " << "MINv=" << fmt6(MINv) << "\n";
+                oss << (is_tainted() ? "WARNING: " : "ERROR: ")
+                    << "line " << ln << ": C_min mismatch (endpoint n_0). "
                     << "expected=" << fmt6(Cm0) << " file=" << fmt6(Cmin)
                     << "  (n_0=" << n0 << ")";
                 if(!a.is_empirical) {
                     oss << " [hl-a mode: file value should be >= expected]";
                 }
+                oss << "\n";
                 if(is_tainted()){
-                    warn(oss.str());
+                    st.warnings.emplace_back(ln, oss.str());
                 } else {
-                    die(oss.str());
+                    st.error_ln = ln;
+                    st.error = oss.str();
+                    return false;
                 }
             }
             if(!cmax_valid){
-                fprintf(stderr,"GmaxAt=%" PRIu64 ", MAXv=%Lf\n", GmaxAt, MAXv);
                 std::ostringstream oss;
-                oss << "line " << ln << ": C_max mismatch (endpoint n_1). "
+                oss << "GmaxAt=" << GmaxAt << ", " << "MAXv=" << fmt6(MAXv) << "\n";
+                oss << (is_tainted() ? "WARNING: " : "ERROR: ")
+                    << "line " << ln << ": C_max mismatch (endpoint n_1). "
                     << "expected=" << fmt6(Cm1) << " file=" << fmt6(Cmax)
                     << "  (n_1=" << n1 << ")";
                 if(!a.is_empirical) {
                     oss << " [hl-a mode: tolerance=" << (a.tolerance*100) << "%]";
                 }
+                oss << "\n";
                 if(is_tainted()){
-                    warn(oss.str());
+                    st.warnings.emplace_back(ln, oss.str());
                 } else {
-                    die(oss.str());
+                    st.error_ln = ln;
+                    st.error = oss.str();
+                    return false;
                 }
             }
-            ++checked;
+            st.checked += repeat;
+        }
+    return true;
+}
+
+// Validate the line-aligned byte range [begin, end); first_ln is the file
+// line number of the first line in the range.
+static void validate_chunk(const char* begin, const char* end, size_t first_ln,
+                           const Args& a, const ColIdx& ci, bool detected_v015,
+                           bool do_endpoints, const RawPrimes& rp,
+                           const PrimeBitmap& pb, RowStats& st)
+{
+    size_t ln = first_ln - 1;
+    const char* p = begin;
+    while(p < end){
+        const char* ls = p;
+        const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+        const char* eol = nl ? nl : end;
+        p = nl ? nl + 1 : end;
+        ++ln;
+        if(eol > ls && eol[-1]=='\r') --eol;
+        if(eol == ls) continue;
+        if(!validate_row(ls, eol, ln, a, ci, detected_v015, do_endpoints, rp, pb, st))
+            return;
+    }
+}
+
+/*** main ***/
+int main(int argc, char** argv){
+    std::ios::sync_with_stdio(false);
+    Args a = parse_args(argc, argv);
+
+    bool do_endpoints = (!a.bitmap_path.empty());
+    PrimeBitmap pb; RawPrimes rp;
+    if(do_endpoints){
+        pb.load(a.bitmap_path);
+        rp.load(a.raw_path);
+    }
+
+    Mmap csv;
+    csv.open_ro(a.csv_path);
+    const char* base = (const char*)csv.p;
+    const char* csv_end = base + csv.len;
+
+    // Columnar (--columnar) files are transparently expanded back into the
+    // CSV text the equivalent stream would have written, so the line-based
+    // validation below runs unchanged.
+    std::string columnar_text;
+    if(isGBColumnarData((const uint8_t*)csv.p, csv.len)){
+        GBColumnarReader reader;
+        if(gbColumnarReaderInit(&reader, (const uint8_t*)csv.p, csv.len) != 0)
+            die("invalid columnar file: "+a.csv_path);
+        columnar_text.reserve((size_t)reader.nrows * 64 + reader.header_len);
+        columnar_text.append(reader.header, reader.header_len);
+        char line[4096];
+        for(u64 row = 0; row < reader.nrows; ++row){
+            int len = gbColumnarFormatRow(&reader, row, line, sizeof(line));
+            if(len < 0) die("failed to format columnar row "+std::to_string(row));
+            columnar_text.append(line, (size_t)len);
+        }
+        base = columnar_text.data();
+        csv_end = base + columnar_text.size();
+    }
+
+    // Header scan (skip leading empty lines, strip BOM, as before)
+    size_t header_ln = 0;
+    std::string header;
+    const char* data_begin = base;
+    while(data_begin < csv_end){
+        const char* nl = (const char*)memchr(data_begin, '\n', (size_t)(csv_end - data_begin));
+        const char* eol = nl ? nl : csv_end;
+        std::string line(data_begin, (size_t)(eol - data_begin));
+        data_begin = nl ? nl + 1 : csv_end;
+        ++header_ln; rstrip_cr(line);
+        if(line.empty()) continue;
+        if(line.size()>=3 &&
+           (unsigned char)line[0]==0xEF && (unsigned char)line[1]==0xBB && (unsigned char)line[2]==0xBF)
+            line.erase(0,3);
+        header = line;
+        break;
+    }
+    if(header.empty()) die("CSV appears empty (no header)");
+
+    bool detected_v015;
+    ColIdx ci = parse_header_cols(header, detected_v015);
+
+    // Split the data into line-aligned chunks, one per worker.
+    size_t nthreads = (size_t)a.threads;
+    size_t data_len = (size_t)(csv_end - data_begin);
+    if(nthreads > 1 && data_len / nthreads < 64) nthreads = 1; // tiny file
+    std::vector<std::pair<const char*,const char*>> chunks;
+    {
+        const char* p = data_begin;
+        for(size_t t = 0; t < nthreads && p < csv_end; ++t){
+            const char* q = (t + 1 == nthreads) ? csv_end
+                          : data_begin + data_len * (t + 1) / nthreads;
+            if(q < csv_end){
+                const char* nl = (const char*)memchr(q, '\n', (size_t)(csv_end - q));
+                q = nl ? nl + 1 : csv_end;
+            }
+            if(q > p) chunks.emplace_back(p, q);
+            p = q;
+        }
+    }
+
+    // First line number of each chunk from per-chunk newline counts.
+    std::vector<size_t> first_ln(chunks.size(), header_ln + 1);
+    for(size_t c = 1; c < chunks.size(); ++c){
+        first_ln[c] = first_ln[c-1] +
+            (size_t)std::count(chunks[c-1].first, chunks[c-1].second, '\n');
+    }
+
+    std::vector<RowStats> stats(chunks.size());
+    if(chunks.size() > 1){
+        std::vector<std::thread> workers;
+        for(size_t c = 0; c < chunks.size(); ++c){
+            workers.emplace_back([&, c]{
+                validate_chunk(chunks[c].first, chunks[c].second, first_ln[c],
+                               a, ci, detected_v015, do_endpoints, rp, pb, stats[c]);
+            });
+        }
+        for(auto& w : workers) w.join();
+    } else if(chunks.size() == 1){
+        validate_chunk(chunks[0].first, chunks[0].second, first_ln[0],
+                       a, ci, detected_v015, do_endpoints, rp, pb, stats[0]);
+    }
+
+    // Combine chunks in file order: stop at the earliest fatal line and only
+    // emit diagnostics that the sequential run would have reached.
+    size_t rows = 0, checked = 0;
+    for(const auto& st : stats){
+        for(const auto& [wln, text] : st.warnings){
+            if(!st.error.empty() && wln > st.error_ln) break;
+            std::fputs(text.c_str(), stderr);
+        }
+        if(!st.error.empty()){
+            std::fputs(st.error.c_str(), stderr);
+            std::exit(1);
         }
+        rows += st.rows;
+        checked += st.checked;
     }
 
     if(rows==0) die("No data rows");
 
-    std::cout << "OK: validated pairrangesummary file (" 
+    std::cout << "OK: validated pairrangesummary file ("
               << a.version_string << " format, "
               << (a.is_empirical ? "empirical" : "hl-a") << " model)\n"
               << "rows=" << rows